@@ -4,11 +4,30 @@
  * Ce programme calcule la suite de collatz d'un premier terme donne par
  * l'utilsateur et affiche certains parametres tels que le terme maximum de la
  * suite ou le nombre de terme avant sa convergence. Le programme calcule des
- * suites de Collatz jusqu'a un arret de l'utilisateur.
+ * suites de Collatz jusqu'a un arret de l'utilisateur. Compile avec
+ * -DCOMPTER_OPERATIONS ou -DCOMPTEURS_MATERIELS, il affiche aussi les
+ * operations et les compteurs du processeur de chaque suite (voir compteurs.h).
+ * Avec l'argument --banc, le programme mesure plutot le calcul des suites avec
+ * le banc d'essai de banc.h (voir ce fichier pour les options).
  */
 
 #include <stdio.h>
 
+#include "../banc.h"
+#include "../compteurs.h"
+
+// Les suites mesurees par le banc d'essai commencent par 1 a PREMIER_TERME_BANC
+#define PREMIER_TERME_BANC 1000
+
+/**
+ * Cette fonction calcule le terme qui suit un terme d'une suite de Collatz.
+ *
+ * terme: terme courant de la suite
+ *
+ * return: terme suivant de la suite
+ */
+int Collatz_suivant(int terme) { return terme % 2 ? 3 * terme + 1 : terme / 2; }
+
 /**
  * Cette fonction trouve la suite de collatz selon un premier terme donne et
  * tiens compte du maximum et du nombre de termes avant la convergence de
@@ -30,9 +49,18 @@ void suite_de_Collatz(int premierTerme) {
         // On ecrit le dernier terme de la suite
         printf("%d, ", terme);
 
+        // 3 comparaisons pour !=, le test de parite et >, 3 affectations pour
+        // terme =, max = et nTermes++, puis 1 multiplication (3 * terme ou
+        // / 2) et les additions de 3 * terme + 1 (si terme est impair) et de
+        // nTermes++
+        COMPTER(COMPARAISONS, 3);
+        COMPTER(AFFECTATIONS, 3);
+        COMPTER(MULTIPLICATIONS, 1);
+        COMPTER(ADDITIONS, terme % 2 ? 2 : 1);
+
         // On ajuste les valeurs du terme, du max et du nombre de terme avant
         // la convergence
-        terme = terme % 2 ? 3 * terme + 1 : terme / 2;
+        terme = Collatz_suivant(terme);
         max = terme > max ? terme : max;
         nTermes++;
     }
@@ -44,7 +72,28 @@ void suite_de_Collatz(int premierTerme) {
     printf("Terme maximum de la suite: %d\n", max);
 }
 
-int main() {
+/**
+ * Noyau du banc d'essai: calcule sans les afficher les suites de Collatz dont
+ * le premier terme va de 1 a PREMIER_TERME_BANC.
+ *
+ * donnees: pointeur vers un int ou on ecrit le nombre total de termes
+ */
+void banc_Collatz(void* donnees) {
+    int nTermes = 0;
+    for (int premierTerme = 1; premierTerme <= PREMIER_TERME_BANC;
+         premierTerme++)
+        for (int terme = premierTerme; terme != 1; nTermes++)
+            terme = Collatz_suivant(terme);
+    *(int*)donnees = nTermes;
+}
+
+int main(int argc, char* argv[]) {
+    // On enregistre le noyau du banc d'essai et on le lance si demande
+    static int nTermesBanc;
+    banc_enregistrer("suites de Collatz (a = 1 a 1000)", banc_Collatz,
+                     &nTermesBanc);
+    if (banc_lancer(argc, argv)) return 0;
+
     // On declare nos variables contenant les reponses de l'utilisateur
     int a;
     char rep;
@@ -58,7 +107,9 @@ int main() {
 
         // On calcule la suite de Collatz et on montre divers analyses de
         // celle-ci
+        MESURE_DEBUTER(mesure);
         suite_de_Collatz(a);
+        MESURE_TERMINER(mesure, "suite de Collatz");
 
         // On verifie si on execute encore une iteration
         printf("Voulez-vous continuer?\n");
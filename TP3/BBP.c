@@ -0,0 +1,228 @@
+/**
+ * Auteur : Nicolas Levasseur
+ *
+ * Ce programme trouve les chiffres hexadecimaux de pi a partir de positions
+ * quelconques avec la formule de Bailey-Borwein-Plouffe, sans calculer les
+ * chiffres qui precedent. Il complete la comparaison des formules de TP3A: on
+ * peut s'en servir pour verifier quelques chiffres d'un long calcul de pi ou
+ * pour repartir des plages de chiffres entre les coeurs, avec une memoire
+ * constante. Les positions sont donnees en arguments (sinon on utilise une
+ * liste par defaut) et sont reparties entre plusieurs fils d'execution.
+ *
+ * Compilation : gcc BBP.c -o BBP -lm -pthread
+ */
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* Nombre de chiffres hexadecimaux fiables par position (un double garde
+ * environ 13 chiffres hexadecimaux, on en perd quelques-uns dans les sommes) */
+#define N_CHIFFRES 8
+/* Nombre de termes de la queue de la somme (k > n), suffisant pour que les
+ * termes oublies soient plus petits que la precision d'un double */
+#define N_TERMES_QUEUE 16
+/* Position maximale, pour que les produits modulo 8n + 6 tiennent sur 64
+ * bits */
+#define POSITION_MAX (1ul << 28)
+/* Nombre maximal de fils d'execution */
+#define N_FILS_MAX 64
+
+/**
+ * Cette fonction calcule 16^exposant modulo un certain module par
+ * exponentiation rapide.
+ *
+ * exposant : Exposant de 16
+ * module : Module, plus petit que 2^32
+ *
+ * return : 16^exposant mod module
+ */
+unsigned long puissance_modulaire(unsigned long exposant,
+                                  const unsigned long module) {
+    /* Resultat et puissance de 16 courante */
+    unsigned long resultat = 1 % module, base = 16 % module;
+
+    for (; exposant; exposant >>= 1) {
+        if (exposant & 1) resultat = resultat * base % module;
+        base = base * base % module;
+    }
+
+    return resultat;
+}
+
+/**
+ * Cette fonction trouve la partie fractionnaire de la somme
+ * 16^n * Somme(1 / (16^k * (8k + j))), avec k allant de 0 a l'infini. Les
+ * termes avec k <= n sont calcules avec l'exponentiation modulaire, ce qui
+ * garde les nombres petits, et on ajoute ensuite quelques termes de la queue.
+ *
+ * n : Position du premier chiffre recherche
+ * j : Decalage du denominateur (1, 4, 5 ou 6 dans la formule BBP)
+ *
+ * return : Partie fractionnaire de la somme
+ */
+double somme_BBP(const unsigned long n, const unsigned long j) {
+    /* Somme a calculer, gardee entre 0 et 1 */
+    double somme = 0;
+
+    /* Termes ou 16^(n - k) est entier: on garde le reste modulo 8k + j */
+    for (unsigned long k = 0; k <= n; k++) {
+        const unsigned long denominateur = 8 * k + j;
+        somme += (double)puissance_modulaire(n - k, denominateur) /
+                 denominateur;
+        somme -= floor(somme);
+    }
+
+    /* Queue de la somme, ou 16^(n - k) est une fraction */
+    double puissance = 1.0 / 16;
+    for (unsigned long k = n + 1; k <= n + N_TERMES_QUEUE; k++) {
+        somme += puissance / (8 * k + j);
+        puissance /= 16;
+    }
+
+    return somme - floor(somme);
+}
+
+/**
+ * Cette fonction trouve les chiffres hexadecimaux de pi qui suivent les n
+ * premiers chiffres apres la virgule.
+ *
+ * n : Nombre de chiffres apres la virgule a sauter
+ * chiffres : Chaine de N_CHIFFRES + 1 caracteres ou on ecrit les chiffres
+ */
+void chiffres_pi(const unsigned long n, char chiffres[]) {
+    /* Partie fractionnaire de 16^n * pi selon la formule BBP */
+    double x = 4 * somme_BBP(n, 1) - 2 * somme_BBP(n, 4) - somme_BBP(n, 5) -
+               somme_BBP(n, 6);
+    x -= floor(x);
+
+    for (int i = 0; i < N_CHIFFRES; i++) {
+        x *= 16;
+        const int chiffre = (int)x;
+        chiffres[i] = "0123456789ABCDEF"[chiffre];
+        x -= chiffre;
+    }
+    chiffres[N_CHIFFRES] = '\0';
+}
+
+/**
+ * Travail d'un fil d'execution: il traite les positions iDebut,
+ * iDebut + pas, iDebut + 2 * pas, ... Comme le cout d'une position est
+ * proportionnel a la position, cette repartition entrelacee equilibre mieux
+ * la charge que des blocs contigus.
+ */
+struct travail {
+    const unsigned long* positions;
+    char (*chiffres)[N_CHIFFRES + 1];
+    int nPositions, iDebut, pas;
+};
+
+/**
+ * Cette fonction est executee par chaque fil d'execution.
+ *
+ * argument : Pointeur vers la struct travail du fil
+ *
+ * return : NULL
+ */
+void* executer_travail(void* argument) {
+    const struct travail* travail = argument;
+
+    for (int i = travail->iDebut; i < travail->nPositions; i += travail->pas)
+        chiffres_pi(travail->positions[i], travail->chiffres[i]);
+
+    return NULL;
+}
+
+/**
+ * Cette fonction trouve les chiffres de pi a plusieurs positions en
+ * repartissant les positions entre plusieurs fils d'execution.
+ *
+ * positions : Positions a calculer
+ * nPositions : Nombre de positions
+ * chiffres : Tableau ou on ecrit les chiffres de chaque position
+ * nFils : Nombre de fils d'execution a utiliser
+ */
+void chiffres_pi_parallele(const unsigned long positions[],
+                           const int nPositions,
+                           char chiffres[][N_CHIFFRES + 1], int nFils) {
+    pthread_t fils[N_FILS_MAX];
+    struct travail travaux[N_FILS_MAX];
+    /* Indique si le travail i tourne dans un fil qu'il faudra attendre */
+    int lance[N_FILS_MAX];
+
+    if (nFils > N_FILS_MAX) nFils = N_FILS_MAX;
+    if (nFils > nPositions) nFils = nPositions;
+
+    for (int i = 0; i < nFils; i++) {
+        travaux[i].positions = positions;
+        travaux[i].chiffres = chiffres;
+        travaux[i].nPositions = nPositions;
+        travaux[i].iDebut = i;
+        travaux[i].pas = nFils;
+        /* Si le fil ne peut pas etre cree, on fait son travail ici */
+        lance[i] = !pthread_create(&fils[i], NULL, executer_travail,
+                                   &travaux[i]);
+        if (!lance[i]) executer_travail(&travaux[i]);
+    }
+
+    for (int i = 0; i < nFils; i++)
+        if (lance[i]) pthread_join(fils[i], NULL);
+}
+
+int main(int argc, char* argv[]) {
+    /* Positions par defaut, dont celles publiees par Bailey pour verifier */
+    const unsigned long positionsDefaut[] = {0,    1,     10,     100,
+                                             1000, 10000, 100000, 1000000};
+    /* Nombre de positions a calculer */
+    const int nPositions =
+        argc > 1 ? argc - 1
+                 : (int)(sizeof positionsDefaut / sizeof positionsDefaut[0]);
+
+    unsigned long* positions = malloc(nPositions * sizeof *positions);
+    char(*chiffres)[N_CHIFFRES + 1] = malloc(nPositions * sizeof *chiffres);
+    if (!positions || !chiffres) {
+        printf("Memoire insuffisante\n");
+        return 1;
+    }
+
+    for (int i = 0; i < nPositions; i++) {
+        if (argc == 1) {
+            positions[i] = positionsDefaut[i];
+            continue;
+        }
+        /* Fin du nombre lu, qui doit etre la fin de l'argument */
+        char* fin;
+        const long position = strtol(argv[i + 1], &fin, 10);
+        if (fin == argv[i + 1] || *fin || position < 0 ||
+            (unsigned long)position > POSITION_MAX) {
+            printf("%s n'est pas une position entre 0 et %lu\n", argv[i + 1],
+                   POSITION_MAX);
+            return 1;
+        }
+        positions[i] = position;
+    }
+
+    chiffres_pi_parallele(positions, nPositions, chiffres,
+                          (int)sysconf(_SC_NPROCESSORS_ONLN));
+
+    printf("Chiffres hexadecimaux de pi\n");
+    for (int i = 0; i < nPositions; i++)
+        printf("Position %9lu : %s\n", positions[i], chiffres[i]);
+
+    free(positions);
+    free(chiffres);
+    return 0;
+}
+
+/*
+Chiffres hexadecimaux de pi
+Position         0 : 243F6A88
+Position         1 : 43F6A888
+Position        10 : A308D313
+Position       100 : 29B7C97C
+Position      1000 : 49F1C09B
+Position     10000 : 8AC8FCFB
+Position    100000 : 35EA16C4
+Position   1000000 : 6C65E52C
+*/
@@ -7,10 +7,21 @@
  * comprendre visuellement la vitesse de convergence de chaque formule. Le
  * programme a ete elabore afin de favoriser la modularite du code, par exemple
  * il est tres facile d'ajouter une nouvelle fonction convergent vers une
- * constante connue (qui peut etre pi ou une autre).
+ * constante connue (qui peut etre pi ou une autre). Avec l'argument
+ * --benchmark, le programme mesure plutot le temps que chaque formule prend
+ * pour atteindre chaque decade d'erreur et l'ecrit dans convergence.csv et
+ * convergence.json. Avec l'argument --banc, il mesure plutot chaque formule
+ * avec un nombre de termes fixe grace au banc d'essai de banc.h (voir ce
+ * fichier pour les options). Compile avec -DCOMPTER_OPERATIONS ou
+ * -DCOMPTEURS_MATERIELS, il affiche aussi les operations et les compteurs du
+ * processeur de chaque table de convergence (voir compteurs.h).
  */
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "../banc.h"
+#include "../compteurs.h"
 
 /* Constante mathematique pi */
 #define PI 3.14159265358979
@@ -18,29 +29,306 @@
 #define EPSILON1 1e-7
 /* Precision sur la formule de Vieta */
 #define EPSILON2 1e-14
+/* Constante mathematique e */
+#define E 2.71828182845905
+/* Valeur de tan(1) */
+#define TAN1 1.55740772465490
+/* Nombre de termes au-dela duquel on abandonne la recherche du nombre minimal
+ * de termes */
+#define NTERMES_MAX (1u << 30)
+/* Nombre maximal de convergents gardes par Afficher_tolerance */
+#define N_CONVERGENTS_MAX 1000
+/* Nombre minuscule qui remplace les zeros dans l'algorithme de Lentz */
+#define LENTZ_MINUSCULE 1e-300
+/* Partie haute et partie basse de pi en double-double (environ 106 bits) */
+#define PI_HAUT 3.141592653589793116
+#define PI_BAS 1.224646799147353207e-16
+/* Temps minimal (en secondes) pendant lequel on repete une formule pour
+ * mesurer son cout */
+#define TEMPS_MESURE 0.05
+/* Noms des fichiers ou on ecrit les resultats du mode --benchmark */
+#define NOM_FICHIER_CSV "convergence.csv"
+#define NOM_FICHIER_JSON "convergence.json"
+
+/**
+ * Etat d'une fraction continue generalisee de la forme
+ * b0 + a1 / (b1 + a2 / (b2 + a3 / (b3 + ...))), evaluee vers l'avant par
+ * l'algorithme de Lentz modifie. Contrairement a une evaluation a partir de la
+ * queue de la fraction, on obtient chaque convergent au passage et on peut
+ * reprendre le calcul la ou on l'avait laisse au lieu de tout recommencer. En
+ * revanche, l'arrondi de chaque rapport s'accumule dans le convergent, qui
+ * derive lentement de la valeur evaluee a partir de la queue.
+ */
+struct fraction_continue {
+    /* Numerateur partiel a_k (k >= 1) et denominateur partiel b_k (k >= 0),
+     * le deuxieme argument est le parametre x de la fraction */
+    double (*numerateur)(unsigned int, double);
+    double (*denominateur)(unsigned int, double);
+    /* Parametre de la fraction (ignore par les fractions constantes) */
+    double x;
+    /* Nombre de termes deja evalues */
+    unsigned int nTermes;
+    /* Convergent courant et les deux rapports de l'algorithme de Lentz */
+    double convergent, C, D;
+    /* Etat au debut du dernier avancement: on y revient quand on demande un
+     * convergent situe entre ce point et l'etat courant */
+    unsigned int nTermesReprise;
+    double convergentReprise, CReprise, DReprise;
+};
+
+/**
+ * Cette fonction prepare une fraction continue pour son evaluation, son
+ * convergent initial est b0.
+ *
+ * fraction : Fraction continue a initialiser
+ * numerateur : Generateur des numerateurs partiels a_k
+ * denominateur : Generateur des denominateurs partiels b_k
+ * x : Parametre passe aux generateurs
+ */
+void fraction_initialiser(struct fraction_continue* fraction,
+                          double (*numerateur)(unsigned int, double),
+                          double (*denominateur)(unsigned int, double),
+                          double x) {
+    fraction->numerateur = numerateur;
+    fraction->denominateur = denominateur;
+    fraction->x = x;
+    fraction->nTermes = 0;
+
+    /* Lentz remplace un b0 nul par un nombre minuscule pour pouvoir diviser */
+    fraction->convergent = denominateur(0, x);
+    if (fraction->convergent == 0) fraction->convergent = LENTZ_MINUSCULE;
+    fraction->C = fraction->convergent;
+    fraction->D = 0;
+
+    fraction->nTermesReprise = 0;
+    fraction->convergentReprise = fraction->convergent;
+    fraction->CReprise = fraction->C;
+    fraction->DReprise = 0;
+}
+
+/**
+ * Cette fonction ajoute un terme a une fraction continue selon l'algorithme de
+ * Lentz modifie.
+ *
+ * fraction : Fraction continue a faire avancer d'un terme
+ *
+ * return : Rapport entre le nouveau convergent et le precedent
+ */
+double fraction_terme_suivant(struct fraction_continue* fraction) {
+    /* 8 affectations pour k, a, b, les deux D =, C =, delta et convergent *=,
+     * 3 additions pour ++ et les deux b +, 5 multiplications pour a * D,
+     * a / C, 1 / D, C * D et convergent *=, 2 comparaisons pour les tests
+     * de zero */
+    COMPTER(AFFECTATIONS, 8);
+    COMPTER(ADDITIONS, 3);
+    COMPTER(MULTIPLICATIONS, 5);
+    COMPTER(COMPARAISONS, 2);
+
+    /* Numero du terme ajoute */
+    const unsigned int k = ++fraction->nTermes;
+    const double a = fraction->numerateur(k, fraction->x);
+    const double b = fraction->denominateur(k, fraction->x);
+
+    fraction->D = b + a * fraction->D;
+    if (fraction->D == 0) fraction->D = LENTZ_MINUSCULE;
+    fraction->C = b + a / fraction->C;
+    if (fraction->C == 0) fraction->C = LENTZ_MINUSCULE;
+    fraction->D = 1 / fraction->D;
+
+    /* Rapport entre deux convergents successifs */
+    const double delta = fraction->C * fraction->D;
+    fraction->convergent *= delta;
+    return delta;
+}
+
+/**
+ * Cette fonction evalue une fraction continue en une seule passe, en gardant
+ * chaque convergent, jusqu'a ce que deux convergents successifs soient egaux a
+ * une certaine tolerance relative pres.
+ *
+ * fraction : Fraction continue a evaluer (on continue a partir de son etat)
+ * nTermesMax : Nombre maximal de termes a ajouter
+ * tolerance : Ecart relatif entre deux convergents sous lequel on arrete, 0
+ * pour ajouter exactement nTermesMax termes
+ * convergents : Tableau de nTermesMax cases ou on ecrit chaque convergent
+ * calcule, peut etre NULL si on ne veut que le dernier
+ *
+ * return : Nombre de termes ajoutes a la fraction
+ */
+unsigned int fraction_evaluer(struct fraction_continue* fraction,
+                              unsigned int nTermesMax, double tolerance,
+                              double convergents[]) {
+    for (unsigned int i = 0; i < nTermesMax; i++) {
+        const double delta = fraction_terme_suivant(fraction);
+        if (convergents) convergents[i] = fraction->convergent;
+        if (fabs(delta - 1) < tolerance) return i + 1;
+    }
+
+    return nTermesMax;
+}
+
+/**
+ * Cette fonction fait avancer une fraction continue jusqu'a ce qu'elle
+ * contienne nTermes termes. Si la fraction contient deja plus de termes, on
+ * repart du point de reprise (l'etat au debut du dernier avancement) s'il est
+ * assez loin en arriere, et de b0 sinon. Une recherche par bisection qui
+ * alterne les essais au-dessus et au-dessous du seuil ne repart donc jamais de
+ * b0: le point de reprise reste sur la borne inferieure de l'encadrement, et
+ * le cout total est proportionnel au nombre de termes trouve.
+ *
+ * fraction : Fraction continue a evaluer
+ * nTermes : Nombre de termes voulus
+ *
+ * return : Le convergent a nTermes termes
+ */
+double fraction_avancer(struct fraction_continue* fraction,
+                        unsigned int nTermes) {
+    if (nTermes >= fraction->nTermes) {
+        /* L'etat courant devient le point de reprise */
+        fraction->nTermesReprise = fraction->nTermes;
+        fraction->convergentReprise = fraction->convergent;
+        fraction->CReprise = fraction->C;
+        fraction->DReprise = fraction->D;
+    } else if (nTermes >= fraction->nTermesReprise) {
+        fraction->nTermes = fraction->nTermesReprise;
+        fraction->convergent = fraction->convergentReprise;
+        fraction->C = fraction->CReprise;
+        fraction->D = fraction->DReprise;
+    } else
+        fraction_initialiser(fraction, fraction->numerateur,
+                             fraction->denominateur, fraction->x);
+
+    fraction_evaluer(fraction, nTermes - fraction->nTermes, 0, NULL);
+
+    return fraction->convergent;
+}
+
+/**
+ * Generateurs des termes partiels de la fraction de Brouncker,
+ * 4 / pi = 1 + 1^2 / (2 + 3^2 / (2 + 5^2 / (2 + ...))).
+ */
+double Brouncker_numerateur(unsigned int k, double x) {
+    (void)x;
+    return (2.0 * k - 1) * (2.0 * k - 1);
+}
+
+double Brouncker_denominateur(unsigned int k, double x) {
+    (void)x;
+    return k ? 2 : 1;
+}
+
+/**
+ * Generateurs des termes partiels de la fraction d'Euler pour e,
+ * e = 2 + 1 / (1 + 1 / (2 + 2 / (3 + 3 / (4 + ...)))).
+ */
+double Euler_numerateur(unsigned int k, double x) {
+    (void)x;
+    return k == 1 ? 1 : k - 1;
+}
+
+double Euler_denominateur(unsigned int k, double x) {
+    (void)x;
+    return k ? k : 2;
+}
+
+/**
+ * Generateurs des termes partiels de la fraction de Lambert pour la tangente,
+ * tan(x) = x / (1 - x^2 / (3 - x^2 / (5 - ...))).
+ */
+double Lambert_numerateur(unsigned int k, double x) {
+    return k == 1 ? x : -x * x;
+}
+
+double Lambert_denominateur(unsigned int k, double x) {
+    (void)x;
+    return k ? 2.0 * k - 1 : 0;
+}
 
 /**
  * Cette fonction trouve une approximation de pi obtenue par les fractions
- * infinies de Brouncker.
+ * infinies de Brouncker. La fraction est evaluee vers l'avant et son etat est
+ * garde d'un appel a l'autre, donc des appels avec un nombre de termes
+ * croissant (comme dans Converge) ne calculent que les nouveaux termes.
  *
  * iTerme : Numero du terme recherche pour calculer pi
  *
  * return : Retourne le terme de la fraction de Brouncker
  */
 double Brouncker(unsigned int iTerme) {
-    /* Terme a calculer, initialise a 2 puisque le terme divise le prochain et
-     * tout les termes sont divises par 2 au depart */
+    /* Fraction gardee entre les appels */
+    static struct fraction_continue fraction;
+    if (!fraction.numerateur)
+        fraction_initialiser(&fraction, Brouncker_numerateur,
+                             Brouncker_denominateur, 0);
+
+    return 4 / fraction_avancer(&fraction, iTerme);
+}
+
+/**
+ * Cette fonction trouve la meme approximation que Brouncker, mais en evaluant
+ * la fraction a partir de sa queue a chaque appel (c'etait la version
+ * d'origine). Elle sert de reference pour mesurer le cout de Brouncker_dd,
+ * qui procede de la meme facon, et a la recherche du nombre minimal de termes,
+ * car elle ne derive pas comme l'evaluation vers l'avant.
+ *
+ * iTerme : Numero du terme recherche pour calculer pi
+ *
+ * return : Retourne le terme de la fraction de Brouncker
+ */
+double Brouncker_queue(unsigned int iTerme) {
+    /* Fraction partielle evaluee a partir de la queue */
     double terme = 0;
 
-    /* On trouve la fraction partielle */
-    for (; iTerme; iTerme--)
-        /* On a besoin que le terme mis au carre soit un double avant sa mise au
-         * carre, d'ou le 2.0 au premier terme */
+    for (; iTerme; iTerme--) {
+        /* 2 affectations pour terme = et iTerme--, 4 additions pour les deux
+         * -, + et iTerme--, 4 multiplications pour les deux 2 *, * et /, 1
+         * comparaison pour le test de iTerme */
+        COMPTER(AFFECTATIONS, 2);
+        COMPTER(ADDITIONS, 4);
+        COMPTER(MULTIPLICATIONS, 4);
+        COMPTER(COMPARAISONS, 1);
         terme = (2.0 * iTerme - 1) * (2 * iTerme - 1) / (2.0 + terme);
+    }
 
     return 4 / (1 + terme);
 }
 
+/**
+ * Cette fonction trouve une approximation de e obtenue par la fraction
+ * continue d'Euler.
+ *
+ * nTermes : Nombre de termes de la fraction
+ *
+ * return : Retourne l'approximation de e recherchee
+ */
+double Euler(unsigned int nTermes) {
+    /* Fraction gardee entre les appels */
+    static struct fraction_continue fraction;
+    if (!fraction.numerateur)
+        fraction_initialiser(&fraction, Euler_numerateur, Euler_denominateur,
+                             0);
+
+    return fraction_avancer(&fraction, nTermes);
+}
+
+/**
+ * Cette fonction trouve une approximation de tan(1) obtenue par la fraction
+ * continue de Lambert.
+ *
+ * nTermes : Nombre de termes de la fraction
+ *
+ * return : Retourne l'approximation de tan(1) recherchee
+ */
+double Lambert(unsigned int nTermes) {
+    /* Fraction gardee entre les appels */
+    static struct fraction_continue fraction;
+    if (!fraction.numerateur)
+        fraction_initialiser(&fraction, Lambert_numerateur,
+                             Lambert_denominateur, 1);
+
+    return fraction_avancer(&fraction, nTermes);
+}
+
 /**
  * Cette fonction trouve une approximation de pi obtenue par la sommation
  * infinie de Leibniz.
@@ -55,6 +343,13 @@ double Leibniz(unsigned int nTermes) {
 
     /* On trouve la somme partielle */
     for (int i = 1; i < nTermes; i++) {
+        /* 3 affectations pour signe =, somme += et i++, 3 additions pour
+         * somme +=, + 1 et i++, 2 multiplications pour i * 2.0 et signe /, 2
+         * comparaisons pour < dans le for et le test de parite */
+        COMPTER(AFFECTATIONS, 3);
+        COMPTER(ADDITIONS, 3);
+        COMPTER(MULTIPLICATIONS, 2);
+        COMPTER(COMPARAISONS, 2);
         int signe = i % 2 ? -1 : 1;
         somme += signe / (i * 2.0 + 1);
     }
@@ -80,18 +375,312 @@ double Vieta(unsigned int nTermes) {
         double diviseur = sqrt(2);
 
         /* On trouve le diviseur */
-        for (int j = 1; j < i; j++) diviseur = sqrt(2 + diviseur);
+        for (int j = 1; j < i; j++) {
+            /* 2 affectations pour diviseur = et j++, 2 additions pour 2 + et
+             * j++, 1 multiplication pour la racine, 1 comparaison pour < */
+            COMPTER(AFFECTATIONS, 2);
+            COMPTER(ADDITIONS, 2);
+            COMPTER(MULTIPLICATIONS, 1);
+            COMPTER(COMPARAISONS, 1);
+            diviseur = sqrt(2 + diviseur);
+        }
 
+        /* 3 affectations pour diviseur =, produit *= et i++, 1 addition pour
+         * i++, 3 multiplications pour la racine de 2, / et *=, 2 comparaisons
+         * pour < dans les deux for */
+        COMPTER(AFFECTATIONS, 3);
+        COMPTER(ADDITIONS, 1);
+        COMPTER(MULTIPLICATIONS, 3);
+        COMPTER(COMPARAISONS, 2);
         produit *= 2 / diviseur;
     }
 
     return produit;
 }
 
+/**
+ * Nombre en double-double: la valeur representee est haut + bas, ou bas est
+ * plus petit que la moitie d'un ulp de haut, ce qui donne environ 106 bits de
+ * mantisse. Les operations ci-dessous suivent les algorithmes exacts de
+ * Dekker et Knuth et utilisent fma pour les produits. Elles n'ont pas de
+ * branchement (sauf la racine de 0), donc le compilateur peut les vectoriser
+ * quand on les applique sur des tableaux.
+ */
+struct double_double {
+    double haut, bas;
+};
+
+/**
+ * Cette fonction convertit un double en double-double.
+ *
+ * a : Nombre a convertir
+ *
+ * return : Le double-double a + 0
+ */
+struct double_double dd_depuis_double(double a) {
+    struct double_double resultat = {a, 0};
+    return resultat;
+}
+
+/**
+ * Cette fonction additionne exactement deux doubles (algorithme de Knuth).
+ *
+ * a, b : Nombres a additionner
+ *
+ * return : La somme exacte a + b en double-double
+ */
+struct double_double dd_somme_exacte(double a, double b) {
+    struct double_double resultat;
+    resultat.haut = a + b;
+    const double bVirtuel = resultat.haut - a;
+    resultat.bas = (a - (resultat.haut - bVirtuel)) + (b - bVirtuel);
+    return resultat;
+}
+
+/**
+ * Cette fonction additionne exactement deux doubles quand |a| >= |b|
+ * (algorithme de Dekker), elle sert a renormaliser un double-double.
+ *
+ * a, b : Nombres a additionner, avec |a| >= |b|
+ *
+ * return : La somme exacte a + b en double-double
+ */
+struct double_double dd_somme_rapide(double a, double b) {
+    struct double_double resultat;
+    resultat.haut = a + b;
+    resultat.bas = b - (resultat.haut - a);
+    return resultat;
+}
+
+/**
+ * Cette fonction multiplie exactement deux doubles grace a fma.
+ *
+ * a, b : Nombres a multiplier
+ *
+ * return : Le produit exact a * b en double-double
+ */
+struct double_double dd_produit_exact(double a, double b) {
+    struct double_double resultat;
+    resultat.haut = a * b;
+    resultat.bas = fma(a, b, -resultat.haut);
+    return resultat;
+}
+
+/**
+ * Cette fonction additionne deux double-doubles.
+ *
+ * x, y : Nombres a additionner
+ *
+ * return : La somme x + y
+ */
+struct double_double dd_addition(struct double_double x,
+                                 struct double_double y) {
+    struct double_double somme = dd_somme_exacte(x.haut, y.haut);
+    const struct double_double sommeBas = dd_somme_exacte(x.bas, y.bas);
+
+    somme = dd_somme_rapide(somme.haut, somme.bas + sommeBas.haut);
+    return dd_somme_rapide(somme.haut, somme.bas + sommeBas.bas);
+}
+
+/**
+ * Cette fonction multiplie deux double-doubles.
+ *
+ * x, y : Nombres a multiplier
+ *
+ * return : Le produit x * y
+ */
+struct double_double dd_multiplication(struct double_double x,
+                                       struct double_double y) {
+    struct double_double produit = dd_produit_exact(x.haut, y.haut);
+    produit.bas += x.haut * y.bas + x.bas * y.haut;
+    return dd_somme_rapide(produit.haut, produit.bas);
+}
+
+/**
+ * Cette fonction divise deux double-doubles par division longue (trois
+ * quotients partiels en double).
+ *
+ * x : Dividende
+ * y : Diviseur
+ *
+ * return : Le quotient x / y
+ */
+struct double_double dd_division(struct double_double x,
+                                 struct double_double y) {
+    const double q1 = x.haut / y.haut;
+    struct double_double reste = dd_addition(
+        x, dd_multiplication(y, dd_depuis_double(-q1)));
+
+    const double q2 = reste.haut / y.haut;
+    reste = dd_addition(reste, dd_multiplication(y, dd_depuis_double(-q2)));
+
+    const double q3 = reste.haut / y.haut;
+    return dd_addition(dd_somme_rapide(q1, q2), dd_depuis_double(q3));
+}
+
+/**
+ * Cette fonction trouve l'inverse d'un double en double-double, ce qui est
+ * beaucoup moins couteux qu'une division de double-doubles.
+ *
+ * a : Nombre a inverser
+ *
+ * return : 1 / a en double-double
+ */
+struct double_double dd_inverse_double(double a) {
+    const double q = 1 / a;
+    /* Le reste 1 - q * a est exact grace a fma */
+    return dd_somme_rapide(q, fma(-q, a, 1) / a);
+}
+
+/**
+ * Cette fonction trouve la racine carree d'un double-double par une iteration
+ * de Newton a partir de la racine en double.
+ *
+ * x : Nombre dont on cherche la racine, doit etre positif
+ *
+ * return : La racine carree de x
+ */
+struct double_double dd_racine(struct double_double x) {
+    if (x.haut == 0) return dd_depuis_double(0);
+
+    const double inverse = 1 / sqrt(x.haut);
+    const double approx = x.haut * inverse;
+    const struct double_double correction = dd_addition(
+        x, dd_multiplication(dd_produit_exact(approx, approx),
+                             dd_depuis_double(-1)));
+
+    return dd_addition(dd_depuis_double(approx),
+                       dd_depuis_double(correction.haut * inverse / 2));
+}
+
+/**
+ * Versions double-double des formules de Brouncker, de Leibniz et de Vieta.
+ * Elles calculent exactement les memes termes que les versions en double, mais
+ * toute l'arithmetique se fait sur environ 106 bits pour que l'erreur affichee
+ * ne soit plus limitee par l'arrondi.
+ *
+ * nTermes : Nombre de termes a calculer
+ *
+ * return : Retourne l'approximation de pi recherchee
+ */
+struct double_double Brouncker_dd(unsigned int nTermes) {
+    /* Fraction partielle evaluee a partir de la queue */
+    struct double_double terme = dd_depuis_double(0);
+    const struct double_double deux = dd_depuis_double(2);
+
+    for (; nTermes; nTermes--)
+        /* Le numerateur (2n - 1)^2 est exact en double */
+        terme = dd_division(
+            dd_depuis_double((2.0 * nTermes - 1) * (2.0 * nTermes - 1)),
+            dd_addition(deux, terme));
+
+    return dd_division(dd_depuis_double(4),
+                       dd_addition(dd_depuis_double(1), terme));
+}
+
+struct double_double Leibniz_dd(unsigned int nTermes) {
+    /* Somme a calculer, initialise au terme k = 0 de la serie de Leibniz */
+    struct double_double somme = dd_depuis_double(1);
+
+    for (unsigned int i = 1; i < nTermes; i++) {
+        struct double_double terme = dd_inverse_double(i * 2.0 + 1);
+        if (i % 2) {
+            terme.haut = -terme.haut;
+            terme.bas = -terme.bas;
+        }
+        somme = dd_addition(somme, terme);
+    }
+
+    return dd_multiplication(somme, dd_depuis_double(4));
+}
+
+struct double_double Vieta_dd(unsigned int nTermes) {
+    /* Produit a calculer, initialise au terme k = 0 du produit de Vieta */
+    struct double_double produit = dd_depuis_double(2);
+    const struct double_double deux = dd_depuis_double(2);
+
+    for (unsigned int i = 1; i < nTermes; i++) {
+        /* Diviseur du terme courant dans le produit de Vieta */
+        struct double_double diviseur = dd_racine(deux);
+
+        for (unsigned int j = 1; j < i; j++)
+            diviseur = dd_racine(dd_addition(deux, diviseur));
+
+        produit = dd_division(dd_multiplication(produit, deux), diviseur);
+    }
+
+    return produit;
+}
+
+/**
+ * Cette fonction mesure le temps moyen (en secondes) d'un appel a une formule
+ * en double ou en double-double, avec une horloge monotone. On repete la
+ * formule jusqu'a ce que TEMPS_MESURE secondes soient ecoulees.
+ *
+ * nTermes : Nombre de termes passe a la formule
+ * formule : Formule en double (NULL si on mesure formuleDD)
+ * formuleDD : Formule en double-double (NULL si on mesure formule)
+ *
+ * return : Temps moyen d'un appel en secondes
+ */
+double temps_formule(unsigned int nTermes, double (*formule)(unsigned int),
+                     struct double_double (*formuleDD)(unsigned int)) {
+    /* Resultat volatile pour que le compilateur ne retire pas les appels */
+    volatile double puits;
+    /* Nombre d'appels, debut de la mesure et temps ecoule */
+    long nAppels = 0;
+    const double debut = banc_temps_ns();
+    double ecoule;
+
+    do {
+        puits = formule ? formule(nTermes) : formuleDD(nTermes).haut;
+        nAppels++;
+        ecoule = (banc_temps_ns() - debut) * 1e-9;
+    } while (ecoule < TEMPS_MESURE);
+    (void)puits;
+
+    return ecoule / nAppels;
+}
+
+/**
+ * Cette fonction compare une formule en double a sa version en double-double:
+ * erreur par rapport a pi (sur 106 bits), erreur d'arrondi de la version en
+ * double et cout relatif de la version en double-double.
+ *
+ * nom : Nom de l'inventeur de la formule utilisee
+ * nTermes : Nombre de termes a calculer
+ * formule : Formule en double
+ * formuleDD : Formule en double-double
+ */
+void Comparer_double_double(const char nom[], unsigned int nTermes,
+                            double (*formule)(unsigned int),
+                            struct double_double (*formuleDD)(unsigned int)) {
+    const struct double_double moinsPi = {-PI_HAUT, -PI_BAS};
+
+    const double valeur = formule(nTermes);
+    const struct double_double valeurDD = formuleDD(nTermes);
+
+    /* Erreur de troncature (la version double-double est presque exacte) et
+     * erreur d'arrondi de la version en double */
+    const double erreurDD = fabs(dd_addition(valeurDD, moinsPi).haut);
+    const double erreur = fabs(
+        dd_addition(dd_depuis_double(valeur), moinsPi).haut);
+    const double arrondi = fabs(
+        dd_addition(dd_depuis_double(valeur),
+                    dd_multiplication(valeurDD, dd_depuis_double(-1)))
+            .haut);
+
+    printf("%-10s %9u %12.3e %12.3e %12.3e %9.1fx\n", nom, nTermes, erreur,
+           erreurDD, arrondi,
+           temps_formule(nTermes, NULL, formuleDD) /
+               temps_formule(nTermes, formule, NULL));
+}
+
 /**
  * Cette fonction trouve la convergence vers une constante d'une formule a une
  * certaine erreur pres.
  *
+ * constante : Nom de la constante vers laquelle la formule converge
  * nom : Message a afficher, nom de l'inventeur de la formule utilisee.
  * valeurConv : Valeur de convergence de la formule
  * errDemandee : Erreur apres laquelle on considere que la fonction a converge
@@ -101,8 +690,9 @@ double Vieta(unsigned int nTermes) {
  * afficher pour la valeur de pi approximee et son erreur
  * formule : Fonction qui converge vers la constante
  */
-void Converge(const char nom[], double valeurConv, double errDemandee,
-              int longueurInt, int precisionDouble, double (*formule)(unsigned int)) {
+void Converge(const char constante[], const char nom[], double valeurConv,
+              double errDemandee, int longueurInt, int precisionDouble,
+              double (*formule)(unsigned int)) {
     /* Variable representant le nombre de termes qu'on va ajouter a la suite a
      * la prochaine iteration */
     int increment = 1;
@@ -112,10 +702,13 @@ void Converge(const char nom[], double valeurConv, double errDemandee,
     /* Erreur de l'iteration precedente, initialisee a l'erreur maximale */
     double errPrec = PI;
 
-    printf("\nConvergence du calcul de PI avec la formule %s\n", nom);
+    printf("\nConvergence du calcul de %s avec la formule %s\n", constante,
+           nom);
+
+    MESURE_DEBUTER(mesure);
 
     /* On calcule les termes de la fonction et on les affiche */
-    while (errPrec > EPSILON1) {
+    while (errPrec > errDemandee) {
         /* Terme recherche */
         double terme = (*formule)(nTermes);
 
@@ -136,14 +729,350 @@ void Converge(const char nom[], double valeurConv, double errDemandee,
         errPrec = errCour;
         nTermes = nTermes + increment;
     }
+    MESURE_TERMINER(mesure, nom);
 }
 
-int main() {
+/**
+ * Cette fonction trouve l'erreur d'une formule avec un certain nombre de
+ * termes.
+ *
+ * valeurConv : Valeur de convergence de la formule
+ * nTermes : Nombre de termes a calculer
+ * formule : Fonction qui converge vers la constante
+ * valeur : Pointeur ou on ecrit l'approximation obtenue
+ *
+ * return : Erreur absolue de l'approximation
+ */
+double erreur_formule(double valeurConv, unsigned int nTermes,
+                      double (*formule)(unsigned int), double* valeur) {
+    *valeur = (*formule)(nTermes);
+    return fabs(valeurConv - *valeur);
+}
+
+/**
+ * Cette fonction trouve le plus petit nombre de termes pour lequel une formule
+ * approxime une constante a une certaine erreur pres, sans afficher la table
+ * de Converge. On double le nombre de termes jusqu'a encadrer le seuil, puis on
+ * coupe l'encadrement en deux jusqu'a ce qu'il ne contienne plus qu'un seul
+ * nombre de termes, ce qui demande O(log n) evaluations de la formule. La
+ * recherche suppose que l'erreur decroit avec le nombre de termes. C'est le cas
+ * en arithmetique exacte pour Brouncker, Leibniz et Vieta (et les fractions
+ * d'Euler et de Lambert), mais pas forcement en virgule flottante: l'arrondi
+ * peut faire osciller l'erreur quand elle est proche de l'erreur demandee. Le
+ * resultat respecte toujours l'erreur demandee, mais il peut alors depasser le
+ * minimum de quelques termes. Pour Brouncker, on cherche avec Brouncker_queue:
+ * la derive de l'evaluation vers l'avant deplacerait le seuil de plusieurs
+ * centaines de termes.
+ *
+ * valeurConv : Valeur de convergence de la formule
+ * errDemandee : Erreur apres laquelle on considere que la fonction a converge
+ * formule : Fonction qui converge vers la constante
+ * valeur : Pointeur ou on ecrit l'approximation obtenue avec le nombre de
+ * termes trouve
+ * nEvaluations : Pointeur ou on ecrit le nombre d'appels a la formule, peut
+ * etre NULL
+ *
+ * return : Le nombre minimal de termes, ou 0 si l'erreur demandee n'est pas
+ * atteinte avant NTERMES_MAX termes
+ */
+unsigned int Converge_minimal(double valeurConv, double errDemandee,
+                              double (*formule)(unsigned int), double* valeur,
+                              unsigned int* nEvaluations) {
+    /* Encadrement du nombre minimal de termes: l'erreur est trop grande avec
+     * nEchec termes et acceptable avec nSucces termes */
+    unsigned int nEchec = 0, nSucces = 1;
+    /* Compteur d'appels a la formule */
+    unsigned int nAppels = 1;
+
+    /* On double le nombre de termes jusqu'a respecter l'erreur demandee */
+    while (erreur_formule(valeurConv, nSucces, formule, valeur) >
+           errDemandee) {
+        if (nSucces >= NTERMES_MAX) {
+            if (nEvaluations) *nEvaluations = nAppels;
+            return 0;
+        }
+        nEchec = nSucces;
+        nSucces *= 2;
+        nAppels++;
+    }
+
+    /* Approximation associee a nSucces */
+    double valeurSucces = *valeur;
+
+    /* On coupe l'encadrement en deux jusqu'a ce qu'il soit serre */
+    while (nSucces - nEchec > 1) {
+        const unsigned int milieu = nEchec + (nSucces - nEchec) / 2;
+        nAppels++;
+        if (erreur_formule(valeurConv, milieu, formule, valeur) <=
+            errDemandee) {
+            nSucces = milieu;
+            valeurSucces = *valeur;
+        } else
+            nEchec = milieu;
+    }
+
+    *valeur = valeurSucces;
+    if (nEvaluations) *nEvaluations = nAppels;
+    return nSucces;
+}
+
+/**
+ * Cette fonction affiche le nombre minimal de termes trouve par
+ * Converge_minimal pour une formule.
+ *
+ * constante : Nom de la constante vers laquelle la formule converge
+ * nom : Message a afficher, nom de l'inventeur de la formule utilisee.
+ * valeurConv : Valeur de convergence de la formule
+ * errDemandee : Erreur apres laquelle on considere que la fonction a converge
+ * precisionDouble : Nombre de chiffre apres la virgule qu'on veut
+ * afficher pour la valeur approximee
+ * formule : Fonction qui converge vers la constante
+ */
+void Afficher_minimal(const char constante[], const char nom[],
+                      double valeurConv, double errDemandee,
+                      int precisionDouble, double (*formule)(unsigned int)) {
+    /* Approximation obtenue et nombre d'appels a la formule */
+    double valeur;
+    unsigned int nEvaluations;
+
+    const unsigned int nTermes = Converge_minimal(valeurConv, errDemandee,
+                                                  formule, &valeur,
+                                                  &nEvaluations);
+    if (!nTermes)
+        printf("%-6s %-13s: erreur de %.0e non atteinte apres %u termes\n",
+               constante, nom, errDemandee, NTERMES_MAX);
+    else
+        printf("%-6s %-13s: %9u termes pour une erreur de %.0e, "
+               "valeur = %.*lf (%u evaluations)\n",
+               constante, nom, nTermes, errDemandee, precisionDouble, valeur,
+               nEvaluations);
+}
+
+/**
+ * Cette fonction evalue une fraction continue sans connaitre sa valeur, en
+ * s'arretant quand deux convergents successifs sont egaux a une tolerance
+ * relative pres (fraction_evaluer), puis compare le resultat a la valeur
+ * connue: erreur du dernier convergent et plus petit nombre de termes qui
+ * donnait deja cette erreur, trouve parmi les convergents gardes.
+ *
+ * constante : Nom de la constante vers laquelle la fraction converge
+ * nom : Message a afficher, nom de l'inventeur de la fraction utilisee.
+ * valeurConv : Valeur de convergence de la fraction
+ * tolerance : Ecart relatif entre deux convergents sous lequel on arrete
+ * numerateur : Generateur des numerateurs partiels a_k
+ * denominateur : Generateur des denominateurs partiels b_k
+ * x : Parametre passe aux generateurs
+ */
+void Afficher_tolerance(const char constante[], const char nom[],
+                        double valeurConv, double tolerance,
+                        double (*numerateur)(unsigned int, double),
+                        double (*denominateur)(unsigned int, double),
+                        double x) {
+    struct fraction_continue fraction;
+    double convergents[N_CONVERGENTS_MAX];
+
+    fraction_initialiser(&fraction, numerateur, denominateur, x);
+    const unsigned int nTermes =
+        fraction_evaluer(&fraction, N_CONVERGENTS_MAX, tolerance, convergents);
+    const double erreur = fabs(valeurConv - fraction.convergent);
+
+    /* Premier convergent aussi proche de la valeur que le dernier */
+    unsigned int nSuffisant = 1;
+    while (fabs(valeurConv - convergents[nSuffisant - 1]) > erreur)
+        nSuffisant++;
+
+    printf("%-6s %-13s: %3u termes, valeur = %.14lf, erreur = %.1e "
+           "(atteinte des %u termes)\n",
+           constante, nom, nTermes, fraction.convergent, erreur, nSuffisant);
+}
+
+/**
+ * Formule mesuree par le mode --benchmark.
+ */
+struct formule_mesuree {
+    /* Nom de la constante et nom de la formule */
+    const char *constante, *nom;
+    /* Valeur de convergence et plus petite erreur visee */
+    double valeurConv, errMin;
+    /* Fonction qui converge vers la constante */
+    double (*formule)(unsigned int);
+};
+
+/**
+ * Cette fonction mesure le temps qu'une formule prend pour atteindre chaque
+ * decade d'erreur (10^-1, 10^-2, ..., errMin). Pour chaque decade, on note le
+ * nombre minimal de termes, le nombre d'appels a la formule faits par
+ * Converge_minimal, le temps total de la recherche et le temps par terme d'un
+ * seul appel avec ce nombre de termes, tous mesures avec une horloge monotone.
+ * Les resultats sont affiches et ecrits en CSV et en JSON pour tracer des
+ * courbes de convergence en fonction du temps et les suivre d'une version a
+ * l'autre.
+ *
+ * mesuree : Formule a mesurer
+ * csv : Fichier CSV ou on ajoute une ligne par decade
+ * json : Fichier JSON ou on ajoute un objet par decade
+ * premier : Vrai si aucun objet n'a encore ete ecrit dans le fichier JSON
+ *
+ * return : Vrai si aucun objet n'a encore ete ecrit dans le fichier JSON
+ */
+int Benchmark_convergence(const struct formule_mesuree* mesuree, FILE* csv,
+                          FILE* json, int premier) {
+    for (int decade = 1; pow(10, -decade) >= mesuree->errMin * 0.99;
+         decade++) {
+        /* Erreur demandee pour cette decade */
+        const double tolerance = pow(10, -decade);
+        /* Approximation obtenue, nombre d'appels et nombre de termes */
+        double valeur;
+        unsigned int nEvaluations;
+
+        const double debut = banc_temps_ns();
+        const unsigned int nTermes =
+            Converge_minimal(mesuree->valeurConv, tolerance, mesuree->formule,
+                             &valeur, &nEvaluations);
+        const double nsRecherche = banc_temps_ns() - debut;
+        if (!nTermes) break;
+
+        /* On repart de 0 terme pour que les formules qui gardent leur etat
+         * d'un appel a l'autre (Euler et Lambert) calculent vraiment chaque
+         * terme */
+        mesuree->formule(0);
+        const double debutAppel = banc_temps_ns();
+        mesuree->formule(nTermes);
+        const double nsParTerme = (banc_temps_ns() - debutAppel) / nTermes;
+
+        printf("%-6s %-13s %8.0e %10u %6u %14.0f %10.2f\n",
+               mesuree->constante, mesuree->nom, tolerance, nTermes,
+               nEvaluations, nsRecherche, nsParTerme);
+        fprintf(csv, "%s,%s,%.0e,%u,%u,%.0f,%.3f\n", mesuree->constante,
+                mesuree->nom, tolerance, nTermes, nEvaluations, nsRecherche,
+                nsParTerme);
+        fprintf(json,
+                "%s  {\"constante\": \"%s\", \"formule\": \"%s\", "
+                "\"tolerance\": %.0e, \"termes\": %u, \"appels\": %u, "
+                "\"ns\": %.0f, \"ns_par_terme\": %.3f}",
+                premier ? "" : ",\n", mesuree->constante, mesuree->nom,
+                tolerance, nTermes, nEvaluations, nsRecherche, nsParTerme);
+        premier = 0;
+    }
+
+    return premier;
+}
+
+/**
+ * Cette fonction execute le mode --benchmark sur toutes les formules du
+ * programme et ecrit les fichiers NOM_FICHIER_CSV et NOM_FICHIER_JSON.
+ *
+ * return : 0 si tout s'est bien passe, 1 si on n'a pas pu ouvrir un fichier
+ */
+int Benchmark(void) {
+    const struct formule_mesuree formules[] = {
+        {"PI", "de Brouncker", PI, EPSILON1, Brouncker_queue},
+        {"PI", "de Leibniz", PI, EPSILON1, Leibniz},
+        {"PI", "de Vieta", PI, EPSILON2, Vieta},
+        {"e", "d'Euler", E, EPSILON2, Euler},
+        {"tan(1)", "de Lambert", TAN1, EPSILON2, Lambert},
+    };
+    const int nFormules = sizeof formules / sizeof formules[0];
+
+    FILE* csv = fopen(NOM_FICHIER_CSV, "w");
+    FILE* json = fopen(NOM_FICHIER_JSON, "w");
+    if (!csv || !json) {
+        printf("Impossible d'ouvrir les fichiers de resultats\n");
+        if (csv) fclose(csv);
+        if (json) fclose(json);
+        return 1;
+    }
+
+    printf("Const. Formule       Toler.     Termes Appels   Temps (ns)   "
+           "ns/terme\n");
+    fprintf(csv, "constante,formule,tolerance,termes,appels,ns,ns_par_terme\n");
+    fprintf(json, "[\n");
+
+    /* Vrai tant qu'aucun objet n'a ete ecrit dans le fichier JSON */
+    int premier = 1;
+    for (int i = 0; i < nFormules; i++)
+        premier = Benchmark_convergence(&formules[i], csv, json, premier);
+
+    fprintf(json, "\n]\n");
+    fclose(csv);
+    fclose(json);
+    return 0;
+}
+
+/**
+ * Noyau du banc d'essai: une formule en double ou en double-double (l'autre
+ * est NULL) evaluee avec un nombre de termes fixe.
+ */
+struct banc_formule {
+    const char* nom;
+    double (*formule)(unsigned int);
+    struct double_double (*formuleDD)(unsigned int);
+    unsigned int nTermes;
+    /* Approximation obtenue, resultat du noyau */
+    double valeur;
+};
+
+/**
+ * Cette fonction evalue la formule d'un noyau du banc d'essai.
+ *
+ * donnees : Pointeur vers une struct banc_formule
+ */
+void banc_formule(void* donnees) {
+    struct banc_formule* banc = donnees;
+    banc->valeur = banc->formule ? banc->formule(banc->nTermes)
+                                 : banc->formuleDD(banc->nTermes).haut;
+}
+
+int main(int argc, char* argv[]) {
+    /* Noyaux du banc d'essai, avec les nombres de termes de la comparaison
+     * en double-double. Les fractions evaluees vers l'avant (Brouncker, Euler
+     * et Lambert) gardent leur etat d'un appel a l'autre, donc un appel
+     * repete ne calcule rien: on mesure Brouncker_queue a la place. */
+    static struct banc_formule bancs[] = {
+        {"Brouncker (queue, 1000 termes)", Brouncker_queue, NULL, 1000, 0},
+        {"Brouncker dd (1000 termes)", NULL, Brouncker_dd, 1000, 0},
+        {"Leibniz (1000000 termes)", Leibniz, NULL, 1000000, 0},
+        {"Leibniz dd (1000000 termes)", NULL, Leibniz_dd, 1000000, 0},
+        {"Vieta (25 termes)", Vieta, NULL, 25, 0},
+        {"Vieta dd (25 termes)", NULL, Vieta_dd, 25, 0}};
+    for (int i = 0; i < (int)(sizeof bancs / sizeof bancs[0]); i++)
+        banc_enregistrer(bancs[i].nom, banc_formule, &bancs[i]);
+    if (banc_lancer(argc, argv)) return 0;
+
+    /* Mode qui mesure le temps pour atteindre chaque tolerance */
+    if (argc > 1 && !strcmp(argv[1], "--benchmark")) return Benchmark();
+
     /* Je sais que le main n'est pas exactement pareil a ce qui est demande,
      * mais ma version est plus modulable donc je la garde */
-    Converge("de Brouncker", PI, EPSILON1, 9, 7, Brouncker);
-    Converge("de Leibniz", PI, EPSILON1, 9, 7, Leibniz);
-    Converge("de Vieta", PI, EPSILON2, 2, 14, Vieta);
+    Converge("PI", "de Brouncker", PI, EPSILON1, 9, 7, Brouncker);
+    Converge("PI", "de Leibniz", PI, EPSILON1, 9, 7, Leibniz);
+    Converge("PI", "de Vieta", PI, EPSILON2, 2, 14, Vieta);
+    Converge("e", "d'Euler", E, EPSILON1, 2, 7, Euler);
+    Converge("tan(1)", "de Lambert", TAN1, EPSILON1, 2, 7, Lambert);
+
+    printf("\nNombre minimal de termes\n");
+    Afficher_minimal("PI", "de Brouncker", PI, EPSILON1, 7, Brouncker_queue);
+    Afficher_minimal("PI", "de Leibniz", PI, EPSILON1, 7, Leibniz);
+    Afficher_minimal("PI", "de Vieta", PI, EPSILON2, 14, Vieta);
+    Afficher_minimal("e", "d'Euler", E, EPSILON1, 7, Euler);
+    Afficher_minimal("tan(1)", "de Lambert", TAN1, EPSILON1, 7, Lambert);
+
+    printf("\nArret quand deux convergents sont egaux a %.0e pres\n",
+           EPSILON2);
+    Afficher_tolerance("e", "d'Euler", E, EPSILON2, Euler_numerateur,
+                       Euler_denominateur, 0);
+    Afficher_tolerance("tan(1)", "de Lambert", TAN1, EPSILON2,
+                       Lambert_numerateur, Lambert_denominateur, 1);
+
+    printf("\nDouble-double (erreurs par rapport a PI sur 106 bits)\n");
+    printf("Formule       Termes  Err. double     Err. dd  Arrondi dbl  "
+           "Cout dd\n");
+    Comparer_double_double("Brouncker", 1000, Brouncker_queue,
+                           Brouncker_dd);
+    Comparer_double_double("Leibniz", 1000000, Leibniz, Leibniz_dd);
+    Comparer_double_double("Vieta", 25, Vieta, Vieta_dd);
+    Comparer_double_double("Vieta", 30, Vieta, Vieta_dd);
+    Comparer_double_double("Vieta", 40, Vieta, Vieta_dd);
     return 0;
 }
 
@@ -220,4 +1149,101 @@ Valeur avec  7 termes = 3.14127725093277, erreur = 0.00031540265702
 Valeur avec  9 termes = 3.14157294036709, erreur = 0.00001971322270
 Valeur avec 11 termes = 3.14159142151120, erreur = 0.00000123207859
 Valeur avec 13 termes = 3.14159257658487, erreur = 0.00000007700492
+Valeur avec 15 termes = 3.14159264877699, erreur = 0.00000000481280
+Valeur avec 17 termes = 3.14159265328899, erreur = 0.00000000030080
+Valeur avec 19 termes = 3.14159265357099, erreur = 0.00000000001880
+Valeur avec 21 termes = 3.14159265358862, erreur = 0.00000000000117
+Valeur avec 23 termes = 3.14159265358972, erreur = 0.00000000000007
+Valeur avec 25 termes = 3.14159265358979, erreur = 0.00000000000000
+
+Convergence du calcul de e avec la formule d'Euler
+Valeur avec  1 terme  = 3.0000000, erreur = 0.2817182
+Valeur avec  3 termes = 2.7272727, erreur = 0.0089909
+Valeur avec  5 termes = 2.7184466, erreur = 0.0001648
+Valeur avec  7 termes = 2.7182837, erreur = 0.0000019
+Valeur avec  9 termes = 2.7182818, erreur = 0.0000000
+
+Convergence du calcul de tan(1) avec la formule de Lambert
+Valeur avec  1 terme  = 1.0000000, erreur = 0.5574077
+Valeur avec  3 termes = 1.5555556, erreur = 0.0018522
+Valeur avec  5 termes = 1.5574074, erreur = 0.0000003
+Valeur avec  7 termes = 1.5574077, erreur = 0.0000000
+
+Nombre minimal de termes
+PI     de Brouncker :   9999999 termes pour une erreur de 1e-07, valeur = 3.1415926 (48 evaluations)
+PI     de Leibniz   :  10000000 termes pour une erreur de 1e-07, valeur = 3.1415926 (48 evaluations)
+PI     de Vieta     :        25 termes pour une erreur de 1e-14, valeur = 3.14159265358979 (10 evaluations)
+e      d'Euler      :         9 termes pour une erreur de 1e-07, valeur = 2.7182818 (8 evaluations)
+tan(1) de Lambert   :         6 termes pour une erreur de 1e-07, valeur = 1.5574077 (6 evaluations)
+
+Arret quand deux convergents sont egaux a 1e-14 pres
+e      d'Euler      :  15 termes, valeur = 2.71828182845905, erreur = 2.7e-15 (atteinte des 15 termes)
+tan(1) de Lambert   :  10 termes, valeur = 1.55740772465490, erreur = 1.6e-15 (atteinte des 9 termes)
+
+Double-double (erreurs par rapport a PI sur 106 bits)
+Formule       Termes  Err. double     Err. dd  Arrondi dbl  Cout dd
+Brouncker       1000    9.990e-04    9.990e-04    1.450e-16      10.8x
+Leibniz      1000000    1.000e-06    1.000e-06    1.891e-14       7.3x
+Vieta             25    1.899e-15    4.590e-15    2.691e-15      19.8x
+Vieta             30    3.874e-15    4.482e-18    3.879e-15      19.7x
+Vieta             40    3.874e-15    4.275e-24    3.874e-15      17.9x
+
+--benchmark
+Const. Formule       Toler.     Termes Appels   Temps (ns)   ns/terme
+PI     de Brouncker     1e-01          9      8           1131      12.22
+PI     de Brouncker     1e-02         99     14           5145       6.70
+PI     de Brouncker     1e-03        999     20          66644       6.35
+PI     de Brouncker     1e-04       9999     28        1038215       6.30
+PI     de Brouncker     1e-05      99999     34       12110733       6.31
+PI     de Brouncker     1e-06     999999     40      134536015       6.37
+PI     de Brouncker     1e-07    9999999     48     1691264559       6.18
+PI     de Leibniz       1e-01         10      8            702      14.30
+PI     de Leibniz       1e-02        100     14           1597       2.24
+PI     de Leibniz       1e-03       1000     20          15535       1.48
+PI     de Leibniz       1e-04      10000     28         235727       1.44
+PI     de Leibniz       1e-05     100001     34        2740185       1.43
+PI     de Leibniz       1e-06    1000001     40       30197795       1.45
+PI     de Leibniz       1e-07   10000000     48      390634980       1.72
+PI     de Vieta         1e-01          3      4            374      20.33
+PI     de Vieta         1e-02          5      6            472      16.60
+PI     de Vieta         1e-03          7      6            384      19.86
+PI     de Vieta         1e-04          8      6            320      18.38
+PI     de Vieta         1e-05         10      8           1041      20.90
+PI     de Vieta         1e-06         12      8            982      16.50
+PI     de Vieta         1e-07         13      8           1055      19.08
+PI     de Vieta         1e-08         15      8           1161      21.00
+PI     de Vieta         1e-09         17     10           4105      23.35
+PI     de Vieta         1e-10         18     10           4197      24.39
+PI     de Vieta         1e-11         20     10           4581      28.00
+PI     de Vieta         1e-12         22     10           4712      32.91
+PI     de Vieta         1e-13         23     10           4987      32.26
+PI     de Vieta         1e-14         25     10           5925      57.20
+e      d'Euler          1e-01          2      2            903      50.50
+e      d'Euler          1e-02          3      4            279      32.00
+e      d'Euler          1e-03          5      6            265      18.80
+e      d'Euler          1e-04          6      6            239      18.17
+e      d'Euler          1e-05          7      6            463      18.71
+e      d'Euler          1e-06          8      6            221      16.38
+e      d'Euler          1e-07          9      8            459      16.00
+e      d'Euler          1e-08         10      8            318      15.40
+e      d'Euler          1e-09         11      8            339      15.45
+e      d'Euler          1e-10         11      8            281      15.36
+e      d'Euler          1e-11         12      8            310      15.50
+e      d'Euler          1e-12         13      8            329      14.69
+e      d'Euler          1e-13         14      8            329      14.29
+e      d'Euler          1e-14         15      8            369      14.67
+tan(1) de Lambert       1e-01          2      2            379      57.50
+tan(1) de Lambert       1e-02          3      4            254      31.67
+tan(1) de Lambert       1e-03          4      4            143      23.00
+tan(1) de Lambert       1e-04          4      4            142      21.75
+tan(1) de Lambert       1e-05          5      6            303      18.80
+tan(1) de Lambert       1e-06          5      6            182      19.00
+tan(1) de Lambert       1e-07          6      6            191      21.33
+tan(1) de Lambert       1e-08          6      6            189      18.17
+tan(1) de Lambert       1e-09          7      6            222      28.29
+tan(1) de Lambert       1e-10          7      6            176      17.57
+tan(1) de Lambert       1e-11          8      6            232      19.50
+tan(1) de Lambert       1e-12          8      6            210      17.12
+tan(1) de Lambert       1e-13          8      6            240      17.12
+tan(1) de Lambert       1e-14          9      8            405      16.00
 */
@@ -5,11 +5,27 @@
  * (methode des trapezes, de Simpson et de Simpson 3/8). On a pense a la
  * modularite du code, donc on utilise pas la fonction exponentielle directement
  * mais elle est passee en argument aux diverses methodes. On execute le code
- * tant que l'utilisateur le demande.
+ * tant que l'utilisateur le demande. Compile avec -DCOMPTER_OPERATIONS ou
+ * -DCOMPTEURS_MATERIELS, il affiche aussi les operations et les compteurs du
+ * processeur des methodes (voir compteurs.h). Avec l'argument --banc, il
+ * mesure plutot chaque methode sur [0, 1] avec le banc d'essai de banc.h (voir
+ * ce fichier pour les options).
  */
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 
+#include "../banc.h"
+#include "../compteurs.h"
+
+/* Nombre d'intervalles de la grille commune, multiple de 6, 12, 18, 24 et 30
+ * (les nombres d'intervalles du tableau affiche par main) */
+#define N_INTERVALLES_GRILLE 360
+/* Nombre maximal de niveaux (de lignes) du tableau de Romberg */
+#define NIVEAUX_MAX 20
+/* Ecart entre deux diagonales du tableau de Romberg sous lequel on arrete */
+#define TOLERANCE_ROMBERG 1e-12
+
 /**
  * Cette fonction trouve la valeur exacte (si on ne prend pas en compte l'erreur
  * introduite sur les doubles par C) de l'integrale entre borneInf et borneSup
@@ -133,7 +149,339 @@ void montre_resultats(const char nom[], int nTermes, float borneInf,
             integraleApprox, erreur);
 }
 
-int main(){
+/**
+ * Grille commune d'echantillons d'une fonction: les noeuds sont
+ * borneInf + i * (borneSup - borneInf) / nIntervalles, et la valeur de la
+ * fonction a un noeud n'est calculee que la premiere fois qu'une methode en a
+ * besoin. Les methodes des trapezes, de Simpson et de Simpson 3/8 deviennent
+ * des sommes ponderees sur les noeuds de la grille, donc les comparer sur les
+ * memes intervalles ne coute qu'une seule serie d'evaluations.
+ */
+struct grille {
+    float borneInf, borneSup;
+    int nIntervalles;
+    double (*fonction)(double);
+    /* Valeurs de la fonction aux noeuds et indicateurs de calcul */
+    double* valeurs;
+    char* calcule;
+    /* Nombre d'appels a la fonction faits jusqu'a present */
+    int nEvaluations;
+};
+
+/**
+ * Cette fonction prepare une grille commune d'echantillons, sans evaluer la
+ * fonction.
+ *
+ * grille : Grille a initialiser
+ * borneInf : Borne inferieure d'integration
+ * borneSup : Borne superieure d'integration
+ * nIntervalles : Nombre d'intervalles de la grille, doit etre un multiple du
+ * nombre d'intervalles de chaque methode qui l'utilise
+ * fonction : Fonction a integrer
+ *
+ * return : 0 si tout s'est bien passe, 1 si la memoire est insuffisante
+ */
+int grille_initialiser(struct grille* grille, float borneInf, float borneSup,
+                       int nIntervalles, double (*fonction)(double)) {
+    grille->borneInf = borneInf;
+    grille->borneSup = borneSup;
+    grille->nIntervalles = nIntervalles;
+    grille->fonction = fonction;
+    grille->nEvaluations = 0;
+    grille->valeurs = malloc((nIntervalles + 1) * sizeof(double));
+    grille->calcule = calloc(nIntervalles + 1, sizeof(char));
+
+    if (!grille->valeurs || !grille->calcule) {
+        free(grille->valeurs);
+        free(grille->calcule);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Cette fonction libere la memoire d'une grille commune d'echantillons.
+ *
+ * grille : Grille a liberer
+ */
+void grille_liberer(struct grille* grille) {
+    free(grille->valeurs);
+    free(grille->calcule);
+}
+
+/**
+ * Cette fonction donne la valeur de la fonction a un noeud de la grille, en
+ * l'evaluant seulement si elle n'a pas deja ete calculee.
+ *
+ * grille : Grille d'echantillons
+ * indice : Indice du noeud, entre 0 et nIntervalles
+ *
+ * return : Valeur de la fonction au noeud
+ */
+double grille_valeur(struct grille* grille, int indice) {
+    if (!grille->calcule[indice]) {
+        /* Largeur d'un intervalle de la grille */
+        const double pas = ((double)grille->borneSup - grille->borneInf) /
+                           grille->nIntervalles;
+        grille->valeurs[indice] = grille->fonction(grille->borneInf +
+                                                   indice * pas);
+        grille->calcule[indice] = 1;
+        grille->nEvaluations++;
+    }
+    return grille->valeurs[indice];
+}
+
+/**
+ * Versions des methodes des trapezes, de Simpson et de Simpson 3/8 qui lisent
+ * les valeurs de la fonction dans une grille commune. Les poids sont les memes
+ * que dans les versions qui evaluent la fonction directement.
+ *
+ * grille : Grille d'echantillons, son nombre d'intervalles doit etre un
+ * multiple de nTermes
+ * nTermes : Nombre de termes a calculer pour la sommation
+ *
+ * return : Valeur de l'integrale approximee
+ */
+double Trapeze_grille(struct grille* grille, int nTermes) {
+    /* Ecart entre deux noeuds utilises, en indices de la grille */
+    const int saut = grille->nIntervalles / nTermes;
+
+    double integrale = (grille_valeur(grille, 0) +
+                        grille_valeur(grille, grille->nIntervalles)) / 2;
+    for (int i = 1; i < nTermes; i++) {
+        /* 2 affectations pour += et i++, 2 additions pour += et i++, 1
+         * multiplication pour i * saut, 1 comparaison pour < */
+        COMPTER(AFFECTATIONS, 2);
+        COMPTER(ADDITIONS, 2);
+        COMPTER(MULTIPLICATIONS, 1);
+        COMPTER(COMPARAISONS, 1);
+        integrale += grille_valeur(grille, i * saut);
+    }
+
+    return ((double)grille->borneSup - grille->borneInf) / nTermes * integrale;
+}
+
+double Simpson_grille(struct grille* grille, int nTermes) {
+    /* Ecart entre deux noeuds utilises, en indices de la grille */
+    const int saut = grille->nIntervalles / nTermes;
+
+    double integrale = grille_valeur(grille, 0) +
+                       grille_valeur(grille, grille->nIntervalles);
+    for (int i = 1; i < nTermes; i++) {
+        /* 2 affectations pour += et i++, 2 additions pour += et i++, 2
+         * multiplications pour le poids et i * saut, 2 comparaisons pour < et
+         * le choix du poids */
+        COMPTER(AFFECTATIONS, 2);
+        COMPTER(ADDITIONS, 2);
+        COMPTER(MULTIPLICATIONS, 2);
+        COMPTER(COMPARAISONS, 2);
+        integrale += (i % 2 ? 4 : 2) * grille_valeur(grille, i * saut);
+    }
+
+    return ((double)grille->borneSup - grille->borneInf) / nTermes / 3 *
+           integrale;
+}
+
+double Simpson3Sur8_grille(struct grille* grille, int nTermes) {
+    /* Ecart entre deux noeuds utilises, en indices de la grille */
+    const int saut = grille->nIntervalles / nTermes;
+
+    double integrale = grille_valeur(grille, 0) +
+                       grille_valeur(grille, grille->nIntervalles);
+    for (int i = 1; i < nTermes; i++) {
+        /* Memes operations que dans Simpson_grille */
+        COMPTER(AFFECTATIONS, 2);
+        COMPTER(ADDITIONS, 2);
+        COMPTER(MULTIPLICATIONS, 2);
+        COMPTER(COMPARAISONS, 2);
+        integrale += (i % 3 ? 3 : 2) * grille_valeur(grille, i * saut);
+    }
+
+    return 3 * ((double)grille->borneSup - grille->borneInf) / nTermes / 8 *
+           integrale;
+}
+
+/**
+ * Cette fonction montre le resultat d'une integration numerique qui lit ses
+ * valeurs dans une grille commune.
+ *
+ * nom : Nom de la methode utilisee pour integrer
+ * nTermes : nombre de termes necessaires a l'integration
+ * grille : Grille d'echantillons de la fonction a integrer
+ * integraleExacte : Valeur veritable de l'integrale
+ * methode : Methode d'integration utilisee
+ */
+void montre_resultats_grille(const char nom[], int nTermes,
+                             struct grille* grille, double integraleExacte,
+                             double (*methode)(struct grille*, int)) {
+    double integraleApprox = methode(grille, nTermes);
+    double erreur =
+        fabs(integraleApprox - integraleExacte) / integraleExacte * 100;
+
+    printf("%-12s %8d %19.14f  %10.6lf%%\n", nom, nTermes,
+            integraleApprox, erreur);
+}
+
+/**
+ * On raffine une approximation de la methode des trapezes en doublant son
+ * nombre d'intervalles. Les noeuds de l'ancienne approximation sont deja
+ * comptes dans celle-ci, donc on n'evalue la fonction qu'aux nouveaux points
+ * milieux.
+ *
+ * precedente : Valeur de la methode des trapezes avec nTermes intervalles
+ * nTermes : Nombre d'intervalles de l'approximation precedente
+ * borneInf : Borne inferieure d'integration
+ * borneSup : Borne superieure d'integration
+ * fonction : Fonction a integrer
+ *
+ * return : Valeur de la methode des trapezes avec 2 * nTermes intervalles
+ */
+double Trapeze_raffiner(double precedente, int nTermes, float borneInf,
+                        float borneSup, double (*fonction)(double)) {
+    /* Hauteur d'un trapeze de l'approximation precedente */
+    const double hauteur = (borneSup - borneInf) / nTermes;
+
+    /* Somme des valeurs aux nouveaux points milieux */
+    double somme = 0;
+    for (int i = 0; i < nTermes; i++) {
+        /* 2 affectations pour += et i++, 4 additions pour +=, les deux + et
+         * i++, 1 multiplication pour * hauteur, 1 comparaison pour < */
+        COMPTER(AFFECTATIONS, 2);
+        COMPTER(ADDITIONS, 4);
+        COMPTER(MULTIPLICATIONS, 1);
+        COMPTER(COMPARAISONS, 1);
+        somme += fonction(borneInf + (i + 0.5) * hauteur);
+    }
+
+    return precedente / 2 + hauteur / 2 * somme;
+}
+
+/**
+ * On trouve la valeur de l'integrale d'une fonction entre borneInf et
+ * borneSup par la methode de Romberg. La ligne k du tableau commence par la
+ * methode des trapezes avec 2^k intervalles (obtenue en raffinant la ligne
+ * precedente) et les colonnes suivantes sont des extrapolations de
+ * Richardson: la colonne 1 est la methode de Simpson, la colonne 2 celle de
+ * Boole, etc. On arrete quand deux elements successifs de la diagonale sont
+ * egaux a une tolerance pres.
+ *
+ * borneInf : Borne inferieure d'integration
+ * borneSup : Borne superieure d'integration
+ * fonction : Fonction a integrer
+ * tolerance : Ecart entre deux elements de la diagonale sous lequel on arrete
+ * tableau : Tableau de Romberg a remplir
+ * nNiveaux : Pointeur ou on ecrit le nombre de lignes remplies
+ * nEvaluations : Pointeur ou on ecrit le nombre d'appels a fonction
+ *
+ * return : Dernier element de la diagonale du tableau
+ */
+double Romberg(float borneInf, float borneSup, double (*fonction)(double),
+               double tolerance, double tableau[][NIVEAUX_MAX], int* nNiveaux,
+               int* nEvaluations) {
+    tableau[0][0] = Trapeze(1, borneInf, borneSup, fonction);
+    *nEvaluations = 2;
+
+    int k;
+    for (k = 1; k < NIVEAUX_MAX; k++) {
+        /* Nombre d'intervalles de la ligne precedente */
+        const int nTermes = 1 << (k - 1);
+        tableau[k][0] = Trapeze_raffiner(tableau[k - 1][0], nTermes, borneInf,
+                                         borneSup, fonction);
+        *nEvaluations += nTermes;
+
+        /* Extrapolations de Richardson, avec le facteur 4^j */
+        double puissance4 = 1;
+        for (int j = 1; j <= k; j++) {
+            puissance4 *= 4;
+            tableau[k][j] = tableau[k][j - 1] +
+                            (tableau[k][j - 1] - tableau[k - 1][j - 1]) /
+                                (puissance4 - 1);
+        }
+
+        if (fabs(tableau[k][k] - tableau[k - 1][k - 1]) <= tolerance) {
+            k++;
+            break;
+        }
+    }
+
+    *nNiveaux = k;
+    return tableau[k - 1][k - 1];
+}
+
+/**
+ * Cette fonction montre le tableau de Romberg a l'utilisateur et le resultat
+ * de la methode, avec le nombre d'appels a la fonction a integrer.
+ *
+ * borneInf : Borne inferieure d'integration
+ * borneSup : Borne superieure d'integration
+ * integraleExacte : Valeur veritable de l'integrale
+ * fonction : Fonction a integrer
+ */
+void montre_Romberg(float borneInf, float borneSup, double integraleExacte,
+                    double (*fonction)(double)) {
+    /* Tableau de Romberg, son nombre de lignes et le nombre d'appels a la
+     * fonction */
+    double tableau[NIVEAUX_MAX][NIVEAUX_MAX];
+    int nNiveaux, nEvaluations;
+
+    const double integraleApprox =
+        Romberg(borneInf, borneSup, fonction, TOLERANCE_ROMBERG, tableau,
+                &nNiveaux, &nEvaluations);
+
+    printf("Tableau de Romberg (ligne k: trapezes avec 2^k intervalles)\n");
+    for (int k = 0; k < nNiveaux; k++) {
+        printf("%2d", k);
+        for (int j = 0; j <= k; j++) printf(" %17.14f", tableau[k][j]);
+        printf("\n");
+    }
+
+    const double erreur =
+        fabs(integraleApprox - integraleExacte) / integraleExacte * 100;
+    printf("%-12s %8d %19.14f  %10.6lf%%  (%d evaluations)\n\n", "Romberg",
+           1 << (nNiveaux - 1), integraleApprox, erreur, nEvaluations);
+}
+
+/**
+ * Noyau du banc d'essai: une methode d'integration de exp sur [0, 1] avec
+ * N_INTERVALLES_GRILLE intervalles, ou Romberg si methode est NULL.
+ */
+struct banc_integration {
+    const char* nom;
+    double (*methode)(int, float, float, double (*)(double));
+    /* Integrale obtenue, resultat du noyau */
+    double valeur;
+};
+
+/**
+ * Cette fonction calcule l'integrale d'un noyau du banc d'essai.
+ *
+ * donnees : Pointeur vers une struct banc_integration
+ */
+void banc_integration(void* donnees) {
+    struct banc_integration* banc = donnees;
+
+    if (banc->methode) {
+        banc->valeur = banc->methode(N_INTERVALLES_GRILLE, 0, 1, exp);
+        return;
+    }
+
+    double tableau[NIVEAUX_MAX][NIVEAUX_MAX];
+    int nNiveaux, nEvaluations;
+    banc->valeur = Romberg(0, 1, exp, TOLERANCE_ROMBERG, tableau, &nNiveaux,
+                           &nEvaluations);
+}
+
+int main(int argc, char* argv[]){
+    /* Noyaux du banc d'essai */
+    static struct banc_integration bancs[] = {
+        {"Trapeze (360 intervalles)", Trapeze, 0},
+        {"Simpson (360 intervalles)", Simpson, 0},
+        {"Simpson 3/8 (360 intervalles)", Simpson3Sur8, 0},
+        {"Romberg (tolerance 1e-12)", NULL, 0}};
+    for (int i = 0; i < (int)(sizeof bancs / sizeof bancs[0]); i++)
+        banc_enregistrer(bancs[i].nom, banc_integration, &bancs[i]);
+    if (banc_lancer(argc, argv)) return 0;
+
     /* Bornes d'integrations */
     float borneInf, borneSup;
 
@@ -151,16 +499,38 @@ int main(){
 
         printf("Methode   Intervalles   Valeur approximee       Erreur\n\n");
 
+        /* Grille commune a toutes les methodes du tableau, pour ne jamais
+         * evaluer la fonction deux fois au meme noeud */
+        struct grille grille;
+        if (grille_initialiser(&grille, borneInf, borneSup,
+                               N_INTERVALLES_GRILLE, exp)) {
+            printf("Memoire insuffisante\n");
+            return 1;
+        }
+
+        /* Nombre d'appels qu'auraient faits les methodes sans la grille */
+        int nEvaluationsSansGrille = 0;
+
+        MESURE_DEBUTER(mesure);
         /* Boucle sur le nombre de termes utilises pour calculer l'integrale */
         for(int nTermes = 6; nTermes <= 30; nTermes += 6){
-            montre_resultats("Trapeze", nTermes, borneInf, borneSup, integraleExacte, exp,
-                            Trapeze);
-            montre_resultats("Simpson", nTermes, borneInf, borneSup, integraleExacte, exp,
-                            Simpson);
-            montre_resultats("Simpson 3/8", nTermes, borneInf, borneSup, integraleExacte, exp,
-                            Simpson3Sur8);
+            montre_resultats_grille("Trapeze", nTermes, &grille,
+                                    integraleExacte, Trapeze_grille);
+            montre_resultats_grille("Simpson", nTermes, &grille,
+                                    integraleExacte, Simpson_grille);
+            montre_resultats_grille("Simpson 3/8", nTermes, &grille,
+                                    integraleExacte, Simpson3Sur8_grille);
+            nEvaluationsSansGrille += 3 * (nTermes + 1);
             printf("\n");
         }
+        MESURE_TERMINER(mesure, "methodes sur la grille");
+        printf("Evaluations de exp: %d avec la grille commune, %d sans\n\n",
+               grille.nEvaluations, nEvaluationsSansGrille);
+        grille_liberer(&grille);
+
+        MESURE_DEBUTER(mesureRomberg);
+        montre_Romberg(borneInf, borneSup, integraleExacte, exp);
+        MESURE_TERMINER(mesureRomberg, "Romberg");
 
         printf(
             "Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre "
@@ -196,6 +566,17 @@ Trapeze            30    1.71844092568213    0.009259%
 Simpson            30    1.71828184024268    0.000001%
 Simpson 3/8        30    1.71828185496873    0.000002%
 
+Evaluations de exp: 61 avec la grille commune, 285 sans
+
+Tableau de Romberg (ligne k: trapezes avec 2^k intervalles)
+ 0  1.85914091422952
+ 1  1.75393109246483  1.71886115187659
+ 2  1.72722190455752  1.71831884192175  1.71828268792476
+ 3  1.72051859216430  1.71828415469990  1.71828184221844  1.71828182879453
+ 4  1.71884112857999  1.71828197405189  1.71828182867536  1.71828182846039  1.71828182845908
+ 5  1.71842166031633  1.71828183756177  1.71828182846243  1.71828182845905  1.71828182845905  1.71828182845905
+Romberg            32    1.71828182845905    0.000000%  (33 evaluations)
+
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour quitter.
 o
 
@@ -223,6 +604,17 @@ Trapeze            30    0.63217908742608    0.009259%
 Simpson            30    0.63212056316352    0.000001%
 Simpson 3/8        30    0.63212056858092    0.000002%
 
+Evaluations de exp: 61 avec la grille commune, 285 sans
+
+Tableau de Romberg (ligne k: trapezes avec 2^k intervalles)
+ 0  0.68393972058572
+ 1  0.64523519014918  0.63233368000366
+ 2  0.63540942902769  0.63213417532053  0.63212087500832
+ 3  0.63294341821048  0.63212141460474  0.63212056389036  0.63212055895198
+ 4  0.63232631384450  0.63212061238917  0.63212055890813  0.63212055882905  0.63212055882857
+ 5  0.63217200009407  0.63212056217726  0.63212055882980  0.63212055882856  0.63212055882856  0.63212055882856
+Romberg            32    0.63212055882856    0.000000%  (33 evaluations)
+
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour quitter.
 o
 
@@ -231,7 +623,7 @@ Valeur exacte:    2.35040238728760
 Methode   Intervalles   Valeur approximee       Erreur
 
 Trapeze             6    2.37212517685413    0.924216%
-Simpson             6    2.35056148681103    0.006769%
+Simpson             6    2.35056148681104    0.006769%
 Simpson 3/8         6    2.35075574460899    0.015034%
 
 Trapeze            12    2.35584061635522    0.231374%
@@ -242,7 +634,7 @@ Trapeze            18    2.35281999933237    0.102859%
 Simpson            18    2.35040437457987    0.000085%
 Simpson 3/8        18    2.35040685214215    0.000190%
 
-Trapeze            24    2.35176241645134    0.057864%
+Trapeze            24    2.35176241645135    0.057864%
 Simpson            24    2.35040301648339    0.000027%
 Simpson 3/8        24    2.35040380180961    0.000060%
 
@@ -250,6 +642,18 @@ Trapeze            30    2.35127284221421    0.037034%
 Simpson            30    2.35040264508287    0.000011%
 Simpson 3/8        30    2.35040296702037    0.000025%
 
+Evaluations de exp: 61 avec la grille commune, 285 sans
+
+Tableau de Romberg (ligne k: trapezes avec 2^k intervalles)
+ 0  3.08616126963049
+ 1  2.54308063481524  2.36205375654350
+ 2  2.39916628261400  2.35119483188026  2.35047090356937
+ 3  2.36263133358521  2.35045301724228  2.35040356293308  2.35040249403409
+ 4  2.35346201037478  2.35040556930464  2.35040240610880  2.35040238774651  2.35040238732969
+ 5  2.35116744242449  2.35040258644106  2.35040238758349  2.35040238728944  2.35040238728765  2.35040238728761
+ 6  2.35059366041040  2.35040239973904  2.35040238729223  2.35040238728761  2.35040238728760  2.35040238728760  2.35040238728760
+Romberg            64    2.35040238728760    0.000000%  (65 evaluations)
+
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour quitter.
 o
 
@@ -273,10 +677,22 @@ Trapeze            24    4.26410246529756    0.130174%
 Simpson            24    4.25856467550330    0.000135%
 Simpson 3/8        24    4.25857185810276    0.000304%
 
-Trapeze            30    4.26210711795574    0.083319%
+Trapeze            30    4.26210711795573    0.083319%
 Simpson            30    4.25856127324214    0.000055%
 Simpson 3/8        30    4.25856422074276    0.000125%
 
+Evaluations de exp: 61 avec la grille commune, 285 sans
+
+Tableau de Romberg (ligne k: trapezes avec 2^k intervalles)
+ 0  7.05722884572974
+ 1  5.02861442286487  4.35240961524325
+ 2  4.45633213844770  4.26557137697531  4.25978216109078
+ 3  4.30834732285593  4.25901905099201  4.25858222925979  4.25856318272279
+ 4  4.27102785280971  4.25858802946096  4.25855929469223  4.25855893065147  4.25855891397668
+ 5  4.26167751509322  4.25856073585439  4.25855891628062  4.25855891027409  4.25855891019417  4.25855891019048
+ 6  4.25933864706072  4.25855902438321  4.25855891028514  4.25855891018997  4.25855891018964  4.25855891018964  4.25855891018964
+Romberg            64    4.25855891018964    0.000000%  (65 evaluations)
+
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour quitter.
 n
 
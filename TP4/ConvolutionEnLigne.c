@@ -0,0 +1,690 @@
+/**
+ * Auteur : Nicolas Levasseur
+ *
+ * Ce programme calcule tous les termes de suites definies par une
+ * autoconvolution, comme les nombres de Motzkin de Motzkin_recursif1 dans
+ * TP4A:
+ *     f_0 = premier terme
+ *     f_n = a * f_(n-1) + b * Somme(f_i * f_(n-d-i)), avec i allant de 0 a n-d
+ * (Motzkin: a = 1, b = 1, d = 2; Catalan: a = 0, b = 1, d = 1; grands nombres
+ * de Schroder: a = 1, b = 1, d = 1). Calculer la somme de chaque terme coute
+ * O(N^2) pour les N premiers termes, meme avec un tableau des termes connus.
+ *
+ * La convolution est calculee en ligne par diviser pour regner sur les
+ * indices: une fois les termes de la moitie gauche [l, m) d'un bloc [l, r)
+ * connus, on ajoute d'un coup leurs contributions aux sommes des termes de la
+ * moitie droite [m, r) avec un produit par transformee de Fourier modulo un
+ * premier (NTT), puis on traite la moitie droite. Chaque niveau coute
+ * O(N log N), donc les N termes coutent O(N log^2 N). Les termes sont calcules
+ * modulo trois premiers de la forme c * 2^k + 1, et les restes chinois
+ * reconstruisent les termes plus petits que leur produit (environ 2^86).
+ *
+ * Utilisation : ConvolutionEnLigne [N [motzkin|catalan|schroder]]
+ * Avec N, le programme ecrit les N premiers termes modulo 998244353, un par
+ * ligne. Sans argument, il affiche les premiers termes exacts, verifie les
+ * termes avec la somme directe et compare les temps de calcul.
+ *
+ * Compilation : gcc -O3 -march=native ConvolutionEnLigne.c -o ConvolutionEnLigne
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+/* Nombre de premiers pour les restes chinois */
+#define N_PREMIERS 3
+/* Taille de bloc sous laquelle les contributions sont calculees directement */
+#define SEUIL_NAIF 64
+/* Nombre maximal de niveaux (les premiers ont des racines de l'unite d'ordre
+ * 2^23, et les transformees ont deux fois la taille d'un bloc) */
+#define N_NIVEAUX_MAX 22
+/* Nombre de premiers termes exacts affiches */
+#define N_TERMES_AFFICHES 15
+/* Nombre de termes verifies avec la somme directe */
+#define N_VERIFICATION 4096
+/* Nombre de termes a partir duquel on ne mesure plus la somme directe */
+#define N_DIRECT_MAX 32768
+
+/**
+ * Suite definie par f_0 = premierTerme et
+ * f_n = coefficient * f_(n-1) + coefficientConvolution * Somme(f_i * f_(n-d-i))
+ * ou d = decalage, au moins 1.
+ */
+struct suite {
+    const char* nom;
+    uint32_t premierTerme, coefficient, coefficientConvolution;
+    int decalage;
+};
+
+static const struct suite suites[] = {{"Motzkin", 1, 1, 1, 2},
+                                      {"Catalan", 1, 0, 1, 1},
+                                      {"Schroder", 1, 1, 1, 1}};
+
+/**
+ * Un premier de la NTT, avec les constantes de sa multiplication de
+ * Montgomery (les residus a sont gardes sous la forme a * 2^32 mod p).
+ */
+struct premier {
+    uint32_t p, racine;
+    /* -1 / p mod 2^32 et 2^64 mod p */
+    uint32_t pInverse, r2;
+};
+
+/* Premiers de la forme c * 2^k + 1 (k >= 23), avec 3 comme racine primitive */
+static struct premier premiers[N_PREMIERS] = {
+    {998244353, 3, 0, 0}, {167772161, 3, 0, 0}, {469762049, 3, 0, 0}};
+
+/**
+ * Etat du calcul en ligne pour une suite et un premier. Les termes et les
+ * sommes sont sous forme de Montgomery.
+ */
+struct moteur {
+    const struct premier* premier;
+    /* Nombre de termes demandes et taille des tableaux (puissance de 2) */
+    size_t n, taille;
+    /* Termes f_n et sommes de convolution deja accumulees pour f_n */
+    uint32_t *termes, *sommes;
+    /* racines[m + j] = w^j (et son inverse) pour une racine w d'ordre 2m */
+    uint32_t *racines, *racinesInverses;
+    /* Transformee de f_0, ..., f_(2^k - 1) sur 2^(k+1) points, calculee a sa
+     * premiere utilisation */
+    uint32_t* prefixes[N_NIVEAUX_MAX + 1];
+    /* Espace pour la transformee de la moitie gauche d'un bloc */
+    uint32_t* travail;
+    /* Constantes de la suite sous forme de Montgomery */
+    uint32_t coefficient, coefficientConvolution;
+    int decalage;
+};
+
+/**
+ * Cette fonction multiplie deux residus sous forme de Montgomery.
+ *
+ * a, b : Residus sous forme de Montgomery
+ * premier : Premier et ses constantes
+ *
+ * return : Produit sous forme de Montgomery
+ */
+static inline uint32_t multiplier_Montgomery(const uint32_t a, const uint32_t b,
+                                             const struct premier* premier) {
+    const uint64_t t = (uint64_t)a * b;
+    const uint32_t m = (uint32_t)t * premier->pInverse;
+    const uint32_t u = (uint32_t)((t + (uint64_t)m * premier->p) >> 32);
+    return u >= premier->p ? u - premier->p : u;
+}
+
+/**
+ * Cette fonction additionne deux residus.
+ *
+ * a, b : Residus plus petits que p
+ * p : Premier
+ *
+ * return : a + b mod p
+ */
+static inline uint32_t additionner(const uint32_t a, const uint32_t b,
+                                   const uint32_t p) {
+    return a + b >= p ? a + b - p : a + b;
+}
+
+/**
+ * Cette fonction met un entier sous forme de Montgomery.
+ *
+ * a : Entier
+ * premier : Premier et ses constantes
+ *
+ * return : a * 2^32 mod p
+ */
+uint32_t vers_Montgomery(const uint32_t a, const struct premier* premier) {
+    return multiplier_Montgomery(a % premier->p, premier->r2, premier);
+}
+
+/**
+ * Cette fonction calcule une puissance d'un residu sous forme de Montgomery.
+ *
+ * base : Residu sous forme de Montgomery
+ * exposant : Exposant
+ * premier : Premier et ses constantes
+ *
+ * return : base^exposant sous forme de Montgomery
+ */
+uint32_t puissance_Montgomery(uint32_t base, uint64_t exposant,
+                              const struct premier* premier) {
+    uint32_t resultat = vers_Montgomery(1, premier);
+
+    for (; exposant; exposant >>= 1) {
+        if (exposant & 1)
+            resultat = multiplier_Montgomery(resultat, base, premier);
+        base = multiplier_Montgomery(base, base, premier);
+    }
+
+    return resultat;
+}
+
+/**
+ * Cette fonction calcule les constantes de Montgomery des premiers.
+ */
+void initialiser_premiers(void) {
+    for (int k = 0; k < N_PREMIERS; k++) {
+        const uint32_t p = premiers[k].p;
+        /* Inverse de p modulo 2^32 par la methode de Newton (chaque iteration
+         * double le nombre de bits exacts) */
+        uint32_t inverse = p;
+        for (int i = 0; i < 5; i++) inverse *= 2 - p * inverse;
+        premiers[k].pInverse = -inverse;
+        const uint64_t r = (1ull << 32) % p;
+        premiers[k].r2 = (uint32_t)(r * r % p);
+    }
+}
+
+/**
+ * Cette fonction calcule la transformee d'un tableau en place, par
+ * decimation en frequence: l'entree est dans l'ordre naturel et la sortie
+ * dans l'ordre des indices aux bits inverses, ce qui evite la permutation
+ * puisque le produit point par point ne depend pas de l'ordre.
+ *
+ * a : Residus, remplaces par leur transformee
+ * n : Taille, une puissance de 2
+ * moteur : Premier et racines de l'unite
+ */
+void NTT(uint32_t a[], const size_t n, const struct moteur* moteur) {
+    const struct premier* premier = moteur->premier;
+    const uint32_t p = premier->p;
+
+    for (size_t m = n / 2; m; m /= 2)
+        for (size_t i = 0; i < n; i += 2 * m)
+            for (size_t j = 0; j < m; j++) {
+                const uint32_t u = a[i + j], v = a[i + j + m];
+                a[i + j] = additionner(u, v, p);
+                a[i + j + m] = multiplier_Montgomery(u >= v ? u - v : u + p - v,
+                                                     moteur->racines[m + j],
+                                                     premier);
+            }
+}
+
+/**
+ * Cette fonction calcule la transformee inverse d'un tableau en place, par
+ * decimation en temps a partir de l'ordre des bits inverses. Le resultat
+ * n'est pas divise par n.
+ *
+ * a : Transformee, remplacee par n fois les residus
+ * n : Taille, une puissance de 2
+ * moteur : Premier et racines de l'unite
+ */
+void NTT_inverse(uint32_t a[], const size_t n, const struct moteur* moteur) {
+    const struct premier* premier = moteur->premier;
+    const uint32_t p = premier->p;
+
+    for (size_t m = 1; m < n; m *= 2)
+        for (size_t i = 0; i < n; i += 2 * m)
+            for (size_t j = 0; j < m; j++) {
+                const uint32_t u = a[i + j];
+                const uint32_t v = multiplier_Montgomery(
+                    a[i + j + m], moteur->racinesInverses[m + j], premier);
+                a[i + j] = additionner(u, v, p);
+                a[i + j + m] = u >= v ? u - v : u + p - v;
+            }
+}
+
+/**
+ * Cette fonction trouve la transformee des 2^k premiers termes sur 2^(k+1)
+ * points, en la calculant a sa premiere utilisation. Les termes doivent deja
+ * etre connus.
+ *
+ * moteur : Etat du calcul
+ * k : Logarithme en base 2 du nombre de termes
+ *
+ * return : Transformee des termes
+ */
+const uint32_t* transformee_prefixe(struct moteur* moteur, const int k) {
+    if (!moteur->prefixes[k]) {
+        const size_t s = (size_t)1 << k;
+        uint32_t* transformee = calloc(2 * s, sizeof *transformee);
+        if (!transformee) {
+            printf("Memoire insuffisante\n");
+            exit(1);
+        }
+        memcpy(transformee, moteur->termes, s * sizeof *transformee);
+        NTT(transformee, 2 * s, moteur);
+        moteur->prefixes[k] = transformee;
+    }
+
+    return moteur->prefixes[k];
+}
+
+/**
+ * Cette fonction ajoute aux sommes des termes de [m, r) les produits f_i * f_j
+ * ou i est dans [l, m), directement. Si l = 0, les deux indices sont dans
+ * [0, m); sinon, j est dans [0, r - l), qui est avant l, et chaque produit
+ * compte deux fois (pour f_i * f_j et f_j * f_i).
+ *
+ * moteur : Etat du calcul
+ * l, m, r : Bornes du bloc et de ses moities
+ */
+void contribuer_naif(struct moteur* moteur, const size_t l, const size_t m,
+                     const size_t r) {
+    const struct premier* premier = moteur->premier;
+    const size_t limite = l ? r - l : m;
+    const uint32_t facteur = vers_Montgomery(l ? 2 : 1, premier);
+
+    for (size_t t = m; t < r && t < moteur->n; t++) {
+        /* Somme des produits f_i * f_(t-d-i), sans reduction modulo p (au
+         * plus SEUIL_NAIF termes plus petits que 2^30) */
+        uint64_t somme = 0;
+        for (size_t i = l; i < m && i + moteur->decalage <= t; i++) {
+            const size_t j = t - moteur->decalage - i;
+            if (j < limite)
+                somme += multiplier_Montgomery(moteur->termes[i],
+                                               moteur->termes[j], premier);
+        }
+        moteur->sommes[t] = additionner(
+            moteur->sommes[t],
+            multiplier_Montgomery((uint32_t)(somme % premier->p), facteur,
+                                  premier),
+            premier->p);
+    }
+}
+
+/**
+ * Cette fonction ajoute les memes contributions que contribuer_naif avec un
+ * produit par NTT de taille 2 (r - l). La transformee des termes de [0, r - l)
+ * (ou [0, m) si l = 0) est gardee d'un bloc a l'autre.
+ *
+ * moteur : Etat du calcul
+ * l, m, r : Bornes du bloc et de ses moities
+ */
+void contribuer_NTT(struct moteur* moteur, const size_t l, const size_t m,
+                    const size_t r) {
+    const struct premier* premier = moteur->premier;
+    const size_t s = r - l, taille = 2 * s;
+    uint32_t* produit = moteur->travail;
+
+    if (!l) {
+        /* f[0, m) au carre */
+        const uint32_t* transformee =
+            transformee_prefixe(moteur, __builtin_ctzl(m));
+        for (size_t i = 0; i < s; i++)
+            produit[i] = multiplier_Montgomery(transformee[i], transformee[i],
+                                               premier);
+        NTT_inverse(produit, s, moteur);
+    } else {
+        /* f[l, m) fois f[0, s), compte deux fois */
+        const uint32_t* transformee =
+            transformee_prefixe(moteur, __builtin_ctzl(s));
+        memcpy(produit, moteur->termes + l, (m - l) * sizeof *produit);
+        memset(produit + (m - l), 0, (taille - (m - l)) * sizeof *produit);
+        NTT(produit, taille, moteur);
+        for (size_t i = 0; i < taille; i++)
+            produit[i] = multiplier_Montgomery(produit[i], transformee[i],
+                                               premier);
+        NTT_inverse(produit, taille, moteur);
+    }
+
+    /* Division par la taille de la transformee inverse, s si l = 0 et 2s
+     * (avec le facteur 2) sinon, donc 1 / s dans les deux cas */
+    const uint32_t facteur = puissance_Montgomery(
+        vers_Montgomery((uint32_t)s, premier), premier->p - 2, premier);
+
+    /* Le coefficient k du produit va a la somme du terme l + k + d */
+    for (size_t t = m; t < r && t < moteur->n; t++) {
+        if (t < l + moteur->decalage) continue;
+        const size_t k = t - l - moteur->decalage;
+        moteur->sommes[t] = additionner(
+            moteur->sommes[t],
+            multiplier_Montgomery(produit[k], facteur, premier), premier->p);
+    }
+}
+
+/**
+ * Cette fonction calcule les termes d'indices l a r - 1, quand les termes
+ * precedents sont connus et que leurs contributions aux sommes de [l, r) sont
+ * deja ajoutees. Les blocs sont alignes sur leur taille, une puissance de 2,
+ * donc r - l <= l quand l > 0 et les termes de [0, r - l) sont connus.
+ *
+ * moteur : Etat du calcul
+ * l, r : Bornes du bloc
+ */
+void resoudre(struct moteur* moteur, const size_t l, const size_t r) {
+    if (l >= moteur->n) return;
+
+    if (r - l == 1) {
+        const struct premier* premier = moteur->premier;
+        if (!l)
+            return;
+        moteur->termes[l] = additionner(
+            multiplier_Montgomery(moteur->coefficient, moteur->termes[l - 1],
+                                  premier),
+            multiplier_Montgomery(moteur->coefficientConvolution,
+                                  moteur->sommes[l], premier),
+            premier->p);
+        return;
+    }
+
+    const size_t m = (l + r) / 2;
+    resoudre(moteur, l, m);
+    if (r - l <= SEUIL_NAIF)
+        contribuer_naif(moteur, l, m, r);
+    else
+        contribuer_NTT(moteur, l, m, r);
+    resoudre(moteur, m, r);
+}
+
+/**
+ * Cette fonction calcule les n premiers termes d'une suite modulo un premier
+ * avec la convolution en ligne.
+ *
+ * suite : Suite a calculer
+ * termes : Tableau de n termes a remplir (forme ordinaire)
+ * n : Nombre de termes, au plus 2^N_NIVEAUX_MAX
+ * premier : Premier et ses constantes
+ */
+void calculer_en_ligne(const struct suite* suite, uint32_t termes[],
+                       const size_t n, const struct premier* premier) {
+    struct moteur moteur = {.premier = premier, .n = n, .taille = 1};
+    while (moteur.taille < n) moteur.taille *= 2;
+
+    moteur.termes = calloc(moteur.taille, sizeof *moteur.termes);
+    moteur.sommes = calloc(moteur.taille, sizeof *moteur.sommes);
+    moteur.racines = malloc(2 * moteur.taille * sizeof *moteur.racines);
+    moteur.racinesInverses =
+        malloc(2 * moteur.taille * sizeof *moteur.racinesInverses);
+    moteur.travail = malloc(2 * moteur.taille * sizeof *moteur.travail);
+    if (!moteur.termes || !moteur.sommes || !moteur.racines ||
+        !moteur.racinesInverses || !moteur.travail) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+
+    /* Racines de l'unite pour les transformees jusqu'a 2 * taille points */
+    const uint32_t racine = vers_Montgomery(premier->racine, premier);
+    for (size_t m = 1; m < 2 * moteur.taille; m *= 2) {
+        const uint32_t w =
+            puissance_Montgomery(racine, (premier->p - 1) / (2 * m), premier);
+        const uint32_t wInverse =
+            puissance_Montgomery(w, premier->p - 2, premier);
+        moteur.racines[m] = moteur.racinesInverses[m] =
+            vers_Montgomery(1, premier);
+        for (size_t j = 1; j < m; j++) {
+            moteur.racines[m + j] =
+                multiplier_Montgomery(moteur.racines[m + j - 1], w, premier);
+            moteur.racinesInverses[m + j] = multiplier_Montgomery(
+                moteur.racinesInverses[m + j - 1], wInverse, premier);
+        }
+    }
+
+    moteur.coefficient = vers_Montgomery(suite->coefficient, premier);
+    moteur.coefficientConvolution =
+        vers_Montgomery(suite->coefficientConvolution, premier);
+    moteur.decalage = suite->decalage;
+    moteur.termes[0] = vers_Montgomery(suite->premierTerme, premier);
+
+    resoudre(&moteur, 0, moteur.taille);
+
+    for (size_t i = 0; i < n; i++)
+        termes[i] = multiplier_Montgomery(moteur.termes[i], 1, premier);
+
+    for (int k = 0; k <= N_NIVEAUX_MAX; k++) free(moteur.prefixes[k]);
+    free(moteur.termes);
+    free(moteur.sommes);
+    free(moteur.racines);
+    free(moteur.racinesInverses);
+    free(moteur.travail);
+}
+
+/**
+ * Cette fonction calcule les n premiers termes d'une suite modulo un premier
+ * avec la somme directe de sa definition, en O(n^2).
+ *
+ * suite : Suite a calculer
+ * termes : Tableau de n termes a remplir
+ * n : Nombre de termes
+ * p : Premier
+ */
+void calculer_direct(const struct suite* suite, uint32_t termes[],
+                     const size_t n, const uint32_t p) {
+    termes[0] = suite->premierTerme % p;
+
+    for (size_t t = 1; t < n; t++) {
+        uint64_t somme = 0;
+        for (size_t i = 0; i + suite->decalage <= t; i++)
+            somme = (somme + (uint64_t)termes[i] *
+                                 termes[t - suite->decalage - i]) %
+                    p;
+        termes[t] = (uint32_t)(((uint64_t)suite->coefficient * termes[t - 1] +
+                                suite->coefficientConvolution * somme) %
+                               p);
+    }
+}
+
+/**
+ * Cette fonction reconstruit un entier a partir de ses restes modulo les
+ * premiers (algorithme de Garner).
+ *
+ * restes : Restes modulo chacun des premiers
+ *
+ * return : Entier plus petit que le produit des premiers
+ */
+unsigned __int128 restes_chinois(const uint32_t restes[]) {
+    unsigned __int128 resultat = 0, produit = 1;
+
+    for (int k = 0; k < N_PREMIERS; k++) {
+        const struct premier* premier = &premiers[k];
+        /* On cherche t tel que resultat + produit * t = restes[k] mod p */
+        const uint32_t resultatModulo = (uint32_t)(resultat % premier->p);
+        const uint32_t difference =
+            restes[k] >= resultatModulo
+                ? restes[k] - resultatModulo
+                : restes[k] + premier->p - resultatModulo;
+        /* Inverse du produit modulo p, sous forme de Montgomery */
+        const uint32_t produitModulo = (uint32_t)(produit % premier->p);
+        const uint32_t inverse = puissance_Montgomery(
+            vers_Montgomery(produitModulo, premier), premier->p - 2, premier);
+        const uint32_t t = multiplier_Montgomery(
+            multiplier_Montgomery(vers_Montgomery(difference, premier), inverse,
+                                  premier),
+            1, premier);
+        resultat += produit * t;
+        produit *= premier->p;
+    }
+
+    return resultat;
+}
+
+/**
+ * Cette fonction ecrit un entier de 128 bits en decimal.
+ *
+ * texte : Chaine d'au moins 40 caracteres
+ * x : Entier a ecrire
+ */
+void ecrire_entier(char texte[], unsigned __int128 x) {
+    char chiffres[40];
+    int n = 0;
+
+    do {
+        chiffres[n++] = (char)('0' + (int)(x % 10));
+        x /= 10;
+    } while (x);
+    for (int i = 0; i < n; i++) texte[i] = chiffres[n - 1 - i];
+    texte[n] = '\0';
+}
+
+/**
+ * Cette fonction donne le temps ecoule depuis un instant donne.
+ *
+ * debut : Instant de depart
+ *
+ * return : Temps ecoule en secondes
+ */
+double secondes_depuis(const struct timespec* debut) {
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (fin.tv_sec - debut->tv_sec) + (fin.tv_nsec - debut->tv_nsec) * 1e-9;
+}
+
+/**
+ * Cette fonction calcule les M_n modulo p avec la recurrence lineaire
+ * (n + 2) M_n = (2n + 1) M_(n-1) + (3n - 3) M_(n-2), pour verifier les grands
+ * calculs (n + 2 doit etre plus petit que p).
+ *
+ * termes : Tableau de n termes a remplir
+ * n : Nombre de termes
+ * premier : Premier et ses constantes
+ */
+void Motzkin_lineaire(uint32_t termes[], const size_t n,
+                      const struct premier* premier) {
+    const uint32_t p = premier->p;
+    termes[0] = 1;
+    if (n > 1) termes[1] = 1;
+
+    for (size_t i = 2; i < n; i++) {
+        const uint64_t numerateur =
+            ((2 * i + 1) * termes[i - 1] + (3 * i - 3) * termes[i - 2]) % p;
+        const uint32_t inverse = multiplier_Montgomery(
+            puissance_Montgomery(vers_Montgomery((uint32_t)(i + 2), premier),
+                                 p - 2, premier),
+            1, premier);
+        termes[i] = (uint32_t)(numerateur * inverse % p);
+    }
+}
+
+/**
+ * Cette fonction affiche les premiers termes exacts d'une suite, reconstruits
+ * a partir des termes modulo chacun des premiers.
+ *
+ * suite : Suite a afficher
+ */
+void afficher_exacts(const struct suite* suite) {
+    uint32_t termes[N_PREMIERS][N_TERMES_AFFICHES];
+    for (int k = 0; k < N_PREMIERS; k++)
+        calculer_en_ligne(suite, termes[k], N_TERMES_AFFICHES, &premiers[k]);
+
+    printf("%-9s:", suite->nom);
+    for (int i = 0; i < N_TERMES_AFFICHES; i++) {
+        uint32_t restes[N_PREMIERS];
+        for (int k = 0; k < N_PREMIERS; k++) restes[k] = termes[k][i];
+        char texte[40];
+        ecrire_entier(texte, restes_chinois(restes));
+        printf(" %s", texte);
+    }
+    printf("\n");
+}
+
+/**
+ * Cette fonction mesure le calcul en ligne des N premiers nombres de Motzkin
+ * modulo le premier p0, et celui de la somme directe pour les petits N, et
+ * verifie le dernier terme avec la recurrence lineaire.
+ *
+ * n : Nombre de termes
+ */
+void mesurer(const size_t n) {
+    uint32_t* enLigne = malloc(n * sizeof *enLigne);
+    uint32_t* reference = malloc(n * sizeof *reference);
+    if (!enLigne || !reference) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+    struct timespec debut;
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    calculer_en_ligne(&suites[0], enLigne, n, &premiers[0]);
+    const double tempsEnLigne = secondes_depuis(&debut);
+
+    printf("%8zu %12.4f ", n, tempsEnLigne);
+    if (n <= N_DIRECT_MAX) {
+        clock_gettime(CLOCK_MONOTONIC, &debut);
+        calculer_direct(&suites[0], reference, n, premiers[0].p);
+        printf("%14.4f ", secondes_depuis(&debut));
+    } else
+        printf("%14s ", "-");
+
+    Motzkin_lineaire(reference, n, &premiers[0]);
+    printf("%13u  %s\n", enLigne[n - 1],
+           memcmp(enLigne, reference, n * sizeof *enLigne) ? "different"
+                                                           : "identique");
+
+    free(enLigne);
+    free(reference);
+}
+
+int main(int argc, char* argv[]) {
+    /* Nombre de suites connues */
+    const int nSuites = sizeof suites / sizeof suites[0];
+
+    initialiser_premiers();
+
+    if (argc > 1) {
+        const long n = atol(argv[1]);
+        if (n < 1 || n > 1l << N_NIVEAUX_MAX) {
+            printf("Le nombre de termes doit etre entre 1 et %ld\n",
+                   1l << N_NIVEAUX_MAX);
+            return 1;
+        }
+        int choix = 0;
+        if (argc > 2)
+            for (choix = 0; choix < nSuites; choix++)
+                if (!strcasecmp(argv[2], suites[choix].nom)) break;
+        if (choix == nSuites) {
+            printf("Suite inconnue : %s\n", argv[2]);
+            return 1;
+        }
+
+        uint32_t* termes = malloc(n * sizeof *termes);
+        if (!termes) {
+            printf("Memoire insuffisante\n");
+            return 1;
+        }
+        calculer_en_ligne(&suites[choix], termes, n, &premiers[0]);
+        for (long i = 0; i < n; i++) printf("%ld %u\n", i, termes[i]);
+        free(termes);
+        return 0;
+    }
+
+    printf("Premiers termes exacts (restes chinois modulo %u, %u et %u)\n",
+           premiers[0].p, premiers[1].p, premiers[2].p);
+    for (int i = 0; i < nSuites; i++) afficher_exacts(&suites[i]);
+
+    /* Verification de chaque suite modulo chaque premier */
+    printf("\nVerification des %d premiers termes avec la somme directe :",
+           N_VERIFICATION);
+    uint32_t enLigne[N_VERIFICATION], direct[N_VERIFICATION];
+    for (int i = 0; i < nSuites; i++) {
+        int egal = 1;
+        for (int k = 0; k < N_PREMIERS; k++) {
+            calculer_en_ligne(&suites[i], enLigne, N_VERIFICATION,
+                              &premiers[k]);
+            calculer_direct(&suites[i], direct, N_VERIFICATION, premiers[k].p);
+            egal &= !memcmp(enLigne, direct, sizeof enLigne);
+        }
+        printf(" %s %s%s", suites[i].nom, egal ? "identique" : "different",
+               i + 1 < nSuites ? "," : "\n");
+    }
+
+    printf("\nNombres de Motzkin modulo %u\n", premiers[0].p);
+    printf("       N  En ligne (s)  Direct (s)  M_(N-1) mod p  Recurrence "
+           "lineaire\n");
+    for (size_t n = 1 << 12; n <= 1 << 21; n *= 2) mesurer(n);
+
+    return 0;
+}
+
+/*
+Premiers termes exacts (restes chinois modulo 998244353, 167772161 et 469762049)
+Motzkin  : 1 1 2 4 9 21 51 127 323 835 2188 5798 15511 41835 113634
+Catalan  : 1 1 2 5 14 42 132 429 1430 4862 16796 58786 208012 742900 2674440
+Schroder : 1 2 6 22 90 394 1806 8558 41586 206098 1037718 5293446 27297738 142078746 745387038
+
+Verification des 4096 premiers termes avec la somme directe : Motzkin identique, Catalan identique, Schroder identique
+
+Nombres de Motzkin modulo 998244353
+       N  En ligne (s)  Direct (s)  M_(N-1) mod p  Recurrence lineaire
+    4096       0.0018         0.0556     918958697  identique
+    8192       0.0037         0.2490     882705613  identique
+   16384       0.0112         0.9458     651415951  identique
+   32768       0.0188         3.8225     766751107  identique
+   65536       0.0654              -     948749000  identique
+  131072       0.1452              -     147431664  identique
+  262144       0.3060              -     706157553  identique
+  524288       0.5955              -     452657950  identique
+ 1048576       1.4207              -     135011742  identique
+ 2097152       2.8676              -     327117919  identique
+*/
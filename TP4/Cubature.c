@@ -0,0 +1,701 @@
+/**
+ * Auteur : Nicolas Levasseur
+ *
+ * Ce programme calcule des integrales en plusieurs dimensions (de 3 a 20) sur
+ * des boites, ce que les methodes a une dimension de TP3B et de TP4C ne font
+ * pas. Il compare les grilles creuses de Smolyak, construites a partir des
+ * methodes du point milieu et de Simpson, a la methode de quasi-Monte Carlo
+ * avec des suites de Sobol brouillees et a la methode de Monte Carlo
+ * ordinaire. Pour ces deux dernieres, l'erreur est estimee par l'ecart entre
+ * plusieurs repliques independantes, qui sont reparties entre plusieurs fils
+ * d'execution, et on double le nombre d'echantillons seulement tant que
+ * l'erreur estimee depasse la tolerance.
+ *
+ * Compilation : gcc -O2 Cubature.c -o Cubature -lm -pthread
+ */
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+
+/* Nombre maximal de dimensions */
+#define DIMENSION_MAX 20
+/* Nombre de bits des coordonnees des points de Sobol */
+#define N_BITS 32
+/* Nombre de repliques independantes (brouillages ou suites aleatoires) pour
+ * estimer l'erreur */
+#define N_REPLIQUES 8
+/* Nombre d'echantillons par replique au depart, puis maximal */
+#define N_ECHANTILLONS_INITIAL 256u
+#define N_ECHANTILLONS_MAX (1u << 18)
+/* Niveau maximal des grilles de Smolyak */
+#define NIVEAU_SMOLYAK_MAX 6
+/* Nombre maximal de noeuds d'une methode a une dimension (Simpson au niveau
+ * maximal) */
+#define N_NOEUDS_1D ((1 << (NIVEAU_SMOLYAK_MAX - 1)) + 1)
+/* Erreur relative visee */
+#define TOLERANCE 1e-4
+/* Nombre maximal de fils d'execution */
+#define N_FILS_MAX 64
+
+/* Polynomes primitifs et nombres directeurs initiaux des suites de Sobol
+ * pour les dimensions 2 a 20 (Joe et Kuo). Le polynome de degre s est
+ * x^s + a_1 x^(s - 1) + ... + a_(s - 1) x + 1, ou les a_i sont les bits de
+ * coefficients, du plus significatif au moins significatif. La dimension 1
+ * est la suite de van der Corput. */
+const int degres[DIMENSION_MAX] = {0, 1, 2, 3, 3, 4, 4, 5, 5, 5,
+                                   5, 5, 5, 6, 6, 6, 6, 6, 6, 7};
+const int coefficients[DIMENSION_MAX] = {0,  0,  1,  1,  2,  1,  4,
+                                         2,  4,  7,  11, 13, 14, 1,
+                                         13, 16, 19, 22, 25, 1};
+const uint32_t directeursInitiaux[DIMENSION_MAX][7] = {
+    {0},
+    {1},
+    {1, 3},
+    {1, 3, 1},
+    {1, 1, 1},
+    {1, 1, 3, 3},
+    {1, 3, 5, 13},
+    {1, 1, 5, 5, 17},
+    {1, 1, 5, 5, 5},
+    {1, 1, 7, 11, 19},
+    {1, 1, 5, 1, 1},
+    {1, 1, 1, 3, 11},
+    {1, 3, 5, 5, 31},
+    {1, 3, 3, 9, 7, 49},
+    {1, 1, 1, 15, 21, 21},
+    {1, 3, 1, 13, 27, 49},
+    {1, 1, 1, 15, 7, 5},
+    {1, 3, 1, 15, 13, 25},
+    {1, 1, 5, 5, 19, 61},
+    {1, 3, 7, 11, 23, 15, 103}};
+
+/**
+ * Integrale a calculer: fonction de dimension variables, bornes de la boite
+ * et methode d'echantillonnage (1 pour Sobol brouille, 0 pour Monte Carlo).
+ */
+struct cubature {
+    double (*fonction)(const double x[], int dimension);
+    int dimension;
+    const double* borneInf;
+    const double* borneSup;
+    int sobol;
+};
+
+/**
+ * Replique d'une methode d'echantillonnage: nombres directeurs brouilles de
+ * chaque dimension, point courant de la suite (en entiers de N_BITS bits),
+ * etat du generateur aleatoire, nombre de points deja utilises et somme des
+ * valeurs de la fonction a ces points.
+ */
+struct replique {
+    uint32_t directeurs[DIMENSION_MAX][N_BITS];
+    uint32_t point[DIMENSION_MAX];
+    uint64_t etat;
+    unsigned nPoints;
+    double somme;
+};
+
+/**
+ * Travail d'un fil d'execution: il prolonge les repliques iPremier,
+ * iPremier + pas, ... jusqu'a nPoints points.
+ */
+struct travail {
+    const struct cubature* probleme;
+    struct replique* repliques;
+    unsigned nPoints;
+    int iPremier, pas;
+};
+
+/**
+ * Toutes les fonctions commencant par le suffixe "integrale_" ci-apres ont
+ * pour but de donner la valeur exacte de l'integrale de la fonction de meme
+ * nom sur une boite: exponentielle -> exp(x_1 + ... + x_d), cosinus ->
+ * cos(x_1) * ... * cos(x_d) et coin -> 1 / (1 + x_1 + ... + x_d)^(d + 1), le
+ * pic de coin de Genz, qui n'est pas un produit de fonctions d'une variable.
+ *
+ * x : Point ou evaluer la fonction.
+ * dimension : Nombre de variables.
+ * borneInf : Bornes inferieures de la boite.
+ * borneSup : Bornes superieures de la boite.
+ */
+double exponentielle(const double x[], const int dimension) {
+    double somme = 0;
+    for (int i = 0; i < dimension; i++) somme += x[i];
+    return exp(somme);
+}
+
+double integrale_exponentielle(const double borneInf[],
+                               const double borneSup[], const int dimension) {
+    double produit = 1;
+    for (int i = 0; i < dimension; i++)
+        produit *= exp(borneSup[i]) - exp(borneInf[i]);
+    return produit;
+}
+
+double cosinus(const double x[], const int dimension) {
+    double produit = 1;
+    for (int i = 0; i < dimension; i++) produit *= cos(x[i]);
+    return produit;
+}
+
+double integrale_cosinus(const double borneInf[], const double borneSup[],
+                         const int dimension) {
+    double produit = 1;
+    for (int i = 0; i < dimension; i++)
+        produit *= sin(borneSup[i]) - sin(borneInf[i]);
+    return produit;
+}
+
+double coin(const double x[], const int dimension) {
+    double somme = 1;
+    for (int i = 0; i < dimension; i++) somme += x[i];
+    return pow(somme, -(dimension + 1));
+}
+
+double integrale_coin(const double borneInf[], const double borneSup[],
+                      const int dimension) {
+    /* Une primitive d'ordre d de (1 + s)^-(d + 1) est (-1)^d / (d! (1 + s)),
+     * qu'on combine sur les 2^d sommets de la boite */
+    double factorielle = 1, somme = 0;
+    for (int i = 2; i <= dimension; i++) factorielle *= i;
+
+    for (unsigned long sommet = 0; sommet < 1ul << dimension; sommet++) {
+        double coordonnees = 1;
+        int nInferieures = 0;
+        for (int i = 0; i < dimension; i++) {
+            if (sommet >> i & 1) {
+                coordonnees += borneSup[i];
+            } else {
+                coordonnees += borneInf[i];
+                nInferieures++;
+            }
+        }
+        somme += (nInferieures % 2 ? -1 : 1) / coordonnees;
+    }
+
+    return (dimension % 2 ? -1 : 1) * somme / factorielle;
+}
+
+/**
+ * Cette fonction donne le nombre aleatoire suivant du generateur splitmix64.
+ *
+ * etat : Etat du generateur, qu'on fait avancer.
+ *
+ * return : 64 bits aleatoires.
+ */
+uint64_t aleatoire(uint64_t* etat) {
+    uint64_t z = (*etat += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Cette fonction trouve la parite d'un entier (le ou exclusif de ses bits).
+ *
+ * n : Entier.
+ *
+ * return : 1 si n a un nombre impair de bits a 1, 0 sinon.
+ */
+uint32_t parite(uint32_t n) {
+    for (int decalage = 16; decalage; decalage /= 2) n ^= n >> decalage;
+    return n & 1;
+}
+
+/**
+ * Cette fonction trouve le nombre de zeros a la fin d'un entier non nul.
+ *
+ * n : Entier non nul.
+ *
+ * return : Indice du bit a 1 le moins significatif.
+ */
+int zeros_finaux(unsigned n) {
+    int zeros = 0;
+    for (; !(n & 1); n >>= 1) zeros++;
+    return zeros;
+}
+
+/**
+ * Cette fonction prepare une replique: pour Sobol, elle calcule les nombres
+ * directeurs de chaque dimension par la recurrence du polynome primitif, les
+ * brouille par une matrice triangulaire inferieure aleatoire (brouillage
+ * lineaire de Matousek) et choisit un decalage aleatoire, qui est le premier
+ * point. Pour Monte Carlo, seul le generateur est initialise.
+ *
+ * replique : Replique a preparer.
+ * dimension : Nombre de dimensions.
+ * graine : Graine du generateur aleatoire de la replique.
+ */
+void initialiser_replique(struct replique* replique, const int dimension,
+                          const uint64_t graine) {
+    replique->etat = graine;
+    replique->nPoints = 0;
+    replique->somme = 0;
+
+    for (int j = 0; j < dimension; j++) {
+        const int s = degres[j];
+        uint32_t directeurs[N_BITS];
+
+        for (int k = 0; k < N_BITS; k++) {
+            if (!j)
+                directeurs[k] = 1u << (N_BITS - 1 - k);
+            else if (k < s)
+                directeurs[k] = directeursInitiaux[j][k]
+                                << (N_BITS - 1 - k);
+            else {
+                directeurs[k] = directeurs[k - s] ^ (directeurs[k - s] >> s);
+                for (int i = 1; i < s; i++)
+                    if (coefficients[j] >> (s - 1 - i) & 1)
+                        directeurs[k] ^= directeurs[k - i];
+            }
+        }
+
+        /* Lignes de la matrice de brouillage: le bit de la ligne r est
+         * la parite de la ligne et des bits plus significatifs */
+        uint32_t lignes[N_BITS];
+        for (int r = 0; r < N_BITS; r++)
+            lignes[r] = (r ? (uint32_t)aleatoire(&replique->etat) &
+                                 (0xFFFFFFFFu << (N_BITS - r))
+                           : 0) |
+                        1u << (N_BITS - 1 - r);
+
+        for (int k = 0; k < N_BITS; k++) {
+            uint32_t brouille = 0;
+            for (int r = 0; r < N_BITS; r++)
+                brouille |= parite(lignes[r] & directeurs[k])
+                            << (N_BITS - 1 - r);
+            replique->directeurs[j][k] = brouille;
+        }
+        replique->point[j] = (uint32_t)aleatoire(&replique->etat);
+    }
+}
+
+/**
+ * Cette fonction ajoute des points a une replique jusqu'a en avoir nPoints et
+ * ajoute les valeurs de la fonction a sa somme. Les points de Sobol sont
+ * generes dans l'ordre du code de Gray: on passe du point i au point i + 1
+ * en changeant une seule colonne de la matrice, donc la suite reprend la ou
+ * elle s'etait arretee.
+ *
+ * replique : Replique a prolonger.
+ * probleme : Integrale a calculer.
+ * nPoints : Nombre de points voulu.
+ */
+void prolonger_replique(struct replique* replique,
+                        const struct cubature* probleme,
+                        const unsigned nPoints) {
+    const int d = probleme->dimension;
+    double x[DIMENSION_MAX];
+
+    for (unsigned i = replique->nPoints; i < nPoints; i++) {
+        /* Colonne qui change entre le point i et le point i + 1 */
+        const int colonne = zeros_finaux(i + 1);
+        for (int j = 0; j < d; j++) {
+            /* Coordonnee dans [0, 1), puis dans la boite */
+            const double u =
+                probleme->sobol
+                    ? (replique->point[j] + 0.5) * ldexp(1, -N_BITS)
+                    : (aleatoire(&replique->etat) >> 11) * ldexp(1, -53);
+            x[j] = probleme->borneInf[j] +
+                   (probleme->borneSup[j] - probleme->borneInf[j]) * u;
+            if (probleme->sobol)
+                replique->point[j] ^= replique->directeurs[j][colonne];
+        }
+        replique->somme += probleme->fonction(x, d);
+    }
+    replique->nPoints = nPoints;
+}
+
+/**
+ * Cette fonction est executee par chaque fil d'execution.
+ *
+ * argument : Pointeur vers la struct travail du fil
+ *
+ * return : NULL
+ */
+void* executer_travail(void* argument) {
+    const struct travail* travail = argument;
+
+    for (int r = travail->iPremier; r < N_REPLIQUES; r += travail->pas)
+        prolonger_replique(&travail->repliques[r], travail->probleme,
+                           travail->nPoints);
+
+    return NULL;
+}
+
+/**
+ * On trouve la valeur d'une integrale sur une boite par la methode de
+ * quasi-Monte Carlo (suites de Sobol brouillees) ou de Monte Carlo. Chaque
+ * replique donne une estimation independante; la moyenne est le resultat et
+ * l'ecart type de la moyenne est l'erreur estimee. On double le nombre de
+ * points de chaque replique, en gardant les points deja utilises, jusqu'a ce
+ * que l'erreur estimee soit sous la tolerance relative. Les repliques sont
+ * reparties entre les fils d'execution et chacune est sommee dans le meme
+ * ordre, donc le resultat ne depend pas du nombre de fils.
+ *
+ * probleme : Integrale a calculer.
+ * tolerance : Erreur relative visee.
+ * nFils : Nombre de fils d'execution a utiliser.
+ * nEvaluations : Pointeur ou on ecrit le nombre d'appels a la fonction.
+ * erreur : Pointeur ou on ecrit l'erreur estimee.
+ * converge : Pointeur ou on ecrit 0 si on s'est arrete a N_ECHANTILLONS_MAX
+ * sans atteindre la tolerance, 1 sinon.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double echantillonnage(const struct cubature* probleme, const double tolerance,
+                       int nFils, long* nEvaluations, double* erreur,
+                       int* converge) {
+    static struct replique repliques[N_REPLIQUES];
+    pthread_t fils[N_FILS_MAX];
+    struct travail travaux[N_FILS_MAX];
+    int lance[N_FILS_MAX] = {0};
+
+    /* Volume de la boite */
+    double volume = 1;
+    for (int j = 0; j < probleme->dimension; j++)
+        volume *= probleme->borneSup[j] - probleme->borneInf[j];
+
+    for (int r = 0; r < N_REPLIQUES; r++)
+        initialiser_replique(&repliques[r], probleme->dimension, r + 1);
+
+    if (nFils > N_FILS_MAX) nFils = N_FILS_MAX;
+    if (nFils > N_REPLIQUES) nFils = N_REPLIQUES;
+    if (nFils < 1) nFils = 1;
+
+    double moyenne;
+    for (unsigned nPoints = N_ECHANTILLONS_INITIAL;; nPoints *= 2) {
+        for (int i = 0; i < nFils; i++) {
+            travaux[i] =
+                (struct travail){probleme, repliques, nPoints, i, nFils};
+            /* Si le fil ne peut pas etre cree, on fait son travail ici */
+            if (i)
+                lance[i] = !pthread_create(&fils[i], NULL, executer_travail,
+                                           &travaux[i]);
+            if (i && !lance[i]) executer_travail(&travaux[i]);
+        }
+        executer_travail(&travaux[0]);
+        for (int i = 1; i < nFils; i++)
+            if (lance[i]) pthread_join(fils[i], NULL);
+
+        /* Moyenne et variance des estimations des repliques */
+        double estimations[N_REPLIQUES], variance = 0;
+        moyenne = 0;
+        for (int r = 0; r < N_REPLIQUES; r++) {
+            estimations[r] = volume * repliques[r].somme / nPoints;
+            moyenne += estimations[r] / N_REPLIQUES;
+        }
+        for (int r = 0; r < N_REPLIQUES; r++)
+            variance += (estimations[r] - moyenne) * (estimations[r] - moyenne);
+        *erreur = sqrt(variance / (N_REPLIQUES * (N_REPLIQUES - 1)));
+        *nEvaluations = (long)N_REPLIQUES * nPoints;
+
+        *converge = *erreur <= tolerance * fabs(moyenne);
+        if (*converge || nPoints >= N_ECHANTILLONS_MAX) break;
+    }
+
+    return moyenne;
+}
+
+/**
+ * Cette fonction trouve la methode a une dimension d'un niveau des grilles de
+ * Smolyak sur [0, 1]: le point milieu au niveau 1, puis la methode de
+ * Simpson avec 2^(niveau - 1) intervalles. Les noeuds d'un niveau contiennent
+ * ceux des niveaux precedents.
+ *
+ * niveau : Niveau de la methode, entre 1 et NIVEAU_SMOLYAK_MAX.
+ * noeuds : Tableau ou on ecrit les noeuds.
+ * poids : Tableau ou on ecrit les poids.
+ *
+ * return : Nombre de noeuds.
+ */
+int methode_1D(const int niveau, double noeuds[], double poids[]) {
+    if (niveau == 1) {
+        noeuds[0] = 0.5;
+        poids[0] = 1;
+        return 1;
+    }
+
+    const int nIntervalles = 1 << (niveau - 1);
+    for (int i = 0; i <= nIntervalles; i++) {
+        noeuds[i] = (double)i / nIntervalles;
+        poids[i] = (i == 0 || i == nIntervalles ? 1 : i % 2 ? 4 : 2) /
+                   (3.0 * nIntervalles);
+    }
+    return nIntervalles + 1;
+}
+
+/**
+ * Cette fonction applique le produit tensoriel des methodes a une dimension
+ * de certains niveaux (un niveau par dimension) en parcourant tous les
+ * noeuds de la grille comme un compteur.
+ *
+ * probleme : Integrale a calculer.
+ * niveaux : Niveau de la methode dans chaque dimension.
+ * nEvaluations : Compteur d'appels a la fonction, qu'on augmente.
+ *
+ * return : La somme ponderee sur la grille, sur [0, 1]^d ramene a la boite.
+ */
+double produit_tensoriel(const struct cubature* probleme, const int niveaux[],
+                         long* nEvaluations) {
+    static double noeuds[NIVEAU_SMOLYAK_MAX + 1][N_NOEUDS_1D];
+    static double poids[NIVEAU_SMOLYAK_MAX + 1][N_NOEUDS_1D];
+    static int nNoeuds[NIVEAU_SMOLYAK_MAX + 1];
+    const int d = probleme->dimension;
+    int indices[DIMENSION_MAX] = {0};
+    double x[DIMENSION_MAX], somme = 0;
+
+    if (!nNoeuds[1])
+        for (int niveau = 1; niveau <= NIVEAU_SMOLYAK_MAX; niveau++)
+            nNoeuds[niveau] =
+                methode_1D(niveau, noeuds[niveau], poids[niveau]);
+
+    for (;;) {
+        double produit = 1;
+        for (int j = 0; j < d; j++) {
+            x[j] = probleme->borneInf[j] +
+                   (probleme->borneSup[j] - probleme->borneInf[j]) *
+                       noeuds[niveaux[j]][indices[j]];
+            produit *= poids[niveaux[j]][indices[j]];
+        }
+        somme += produit * probleme->fonction(x, d);
+        (*nEvaluations)++;
+
+        /* Noeud suivant */
+        int j = 0;
+        while (j < d && ++indices[j] == nNoeuds[niveaux[j]]) indices[j++] = 0;
+        if (j == d) break;
+    }
+
+    return somme;
+}
+
+/**
+ * Cette fonction fait la somme de la formule de combinaison de Smolyak sur
+ * tous les niveaux des dimensions k a d - 1, les niveaux des dimensions
+ * precedentes etant fixes. Le produit tensoriel de niveaux l_1, ..., l_d, dont
+ * l'exces est e = (l_1 - 1) + ... + (l_d - 1), est utilise si
+ * niveau - d <= e <= niveau - 1, avec le coefficient
+ * (-1)^(niveau - 1 - e) * C(d - 1, niveau - 1 - e).
+ *
+ * probleme : Integrale a calculer.
+ * niveau : Niveau de la grille creuse.
+ * niveaux : Niveaux de chaque dimension, fixes jusqu'a k - 1.
+ * k : Premiere dimension dont on choisit le niveau.
+ * exces : Exces des dimensions 0 a k - 1.
+ * nEvaluations : Compteur d'appels a la fonction, qu'on augmente.
+ *
+ * return : La somme ponderee des produits tensoriels.
+ */
+double somme_Smolyak(const struct cubature* probleme, const int niveau,
+                     int niveaux[], const int k, const int exces,
+                     long* nEvaluations) {
+    const int d = probleme->dimension;
+
+    if (k == d) {
+        const int reste = niveau - 1 - exces;
+        if (reste > d - 1) return 0;
+
+        /* Coefficient binomial C(d - 1, reste) */
+        double binomial = 1;
+        for (int i = 1; i <= reste; i++) binomial = binomial * (d - i) / i;
+        return (reste % 2 ? -binomial : binomial) *
+               produit_tensoriel(probleme, niveaux, nEvaluations);
+    }
+
+    double somme = 0;
+    for (int l = 1; exces + l - 1 <= niveau - 1; l++) {
+        niveaux[k] = l;
+        somme += somme_Smolyak(probleme, niveau, niveaux, k + 1,
+                               exces + l - 1, nEvaluations);
+    }
+    return somme;
+}
+
+/**
+ * On trouve la valeur d'une integrale sur une boite par les grilles creuses
+ * de Smolyak: on monte de niveau jusqu'a ce que l'ecart avec le niveau
+ * precedent soit sous la tolerance relative.
+ *
+ * probleme : Integrale a calculer.
+ * tolerance : Erreur relative visee.
+ * nEvaluations : Pointeur ou on ecrit le nombre total d'appels a la fonction.
+ * erreur : Pointeur ou on ecrit l'ecart avec le niveau precedent.
+ * niveauAtteint : Pointeur ou on ecrit le dernier niveau calcule.
+ * converge : Pointeur ou on ecrit 0 si on s'est arrete a NIVEAU_SMOLYAK_MAX
+ * sans atteindre la tolerance, 1 sinon.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double Smolyak(const struct cubature* probleme, const double tolerance,
+               long* nEvaluations, double* erreur, int* niveauAtteint,
+               int* converge) {
+    int niveaux[DIMENSION_MAX];
+    double precedente = NAN, courante = NAN;
+
+    /* Volume de la boite */
+    double volume = 1;
+    for (int j = 0; j < probleme->dimension; j++)
+        volume *= probleme->borneSup[j] - probleme->borneInf[j];
+
+    *nEvaluations = 0;
+    *erreur = INFINITY;
+    *converge = 0;
+    for (int niveau = 1; niveau <= NIVEAU_SMOLYAK_MAX; niveau++) {
+        courante = volume * somme_Smolyak(probleme, niveau, niveaux, 0, 0,
+                                          nEvaluations);
+        *niveauAtteint = niveau;
+        if (niveau > 1) {
+            *erreur = fabs(courante - precedente);
+            *converge = *erreur <= tolerance * fabs(courante);
+            if (*converge) break;
+        }
+        precedente = courante;
+    }
+
+    return courante;
+}
+
+/**
+ * Cette fonction montre le resultat d'une methode de cubature.
+ *
+ * nom : Nom de la methode.
+ * nEvaluations : Nombre d'appels a la fonction.
+ * integraleApprox : Valeur de l'integrale approximee.
+ * erreurEstimee : Erreur estimee par la methode.
+ * integraleExacte : Valeur de l'integrale exacte.
+ * converge : 0 si la methode s'est arretee a sa limite sans atteindre la
+ * tolerance, ce qu'on marque d'une etoile.
+ */
+void afficher(const char nom[], const long nEvaluations,
+              const double integraleApprox, const double erreurEstimee,
+              const double integraleExacte, const int converge) {
+    printf("  %-16s %11ld %20.12e %12.3e %12.3e%s\n", nom, nEvaluations,
+           integraleApprox, erreurEstimee,
+           fabs(integraleApprox - integraleExacte), converge ? "" : " *");
+}
+
+/**
+ * Cette fonction compare les trois methodes pour une fonction et une
+ * dimension sur la boite [0, 1]^d.
+ *
+ * fonction : Fonction a integrer.
+ * integrale_exacte : Fonction pour calculer l'integrale exacte.
+ * dimension : Nombre de variables.
+ * nFils : Nombre de fils d'execution.
+ * nom : Nom de la fonction.
+ */
+void comparer(double (*fonction)(const double[], int),
+              double (*integrale_exacte)(const double[], const double[], int),
+              const int dimension, const int nFils, const char nom[]) {
+    double borneInf[DIMENSION_MAX], borneSup[DIMENSION_MAX];
+    for (int j = 0; j < dimension; j++) {
+        borneInf[j] = 0;
+        borneSup[j] = 1;
+    }
+    struct cubature probleme = {fonction, dimension, borneInf, borneSup, 1};
+    const double integraleExacte =
+        integrale_exacte(borneInf, borneSup, dimension);
+
+    long nEvaluations;
+    double erreur, valeur;
+    int niveau, converge;
+
+    printf("%s, dimension %d: %.12e\n", nom, dimension, integraleExacte);
+
+    valeur = Smolyak(&probleme, TOLERANCE, &nEvaluations, &erreur, &niveau,
+                     &converge);
+    char nomSmolyak[32];
+    snprintf(nomSmolyak, sizeof nomSmolyak, "Smolyak (niv. %d)", niveau);
+    afficher(nomSmolyak, nEvaluations, valeur, erreur, integraleExacte,
+             converge);
+
+    valeur = echantillonnage(&probleme, TOLERANCE, nFils, &nEvaluations,
+                             &erreur, &converge);
+    afficher("Sobol brouille", nEvaluations, valeur, erreur, integraleExacte,
+             converge);
+
+    probleme.sobol = 0;
+    valeur = echantillonnage(&probleme, TOLERANCE, nFils, &nEvaluations,
+                             &erreur, &converge);
+    afficher("Monte Carlo", nEvaluations, valeur, erreur, integraleExacte,
+             converge);
+}
+
+int main() {
+    /* Dimensions essayees */
+    const int dimensions[] = {3, 5, 10, 20};
+    /* Nombre de fils d'execution */
+    const int nFils = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    printf("Tolerance relative: %.0e (* : non atteinte a la limite de la "
+           "methode)\n",
+           TOLERANCE);
+    printf("  Methode          Evaluations    Valeur approximee  Err. estimee"
+           "   Err. reelle\n");
+    for (int i = 0; i < 4; i++) {
+        comparer(exponentielle, integrale_exponentielle, dimensions[i], nFils,
+                 "exp(x_1 + ... + x_d)");
+        comparer(cosinus, integrale_cosinus, dimensions[i], nFils,
+                 "cos(x_1) ... cos(x_d)");
+        comparer(coin, integrale_coin, dimensions[i], nFils,
+                 "1 / (1 + x_1 + ... + x_d)^(d + 1)");
+    }
+
+    return 0;
+}
+
+/*
+Tolerance relative: 1e-04 (* : non atteinte a la limite de la methode)
+  Methode          Evaluations    Valeur approximee  Err. estimee   Err. reelle
+exp(x_1 + ... + x_d), dimension 3: 5.073214111773e+00
+  Smolyak (niv. 4)         258   5.073265583264e+00    3.141e-04    5.147e-05
+  Sobol brouille          4096   5.073080433834e+00    3.229e-04    1.337e-04
+  Monte Carlo          2097152   5.076623322105e+00    1.146e-03    3.409e-03 *
+cos(x_1) ... cos(x_d), dimension 3: 5.958232365910e-01
+  Smolyak (niv. 4)         258   5.958233388479e-01    3.248e-05    1.023e-07
+  Sobol brouille          2048   5.958063333865e-01    2.232e-05    1.690e-05
+  Monte Carlo          2097152   5.955794673318e-01    8.913e-05    2.438e-04 *
+1 / (1 + x_1 + ... + x_d)^(d + 1), dimension 3: 4.166666666667e-02
+  Smolyak (niv. 6)        2577   4.163810602467e-02    9.168e-05    2.856e-05 *
+  Sobol brouille         32768   4.166808953998e-02    3.789e-06    1.423e-06
+  Monte Carlo          2097152   4.160531323712e-02    3.590e-05    6.135e-05 *
+exp(x_1 + ... + x_d), dimension 5: 1.497862632172e+01
+  Smolyak (niv. 5)        4270   1.497866228168e+01    3.035e-04    3.596e-05
+  Sobol brouille         16384   1.497899394810e+01    6.533e-04    3.676e-04
+  Monte Carlo          2097152   1.498890407425e+01    9.368e-03    1.028e-02 *
+cos(x_1) ... cos(x_d), dimension 5: 4.218865958198e-01
+  Smolyak (niv. 5)        4270   4.218866173360e-01    4.553e-06    2.152e-08
+  Sobol brouille          4096   4.218961264441e-01    2.981e-05    9.531e-06
+  Monte Carlo          2097152   4.216172025643e-01    1.229e-04    2.694e-04 *
+1 / (1 + x_1 + ... + x_d)^(d + 1), dimension 5: 1.388888888889e-03
+  Smolyak (niv. 6)       17353   1.426500908135e-03    1.134e-06    3.761e-05 *
+  Sobol brouille       2097152   1.388805466269e-03    7.603e-08    8.342e-08
+  Monte Carlo          2097152   1.388783727515e-03    1.757e-06    1.052e-07 *
+exp(x_1 + ... + x_d), dimension 10: 2.243592464857e+02
+  Smolyak (niv. 6)      329652   2.243596033181e+02    5.162e-04    3.568e-04
+  Sobol brouille        262144   2.243663935800e+02    1.346e-02    7.147e-03
+  Monte Carlo          2097152   2.242971027151e+02    2.043e-01    6.214e-02 *
+cos(x_1) ... cos(x_d), dimension 10: 1.779882997324e-01
+  Smolyak (niv. 6)      329652   1.779881543917e-01    5.186e-06    1.453e-07
+  Sobol brouille         16384   1.779688996699e-01    1.122e-05    1.940e-05
+  Monte Carlo          2097152   1.779819876810e-01    7.004e-05    6.312e-06 *
+1 / (1 + x_1 + ... + x_d)^(d + 1), dimension 10: 2.505210838544e-08
+  Smolyak (niv. 6)      329652   2.345226633199e-08    2.649e-09    1.600e-09 *
+  Sobol brouille       2097152   2.530296479308e-08    6.083e-10    2.509e-10 *
+  Monte Carlo          2097152   2.446202361060e-08    1.610e-10    5.901e-10 *
+exp(x_1 + ... + x_d), dimension 20: 5.033707148365e+04
+  Smolyak (niv. 6)     8195348   5.033452128661e+04    3.380e+01    2.550e+00 *
+  Sobol brouille       2097152   5.032140865665e+04    1.484e+01    1.566e+01 *
+  Monte Carlo          2097152   5.028055145959e+04    8.420e+01    5.652e+01 *
+cos(x_1) ... cos(x_d), dimension 20: 3.167983484163e-02
+  Smolyak (niv. 6)     8195348   3.167073271745e-02    1.055e-04    9.102e-06 *
+  Sobol brouille        262144   3.168319300293e-02    2.213e-06    3.358e-06
+  Monte Carlo          2097152   3.169025738462e-02    2.331e-05    1.042e-05 *
+1 / (1 + x_1 + ... + x_d)^(d + 1), dimension 20: 1.957294106330e-20
+  Smolyak (niv. 6)     8195348   7.141426989336e-21    2.202e-21    1.243e-20 *
+  Sobol brouille       2097152   3.134055659515e-20    1.299e-20    1.177e-20 *
+  Monte Carlo          2097152   1.786961311001e-20    4.096e-21    1.703e-21 *
+*/
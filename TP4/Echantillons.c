@@ -0,0 +1,581 @@
+/**
+ * Auteur : Nicolas Levasseur
+ *
+ * Ce programme integre un signal echantillonne sur une grille uniforme, au
+ * lieu d'une fonction connue comme dans TP3B et TP4C, avec les memes methodes
+ * de Newton-Cotes fermees (trapezes, Simpson, Simpson 3/8 et Newton-Cotes a 10
+ * points). Les echantillons sont lus dans un fichier binaire de doubles (dans
+ * l'ordre des octets de la machine) qui peut etre plus grand que la memoire:
+ * on le parcourt sequentiellement par fenetres, soit par projection en memoire
+ * (mmap) en rendant au systeme les pages deja lues, soit par flux (pread) dans
+ * un tampon de taille fixe. Le fichier est coupe en morceaux independants,
+ * repartis entre plusieurs fils d'execution.
+ *
+ * Lorsque le nombre d'intervalles n'est pas un multiple du nombre
+ * d'intervalles d'un panneau, les intervalles qui restent a la fin sont
+ * integres avec le polynome qui interpole les ordre + 1 derniers echantillons,
+ * ce qui ne change pas l'ordre de convergence de la methode.
+ *
+ * Utilisation : Echantillons [--flux] fichier pas [fils]
+ * Sans fichier, le programme ecrit des echantillons de exp entre 0 et 1 dans
+ * des fichiers temporaires et compare les methodes a l'integrale exacte.
+ *
+ * Compilation : gcc -O3 -march=native Echantillons.c -o Echantillons -lm -pthread
+ */
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Plus grand nombre d'intervalles par panneau (Newton-Cotes a 10 points) */
+#define ORDRE_MAX 9
+/* Plus petit commun multiple de 1, 2, ..., ORDRE_MAX + 1 */
+#define DENOMINATEUR_INTEGRALE 2520
+/* Nombre d'echantillons cumules d'un coup, arrondi au multiple de l'ordre */
+#define TAILLE_BLOC 256
+/* Nombre d'echantillons lus d'un coup par un fil d'execution (4 Mo) */
+#define TAILLE_FENETRE (1 << 19)
+/* Nombre de morceaux dans lesquels on coupe les echantillons, independant du
+ * nombre de fils pour que le resultat n'en depende pas */
+#define N_MORCEAUX 64
+/* Nombre maximal de fils d'execution */
+#define N_FILS_MAX 64
+/* Nombres d'echantillons des fichiers d'exemple */
+#define N_ECHANTILLONS_PETIT 1002
+#define N_ECHANTILLONS_GRAND 4000002
+
+/**
+ * Fichier d'echantillons: descripteur, nombre d'echantillons et, s'il est
+ * projete en memoire, adresse de la projection (NULL pour la lecture par
+ * flux).
+ */
+struct source {
+    const double* donnees;
+    int descripteur;
+    long nEchantillons;
+};
+
+/**
+ * Cette fonction prepare la lecture d'un fichier d'echantillons.
+ *
+ * source : Source a preparer.
+ * descripteur : Descripteur du fichier, ouvert en lecture.
+ * projeter : 1 pour projeter le fichier en memoire, 0 pour le lire par flux.
+ *
+ * return : 0 si tout va bien, 1 si le fichier ne peut pas etre utilise.
+ */
+int source_ouvrir(struct source* source, const int descripteur,
+                  const int projeter) {
+    struct stat etat;
+
+    if (fstat(descripteur, &etat) || etat.st_size % sizeof(double)) return 1;
+    source->descripteur = descripteur;
+    source->nEchantillons = etat.st_size / sizeof(double);
+    source->donnees = NULL;
+
+    if (projeter && source->nEchantillons) {
+        void* projection = mmap(NULL, etat.st_size, PROT_READ, MAP_PRIVATE,
+                                descripteur, 0);
+        if (projection == MAP_FAILED) return 1;
+        /* Le systeme peut lire les pages suivantes a l'avance */
+        madvise(projection, etat.st_size, MADV_SEQUENTIAL);
+        source->donnees = projection;
+    }
+
+    return 0;
+}
+
+/**
+ * Cette fonction retire la projection d'un fichier d'echantillons.
+ *
+ * source : Source a fermer.
+ */
+void source_fermer(struct source* source) {
+    if (source->donnees)
+        munmap((void*)source->donnees, source->nEchantillons * sizeof(double));
+    source->donnees = NULL;
+}
+
+/**
+ * Cette fonction donne acces a n echantillons consecutifs: directement dans
+ * la projection, ou apres les avoir lus dans un tampon.
+ *
+ * source : Fichier d'echantillons.
+ * debut : Indice du premier echantillon.
+ * n : Nombre d'echantillons.
+ * tampon : Tableau d'au moins n doubles pour la lecture par flux.
+ *
+ * return : Adresse des echantillons, NULL en cas d'erreur de lecture.
+ */
+const double* source_lire(const struct source* source, const long debut,
+                          const long n, double tampon[]) {
+    if (source->donnees) return source->donnees + debut;
+
+    /* Nombre d'octets deja lus */
+    size_t lus = 0;
+    while (lus < n * sizeof(double)) {
+        const ssize_t resultat =
+            pread(source->descripteur, (char*)tampon + lus,
+                  n * sizeof(double) - lus, debut * sizeof(double) + lus);
+        if (resultat <= 0) return NULL;
+        lus += resultat;
+    }
+
+    return tampon;
+}
+
+/**
+ * Cette fonction rend au systeme les pages projetees de n echantillons deja
+ * utilises, pour que la memoire occupee reste bornee. Les pages partagees
+ * avec une fenetre voisine sont rendues aussi: si un autre fil en a encore
+ * besoin, elles seront simplement relues dans le fichier.
+ *
+ * source : Fichier d'echantillons.
+ * debut : Indice du premier echantillon.
+ * n : Nombre d'echantillons.
+ */
+void source_rendre(const struct source* source, const long debut,
+                   const long n) {
+    if (!source->donnees) return;
+
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const size_t fin = (size_t)source->nEchantillons * sizeof(double);
+    /* Octets de la fenetre, etendus aux limites des pages */
+    const size_t premier = debut * sizeof(double) / page * page;
+    size_t dernier = ((debut + n) * sizeof(double) + page - 1) / page * page;
+    if (dernier > fin) dernier = fin;
+
+    madvise((char*)source->donnees + premier, dernier - premier,
+            MADV_DONTNEED);
+}
+
+/**
+ * Cette fonction trouve les poids de l'integrale entre debut et fin du
+ * polynome qui interpole ordre + 1 valeurs aux points 0, 1, ..., ordre: le
+ * poids du point j est l'integrale de son polynome de Lagrange. Entre 0 et
+ * ordre, ce sont les poids de la regle de Newton-Cotes fermee. Les
+ * coefficients de (t - 0)...(t - ordre), sans le facteur (t - j), sont
+ * entiers, et en multipliant l'integrale par DENOMINATEUR_INTEGRALE elle
+ * reste entiere; chaque poids est donc le quotient de deux entiers exacts,
+ * arrondi une seule fois.
+ *
+ * ordre : Nombre d'intervalles entre les points, au plus ORDRE_MAX.
+ * debut : Borne inferieure d'integration, entre 0 et ordre.
+ * fin : Borne superieure d'integration, entre 0 et ordre.
+ * poids : Tableau ou on ecrit les ordre + 1 poids.
+ */
+void poids_Lagrange(const int ordre, const int debut, const int fin,
+                    double poids[]) {
+    for (int j = 0; j <= ordre; j++) {
+        /* Coefficients du numerateur du polynome de Lagrange du point j, par
+         * degre, et son denominateur */
+        long long coefficients[ORDRE_MAX + 1] = {1}, denominateur = 1;
+        int degre = 0;
+
+        for (int k = 0; k <= ordre; k++) {
+            if (k == j) continue;
+            /* Multiplication par (t - k) */
+            degre++;
+            for (int i = degre; i >= 0; i--)
+                coefficients[i] =
+                    (i ? coefficients[i - 1] : 0) - k * coefficients[i];
+            denominateur *= j - k;
+        }
+
+        /* Integrale multipliee par DENOMINATEUR_INTEGRALE, et puissances de
+         * debut et de fin */
+        long long integrale = 0, puissanceDebut = debut, puissanceFin = fin;
+        for (int i = 0; i <= degre; i++) {
+            integrale += coefficients[i] * (puissanceFin - puissanceDebut) *
+                         (DENOMINATEUR_INTEGRALE / (i + 1));
+            puissanceDebut *= debut;
+            puissanceFin *= fin;
+        }
+        poids[j] = (double)integrale /
+                   (double)(DENOMINATEUR_INTEGRALE * denominateur);
+    }
+}
+
+/**
+ * Cette fonction trouve la somme ponderee des echantillons debut a fin - 1,
+ * ou le poids de l'echantillon i est coefficients[i % ordre]. Les
+ * echantillons sont lus par fenetres, puis ajoutes par blocs d'un multiple de
+ * l'ordre, element par element, a un tableau de cumuls, ce qui se vectorise.
+ * Comme debut est un multiple de l'ordre, le cumul j a le poids
+ * coefficients[j % ordre], qu'on applique seulement a la fin.
+ *
+ * source : Fichier d'echantillons.
+ * debut : Indice du premier echantillon, un multiple de l'ordre.
+ * fin : Indice qui suit le dernier echantillon.
+ * coefficients : Poids des echantillons selon leur indice modulo l'ordre.
+ * ordre : Nombre de poids differents.
+ * tampon : Tableau de TAILLE_FENETRE doubles pour la lecture par flux.
+ *
+ * return : La somme ponderee, NAN en cas d'erreur de lecture.
+ */
+double somme_morceau(const struct source* source, const long debut,
+                     const long fin, const double coefficients[],
+                     const int ordre, double tampon[]) {
+    double cumuls[TAILLE_BLOC] = {0};
+    /* Taille des blocs et des fenetres, des multiples de l'ordre */
+    const int taille = TAILLE_BLOC / ordre * ordre;
+    const long fenetre = TAILLE_FENETRE / taille * taille;
+
+    for (long debutFenetre = debut; debutFenetre < fin;
+         debutFenetre += fenetre) {
+        const long n =
+            fin - debutFenetre < fenetre ? fin - debutFenetre : fenetre;
+        const double* y = source_lire(source, debutFenetre, n, tampon);
+        if (!y) return NAN;
+
+        for (long bloc = 0; bloc < n; bloc += taille) {
+            const int m = n - bloc < taille ? n - bloc : taille;
+            for (int j = 0; j < m; j++) cumuls[j] += y[bloc + j];
+        }
+        source_rendre(source, debutFenetre, n);
+    }
+
+    double somme = 0;
+    for (int r = 0; r < ordre; r++) {
+        double sommeReste = 0;
+        for (int j = r; j < taille; j += ordre) sommeReste += cumuls[j];
+        somme += coefficients[r] * sommeReste;
+    }
+
+    return somme;
+}
+
+/**
+ * Travail d'un fil d'execution: il calcule la somme ponderee des morceaux
+ * iPremier, iPremier + pas, iPremier + 2 * pas, ... et l'ecrit dans le
+ * tableau des sommes partielles. Les autres champs sont les parametres de
+ * somme_morceau.
+ */
+struct travail {
+    const struct source* source;
+    const double* coefficients;
+    double* partielles;
+    long nNoeuds, taille;
+    int ordre, iPremier, pas;
+};
+
+/**
+ * Cette fonction est executee par chaque fil d'execution.
+ *
+ * argument : Pointeur vers la struct travail du fil
+ *
+ * return : NULL
+ */
+void* executer_travail(void* argument) {
+    const struct travail* travail = argument;
+    /* Tampon de lecture par flux, inutile avec la projection */
+    double* tampon =
+        travail->source->donnees ? NULL
+                                 : malloc(TAILLE_FENETRE * sizeof *tampon);
+
+    for (int i = travail->iPremier; i < N_MORCEAUX; i += travail->pas) {
+        /* Echantillons du morceau, coupes a la fin des noeuds */
+        const long debut = i * travail->taille;
+        const long fin = debut + travail->taille < travail->nNoeuds
+                             ? debut + travail->taille
+                             : travail->nNoeuds;
+
+        if (debut >= fin)
+            travail->partielles[i] = 0;
+        else if (!travail->source->donnees && !tampon)
+            travail->partielles[i] = NAN;
+        else
+            travail->partielles[i] =
+                somme_morceau(travail->source, debut, fin,
+                              travail->coefficients, travail->ordre, tampon);
+    }
+
+    free(tampon);
+    return NULL;
+}
+
+/**
+ * On trouve l'integrale d'un signal echantillonne par la regle de
+ * Newton-Cotes fermee composee d'un certain ordre. Les panneaux couvrent les
+ * premiers intervalles, le plus grand multiple de l'ordre, et leurs noeuds
+ * sont repartis en N_MORCEAUX morceaux entre les fils d'execution; chaque
+ * morceau commence sur un multiple de l'ordre et les sommes partielles sont
+ * additionnees dans l'ordre des morceaux, donc le resultat est le meme, au
+ * bit pres, peu importe le nombre de fils. Les intervalles qui restent sont
+ * integres avec le polynome qui interpole les ordre + 1 derniers
+ * echantillons.
+ *
+ * ordre : Nombre d'intervalles par panneau, entre 1 et ORDRE_MAX.
+ * source : Fichier d'echantillons.
+ * pas : Ecart entre deux echantillons.
+ * nFils : Nombre de fils d'execution a utiliser.
+ *
+ * return : Valeur de l'integrale approximee, NAN en cas d'erreur de lecture.
+ */
+double Newton_Cotes(int ordre, const struct source* source, const double pas,
+                    int nFils) {
+    pthread_t fils[N_FILS_MAX];
+    struct travail travaux[N_FILS_MAX];
+    int lance[N_FILS_MAX] = {0};
+    double partielles[N_MORCEAUX];
+    /* Poids d'un panneau, poids de chaque noeud selon son indice modulo
+     * l'ordre et poids de la fin */
+    double poids[ORDRE_MAX + 1] = {0}, coefficients[ORDRE_MAX],
+        poidsFin[ORDRE_MAX + 1];
+    /* Echantillons du debut, de la fin des panneaux et de la fin */
+    double premier[1], dernier[1], tampon[ORDRE_MAX + 1];
+
+    const long nIntervalles = source->nEchantillons - 1;
+    if (nIntervalles < 1) return 0;
+    if (ordre > nIntervalles) ordre = nIntervalles;
+    /* Nombre d'intervalles couverts par les panneaux et nombre restant */
+    const long nPanneaux = nIntervalles / ordre * ordre;
+    const int reste = nIntervalles - nPanneaux;
+
+    /* Le noeud 0 d'un panneau est partage avec le panneau precedent */
+    poids_Lagrange(ordre, 0, ordre, poids);
+    coefficients[0] = 2 * poids[0];
+    for (int r = 1; r < ordre; r++) coefficients[r] = poids[r];
+
+    /* Taille d'un morceau, arrondie au multiple de la taille des blocs */
+    const long taille = TAILLE_BLOC / ordre * ordre;
+    const long tailleMorceau =
+        ((nPanneaux + 1 + N_MORCEAUX - 1) / N_MORCEAUX + taille - 1) / taille *
+        taille;
+
+    if (nFils > N_FILS_MAX) nFils = N_FILS_MAX;
+    if (nFils < 1) nFils = 1;
+
+    for (int i = 0; i < nFils; i++) {
+        travaux[i] = (struct travail){source,        coefficients, partielles,
+                                      nPanneaux + 1, tailleMorceau, ordre,
+                                      i,             nFils};
+        /* Le fil principal fait le premier travail lui-meme, ainsi que celui
+         * de tout fil qui ne peut pas etre cree */
+        if (i)
+            lance[i] = !pthread_create(&fils[i], NULL, executer_travail,
+                                       &travaux[i]);
+        if (i && !lance[i]) executer_travail(&travaux[i]);
+    }
+    executer_travail(&travaux[0]);
+    for (int i = 1; i < nFils; i++)
+        if (lance[i]) pthread_join(fils[i], NULL);
+
+    /* Reduction dans un ordre fixe */
+    double somme = 0;
+    for (int i = 0; i < N_MORCEAUX; i++) somme += partielles[i];
+
+    /* Les extremites des panneaux ont compte comme des noeuds partages */
+    const double* y0 = source_lire(source, 0, 1, premier);
+    const double* yn = source_lire(source, nPanneaux, 1, dernier);
+    if (!y0 || !yn) return NAN;
+    somme -= poids[0] * (*y0 + *yn);
+
+    if (reste) {
+        const double* y =
+            source_lire(source, nIntervalles - ordre, ordre + 1, tampon);
+        if (!y) return NAN;
+        poids_Lagrange(ordre, ordre - reste, ordre, poidsFin);
+        for (int j = 0; j <= ordre; j++) somme += poidsFin[j] * y[j];
+    }
+
+    return pas * somme;
+}
+
+/**
+ * Toutes les fonctions ci-apres appliquent Newton_Cotes avec l'ordre de la
+ * methode du meme nom.
+ *
+ * source : Fichier d'echantillons.
+ * pas : Ecart entre deux echantillons.
+ * nFils : Nombre de fils d'execution a utiliser.
+ *
+ * return : Valeur de l'integrale approximee, NAN en cas d'erreur de lecture.
+ */
+double Trapeze(const struct source* source, const double pas,
+               const int nFils) {
+    return Newton_Cotes(1, source, pas, nFils);
+}
+
+double Simpson(const struct source* source, const double pas,
+               const int nFils) {
+    return Newton_Cotes(2, source, pas, nFils);
+}
+
+double Simpson3Sur8(const struct source* source, const double pas,
+                    const int nFils) {
+    return Newton_Cotes(3, source, pas, nFils);
+}
+
+double Newton_Cotes10(const struct source* source, const double pas,
+                      const int nFils) {
+    return Newton_Cotes(9, source, pas, nFils);
+}
+
+/* Methodes comparees et leurs noms */
+double (*const methodes[4])(const struct source*, double, int) = {
+    Trapeze, Simpson, Simpson3Sur8, Newton_Cotes10};
+const char* nomsMethodes[4] = {"Trapeze", "Simpson", "Simpson 3/8",
+                               "Secrete"};
+
+/**
+ * Cette fonction integre un fichier d'echantillons par les quatre methodes et
+ * montre le resultat de chacune, le temps de calcul et, si elle est connue,
+ * l'erreur par rapport a l'integrale exacte.
+ *
+ * descripteur : Descripteur du fichier d'echantillons.
+ * pas : Ecart entre deux echantillons.
+ * projeter : 1 pour projeter le fichier en memoire, 0 pour le lire par flux.
+ * nFils : Nombre de fils d'execution a utiliser.
+ * integraleExacte : Valeur exacte de l'integrale, NAN si elle est inconnue.
+ *
+ * return : 0 si tout va bien, 1 si le fichier ne peut pas etre utilise.
+ */
+int integrer_fichier(const int descripteur, const double pas,
+                     const int projeter, const int nFils,
+                     const double integraleExacte) {
+    struct source source;
+
+    if (source_ouvrir(&source, descripteur, projeter)) return 1;
+
+    for (int i = 0; i < 4; i++) {
+        struct timespec debut, fin;
+        clock_gettime(CLOCK_MONOTONIC, &debut);
+        const double valeur = methodes[i](&source, pas, nFils);
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+
+        printf("%-12s %-6s %21.16f ", nomsMethodes[i],
+               projeter ? "mmap" : "flux", valeur);
+        if (isnan(integraleExacte))
+            printf("%13s", "-");
+        else
+            printf("%13.3e", fabs(valeur - integraleExacte));
+        printf(" %11.2f\n", ((fin.tv_sec - debut.tv_sec) +
+                             (fin.tv_nsec - debut.tv_nsec) * 1e-9) *
+                                1e3);
+    }
+
+    source_fermer(&source);
+    return 0;
+}
+
+/**
+ * Cette fonction ecrit des echantillons de exp entre 0 et 1 dans un fichier
+ * temporaire, qui est detruit lorsqu'il est ferme.
+ *
+ * nEchantillons : Nombre d'echantillons.
+ *
+ * return : Le fichier, NULL en cas d'erreur.
+ */
+FILE* ecrire_exemple(const long nEchantillons) {
+    FILE* fichier = tmpfile();
+    double bloc[TAILLE_BLOC];
+
+    if (!fichier) return NULL;
+    for (long debut = 0; debut < nEchantillons; debut += TAILLE_BLOC) {
+        const int n = nEchantillons - debut < TAILLE_BLOC
+                          ? nEchantillons - debut
+                          : TAILLE_BLOC;
+        for (int j = 0; j < n; j++)
+            bloc[j] = exp((double)(debut + j) / (nEchantillons - 1));
+        fwrite(bloc, sizeof(double), n, fichier);
+    }
+    if (fflush(fichier)) {
+        fclose(fichier);
+        return NULL;
+    }
+
+    return fichier;
+}
+
+int main(int argc, char* argv[]) {
+    /* Nombre de fils d'execution et mode de lecture */
+    int nFils = (int)sysconf(_SC_NPROCESSORS_ONLN), projeter = 1;
+
+    if (argc > 1 && !strcmp(argv[1], "--flux")) {
+        projeter = 0;
+        argv++;
+        argc--;
+    }
+
+    if (argc > 2) {
+        /* Pas entre deux echantillons, puis fin de chaque nombre lu, qui doit
+         * etre la fin de l'argument */
+        char *finPas, *finFils = "";
+        const double pas = strtod(argv[2], &finPas);
+        if (argc > 3) nFils = (int)strtol(argv[3], &finFils, 10);
+        if (argc > 4 || *finPas || *finFils || !(pas > 0) || isinf(pas) ||
+            nFils < 1) {
+            printf("Utilisation : %s [--flux] fichier pas [fils], avec un pas "
+                   "et un nombre de fils positifs\n",
+                   argv[0]);
+            return 1;
+        }
+        const int descripteur = open(argv[1], O_RDONLY);
+        if (descripteur < 0) {
+            printf("Impossible d'ouvrir %s\n", argv[1]);
+            return 1;
+        }
+        printf("Methode      Lect.      Valeur approximee   Erreur abs."
+               "  Temps (ms)\n");
+        const int erreur =
+            integrer_fichier(descripteur, pas, projeter, nFils, NAN);
+        close(descripteur);
+        if (erreur) printf("%s n'est pas un fichier de doubles\n", argv[1]);
+        return erreur;
+    }
+
+    /* Exemples: peu d'echantillons pour voir l'erreur des methodes, beaucoup
+     * pour le temps de lecture */
+    const long nEchantillons[2] = {N_ECHANTILLONS_PETIT, N_ECHANTILLONS_GRAND};
+    for (int i = 0; i < 2; i++) {
+        FILE* fichier = ecrire_exemple(nEchantillons[i]);
+        if (!fichier) {
+            printf("Impossible d'ecrire le fichier temporaire\n");
+            return 1;
+        }
+
+        printf("%ld echantillons de exp entre 0 et 1 (%ld intervalles), %d "
+               "fils\n",
+               nEchantillons[i], nEchantillons[i] - 1, nFils);
+        printf("Methode      Lect.      Valeur approximee   Erreur abs."
+               "  Temps (ms)\n");
+        for (int projection = 1; projection >= 0; projection--)
+            integrer_fichier(fileno(fichier), 1.0 / (nEchantillons[i] - 1),
+                             projection, nFils, exp(1) - 1);
+        printf("\n");
+        fclose(fichier);
+    }
+
+    return 0;
+}
+
+/*
+1002 echantillons de exp entre 0 et 1 (1001 intervalles), 1 fils
+Methode      Lect.      Valeur approximee   Erreur abs.  Temps (ms)
+Trapeze      mmap      1.7182819713632436     1.429e-07        0.02
+Simpson      mmap      1.7182818284591672     1.221e-13        0.02
+Simpson 3/8  mmap      1.7182818284590666     2.154e-14        0.02
+Secrete      mmap      1.7182818284590444     6.661e-16        0.02
+Trapeze      flux      1.7182819713632436     1.429e-07        0.03
+Simpson      flux      1.7182818284591672     1.221e-13        0.01
+Simpson 3/8  flux      1.7182818284590666     2.154e-14        0.01
+Secrete      flux      1.7182818284590444     6.661e-16        0.01
+
+4000002 echantillons de exp entre 0 et 1 (4000001 intervalles), 1 fils
+Methode      Lect.      Valeur approximee   Erreur abs.  Temps (ms)
+Trapeze      mmap      1.7182818284590544     9.326e-15        7.47
+Simpson      mmap      1.7182818284590453     2.220e-16        6.93
+Simpson 3/8  mmap      1.7182818284590446     4.441e-16        6.83
+Secrete      mmap      1.7182818284590458     6.661e-16        6.54
+Trapeze      flux      1.7182818284590544     9.326e-15        7.49
+Simpson      flux      1.7182818284590453     2.220e-16        8.00
+Simpson 3/8  flux      1.7182818284590446     4.441e-16        6.64
+Secrete      flux      1.7182818284590458     6.661e-16        6.38
+*/
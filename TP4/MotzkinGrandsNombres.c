@@ -0,0 +1,1015 @@
+/**
+ * Auteur : Nicolas Levasseur
+ *
+ * Ce programme calcule exactement les nombres de Motzkin de TP4A pour de
+ * grands indices. Motzkin_iteratif1 calcule (2n + 1) / (n + 2) en double, donc
+ * ses resultats ne sont plus des entiers exacts des que les termes depassent
+ * la precision d'un double. Ici, les termes sont des entiers de taille
+ * arbitraire et la recurrence (n + 2) M_n = (2n + 1) M_(n-1) + (3n - 3)
+ * M_(n-2) est appliquee en multipliant d'abord, puis en divisant exactement.
+ *
+ * Les entiers sont des tableaux de chiffres de 32 bits (poids faible d'abord)
+ * en base 2^32 pour les calculs ou en base 10^9 pour l'affichage. La
+ * multiplication est naive pour les petits nombres, puis de Karatsuba, puis
+ * par transformee de Fourier dans trois corps premiers (NTT) pour les grands.
+ * La conversion en decimal coupe le nombre en deux moities a chaque niveau et
+ * recolle les moities avec une multiplication par une puissance de 2^32 deja
+ * convertie, ce qui coute O(M(n) log n) au lieu des O(n^2) d'une conversion
+ * chiffre par chiffre.
+ *
+ * Utilisation : MotzkinGrandsNombres [n]
+ * Avec n, le programme affiche tous les chiffres de M_n. Sans argument, il
+ * compare les termes exacts aux termes en double, verifie les termes avec la
+ * recurrence de convolution de Motzkin_recursif1 et mesure les temps de calcul
+ * et de conversion pour quelques grands indices.
+ *
+ * Compilation : gcc -O3 -march=native MotzkinGrandsNombres.c -o MotzkinGrandsNombres
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Bases des chiffres des entiers */
+#define BASE_BINAIRE (1ull << 32)
+#define BASE_DECIMALE 1000000000ull
+/* Nombre de chiffres decimaux d'un chiffre en base 10^9 */
+#define N_CHIFFRES_BASE_DECIMALE 9
+/* Taille (en chiffres du plus petit facteur) a partir de laquelle on utilise
+ * Karatsuba, puis la NTT */
+#define SEUIL_KARATSUBA 32
+#define SEUIL_NTT 1024
+/* Taille maximale d'une NTT: les trois premiers ont des racines de l'unite
+ * d'ordre 2^23, et un coefficient du produit (au plus 2^22 * 2^64) reste plus
+ * petit que le produit des trois premiers (environ 2^86) */
+#define TAILLE_NTT_MAX (1 << 23)
+/* Taille (en chiffres de 32 bits) sous laquelle on convertit en decimal
+ * chiffre par chiffre */
+#define SEUIL_CONVERSION 64
+/* Nombre maximal de puissances de 2^32 converties (SEUIL_CONVERSION * 2^k
+ * chiffres pour la k-ieme) */
+#define N_PUISSANCES_MAX 32
+/* Plus grand indice accepte, pour que (2n + 1) + (3n - 3) tienne sur 32 bits */
+#define N_MAX 100000000
+/* Nombre de termes compares aux termes calcules en double */
+#define N_TERMES_DOUBLE 60
+/* Indice du terme verifie avec la recurrence de convolution */
+#define N_VERIFICATION 2000
+/* Nombre de chiffres affiches au debut et a la fin des grands termes */
+#define N_CHIFFRES_AFFICHES 20
+
+/**
+ * Entier positif de taille arbitraire. Le chiffre de poids fort est non nul,
+ * et zero n'a aucun chiffre.
+ */
+struct grand {
+    uint32_t* chiffres;
+    size_t n;
+};
+
+/**
+ * Un des trois premiers de la NTT, avec les constantes de sa multiplication de
+ * Montgomery (les residus a sont gardes sous la forme a * 2^32 mod p, ce qui
+ * remplace la division par p par deux multiplications).
+ */
+struct premier {
+    uint32_t p, racine;
+    /* -1 / p mod 2^32 et 2^64 mod p */
+    uint32_t pInverse, r2;
+};
+
+/* Premiers de la forme c * 2^k + 1, avec 3 comme racine primitive */
+static struct premier premiers[3] = {
+    {998244353, 3, 0, 0}, {167772161, 3, 0, 0}, {469762049, 3, 0, 0}};
+
+/**
+ * Cette fonction trouve le quotient d'un nombre de 64 bits par la base. Les
+ * deux bases sont des constantes, donc le compilateur remplace la division par
+ * un decalage ou une multiplication.
+ *
+ * t : Nombre a diviser
+ * base : BASE_BINAIRE ou BASE_DECIMALE
+ *
+ * return : t / base
+ */
+static inline uint64_t quotient(const uint64_t t, const uint64_t base) {
+    return base == BASE_BINAIRE ? t >> 32 : t / BASE_DECIMALE;
+}
+
+/**
+ * Cette fonction trouve le reste d'un nombre de 64 bits modulo la base.
+ *
+ * t : Nombre a diviser
+ * base : BASE_BINAIRE ou BASE_DECIMALE
+ *
+ * return : t mod base
+ */
+static inline uint32_t reste(const uint64_t t, const uint64_t base) {
+    return base == BASE_BINAIRE ? (uint32_t)t : (uint32_t)(t % BASE_DECIMALE);
+}
+
+/**
+ * Cette fonction enleve les chiffres nuls de poids fort.
+ *
+ * a : Chiffres du nombre
+ * n : Nombre de chiffres
+ *
+ * return : Nombre de chiffres sans les zeros de poids fort
+ */
+size_t normaliser(const uint32_t a[], size_t n) {
+    while (n && !a[n - 1]) n--;
+    return n;
+}
+
+/**
+ * Cette fonction additionne deux nombres. Le resultat peut etre le premier
+ * terme.
+ *
+ * r : Chiffres du resultat (na chiffres)
+ * a, na : Premier terme et son nombre de chiffres
+ * b, nb : Deuxieme terme et son nombre de chiffres, plus petit que na
+ * base : Base des chiffres
+ *
+ * return : Retenue qui sort du chiffre na - 1 (0 ou 1)
+ */
+uint32_t additionner(uint32_t r[], const uint32_t a[], const size_t na,
+                     const uint32_t b[], const size_t nb,
+                     const uint64_t base) {
+    uint64_t retenue = 0;
+
+    for (size_t i = 0; i < na; i++) {
+        const uint64_t t = (uint64_t)a[i] + (i < nb ? b[i] : 0) + retenue;
+        retenue = t >= base;
+        r[i] = (uint32_t)(retenue ? t - base : t);
+        if (i >= nb && !retenue && r == a) break;
+    }
+
+    return (uint32_t)retenue;
+}
+
+/**
+ * Cette fonction soustrait deux nombres quand le resultat est positif. Le
+ * resultat peut etre le premier terme.
+ *
+ * r : Chiffres du resultat (na chiffres)
+ * a, na : Nombre duquel on soustrait et son nombre de chiffres
+ * b, nb : Nombre a soustraire et son nombre de chiffres, plus petit que na
+ * base : Base des chiffres
+ */
+void soustraire(uint32_t r[], const uint32_t a[], const size_t na,
+                const uint32_t b[], const size_t nb, const uint64_t base) {
+    int64_t emprunt = 0;
+
+    for (size_t i = 0; i < na; i++) {
+        int64_t t = (int64_t)a[i] - (i < nb ? b[i] : 0) - emprunt;
+        emprunt = t < 0;
+        r[i] = (uint32_t)(emprunt ? t + (int64_t)base : t);
+        if (i >= nb && !emprunt && r == a) break;
+    }
+}
+
+/**
+ * Cette fonction multiplie deux nombres chiffre par chiffre, en O(na * nb).
+ *
+ * r : Chiffres du produit (na + nb chiffres), distincts des facteurs
+ * a, na : Premier facteur et son nombre de chiffres
+ * b, nb : Deuxieme facteur et son nombre de chiffres
+ * base : Base des chiffres
+ */
+void multiplier_naif(uint32_t r[], const uint32_t a[], const size_t na,
+                     const uint32_t b[], const size_t nb,
+                     const uint64_t base) {
+    memset(r, 0, (na + nb) * sizeof *r);
+
+    for (size_t i = 0; i < na; i++) {
+        /* Le produit de deux chiffres plus deux chiffres tient sur 64 bits */
+        uint64_t retenue = 0;
+        for (size_t j = 0; j < nb; j++) {
+            const uint64_t t = r[i + j] + (uint64_t)a[i] * b[j] + retenue;
+            r[i + j] = reste(t, base);
+            retenue = quotient(t, base);
+        }
+        r[i + nb] = (uint32_t)retenue;
+    }
+}
+
+/**
+ * Cette fonction trouve la taille de l'espace de travail de Karatsuba pour
+ * deux facteurs de n chiffres.
+ *
+ * n : Nombre de chiffres des facteurs
+ *
+ * return : Nombre de chiffres de l'espace de travail
+ */
+size_t taille_travail_Karatsuba(const size_t n) {
+    if (n < SEUIL_KARATSUBA) return 0;
+    const size_t h = n - n / 2;
+    return 4 * (h + 1) + taille_travail_Karatsuba(h + 1);
+}
+
+/**
+ * Cette fonction multiplie deux nombres de meme taille avec l'algorithme de
+ * Karatsuba. On coupe a = a0 + a1 * B^m et b = b0 + b1 * B^m, et le terme du
+ * milieu a0 * b1 + a1 * b0 = (a0 + a1)(b0 + b1) - a0 * b0 - a1 * b1 ne coute
+ * qu'une multiplication, d'ou O(n^1.585) operations.
+ *
+ * r : Chiffres du produit (2n chiffres), distincts des facteurs
+ * a, b : Facteurs de n chiffres
+ * n : Nombre de chiffres des facteurs
+ * base : Base des chiffres
+ * travail : Espace de travail de taille_travail_Karatsuba(n) chiffres
+ */
+void multiplier_Karatsuba(uint32_t r[], const uint32_t a[], const uint32_t b[],
+                          const size_t n, const uint64_t base,
+                          uint32_t travail[]) {
+    if (n < SEUIL_KARATSUBA) {
+        multiplier_naif(r, a, n, b, n, base);
+        return;
+    }
+
+    /* Nombre de chiffres des moities basse et haute */
+    const size_t m = n / 2, h = n - m;
+    /* Sommes des moities et produit de ces sommes */
+    uint32_t *sommeA = travail, *sommeB = sommeA + h + 1,
+             *milieu = sommeB + h + 1, *suite = milieu + 2 * (h + 1);
+
+    /* a0 * b0 et a1 * b1 vont directement dans les deux moities de r */
+    multiplier_Karatsuba(r, a, b, m, base, suite);
+    multiplier_Karatsuba(r + 2 * m, a + m, b + m, h, base, suite);
+
+    sommeA[h] = additionner(sommeA, a + m, h, a, m, base);
+    sommeB[h] = additionner(sommeB, b + m, h, b, m, base);
+    multiplier_Karatsuba(milieu, sommeA, sommeB, h + 1, base, suite);
+    soustraire(milieu, milieu, 2 * (h + 1), r, 2 * m, base);
+    soustraire(milieu, milieu, 2 * (h + 1), r + 2 * m, 2 * h, base);
+
+    additionner(r + m, r + m, 2 * n - m, milieu,
+                normaliser(milieu, 2 * (h + 1)), base);
+}
+
+/**
+ * Cette fonction multiplie deux residus sous forme de Montgomery.
+ *
+ * a, b : Residus sous forme de Montgomery
+ * premier : Premier et ses constantes
+ *
+ * return : Produit sous forme de Montgomery
+ */
+static inline uint32_t multiplier_Montgomery(const uint32_t a, const uint32_t b,
+                                             const struct premier* premier) {
+    const uint64_t t = (uint64_t)a * b;
+    const uint32_t m = (uint32_t)t * premier->pInverse;
+    const uint32_t u = (uint32_t)((t + (uint64_t)m * premier->p) >> 32);
+    return u >= premier->p ? u - premier->p : u;
+}
+
+/**
+ * Cette fonction calcule une puissance d'un residu sous forme de Montgomery.
+ *
+ * base : Residu sous forme de Montgomery
+ * exposant : Exposant
+ * premier : Premier et ses constantes
+ *
+ * return : base^exposant sous forme de Montgomery
+ */
+uint32_t puissance_Montgomery(uint32_t base, uint64_t exposant,
+                              const struct premier* premier) {
+    /* 1 sous forme de Montgomery */
+    uint32_t resultat = (uint32_t)(BASE_BINAIRE % premier->p);
+
+    for (; exposant; exposant >>= 1) {
+        if (exposant & 1)
+            resultat = multiplier_Montgomery(resultat, base, premier);
+        base = multiplier_Montgomery(base, base, premier);
+    }
+
+    return resultat;
+}
+
+/**
+ * Cette fonction calcule une puissance modulaire ordinaire.
+ *
+ * base : Base, plus petite que le module
+ * exposant : Exposant
+ * module : Module, plus petit que 2^32
+ *
+ * return : base^exposant mod module
+ */
+uint64_t puissance_modulaire(uint64_t base, uint64_t exposant,
+                             const uint64_t module) {
+    uint64_t resultat = 1;
+
+    for (; exposant; exposant >>= 1) {
+        if (exposant & 1) resultat = resultat * base % module;
+        base = base * base % module;
+    }
+
+    return resultat;
+}
+
+/**
+ * Cette fonction calcule les constantes de Montgomery des trois premiers.
+ */
+void initialiser_premiers(void) {
+    for (int k = 0; k < 3; k++) {
+        const uint32_t p = premiers[k].p;
+        /* Inverse de p modulo 2^32 par la methode de Newton (chaque iteration
+         * double le nombre de bits exacts) */
+        uint32_t inverse = p;
+        for (int i = 0; i < 5; i++) inverse *= 2 - p * inverse;
+        premiers[k].pInverse = -inverse;
+        const uint64_t r = BASE_BINAIRE % p;
+        premiers[k].r2 = (uint32_t)(r * r % p);
+    }
+}
+
+/**
+ * Cette fonction calcule la transformee de Fourier discrete d'un tableau de
+ * residus sous forme de Montgomery, en place (Cooley-Tukey iteratif).
+ *
+ * a : Residus, remplaces par leur transformee
+ * n : Taille, une puissance de 2
+ * inverse : 1 pour la transformee inverse (divisee par n), 0 sinon
+ * premier : Premier et ses constantes
+ * racines : Tableau de n / 2 residus pour les racines de l'unite
+ */
+void NTT(uint32_t a[], const size_t n, const int inverse,
+         const struct premier* premier, uint32_t racines[]) {
+    const uint32_t p = premier->p;
+
+    /* Permutation par inversion des bits des indices */
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j |= bit;
+        if (i < j) {
+            const uint32_t temporaire = a[i];
+            a[i] = a[j];
+            a[j] = temporaire;
+        }
+    }
+
+    for (size_t longueur = 2; longueur <= n; longueur <<= 1) {
+        const size_t moitie = longueur / 2;
+        /* Racine primitive longueur-ieme de l'unite (ou son inverse) */
+        const uint64_t exposant = (p - 1) / longueur;
+        const uint32_t racine = puissance_Montgomery(
+            multiplier_Montgomery(premier->racine, premier->r2, premier),
+            inverse ? p - 1 - exposant : exposant, premier);
+        racines[0] = (uint32_t)(BASE_BINAIRE % p);
+        for (size_t j = 1; j < moitie; j++)
+            racines[j] = multiplier_Montgomery(racines[j - 1], racine, premier);
+
+        for (size_t i = 0; i < n; i += longueur)
+            for (size_t j = 0; j < moitie; j++) {
+                const uint32_t u = a[i + j];
+                const uint32_t v =
+                    multiplier_Montgomery(a[i + j + moitie], racines[j],
+                                          premier);
+                a[i + j] = u + v >= p ? u + v - p : u + v;
+                a[i + j + moitie] = u >= v ? u - v : u + p - v;
+            }
+    }
+
+    if (inverse) {
+        /* 1 / n sous forme de Montgomery */
+        const uint32_t facteur = puissance_Montgomery(
+            multiplier_Montgomery((uint32_t)n, premier->r2, premier), p - 2,
+            premier);
+        for (size_t i = 0; i < n; i++)
+            a[i] = multiplier_Montgomery(a[i], facteur, premier);
+    }
+}
+
+/**
+ * Cette fonction calcule la convolution de deux suites de chiffres modulo un
+ * des premiers, avec des residus sous forme ordinaire en sortie.
+ *
+ * resultat : Tableau de taille residus (taille elements)
+ * a, na : Premier facteur et son nombre de chiffres
+ * b, nb : Deuxieme facteur et son nombre de chiffres
+ * taille : Taille de la transformee, au moins na + nb
+ * premier : Premier et ses constantes
+ * travail : Tableau de taille + taille / 2 elements
+ */
+void convoluer(uint32_t resultat[], const uint32_t a[], const size_t na,
+               const uint32_t b[], const size_t nb, const size_t taille,
+               const struct premier* premier, uint32_t travail[]) {
+    /* Transformee du deuxieme facteur et racines de l'unite */
+    uint32_t *transformeeB = travail, *racines = travail + taille;
+
+    for (size_t i = 0; i < taille; i++)
+        resultat[i] = i < na ? multiplier_Montgomery(a[i] % premier->p,
+                                                     premier->r2, premier)
+                             : 0;
+    NTT(resultat, taille, 0, premier, racines);
+
+    /* Un carre n'a besoin que d'une transformee directe */
+    if (a != b || na != nb) {
+        for (size_t i = 0; i < taille; i++)
+            transformeeB[i] = i < nb ? multiplier_Montgomery(
+                                           b[i] % premier->p, premier->r2,
+                                           premier)
+                                     : 0;
+        NTT(transformeeB, taille, 0, premier, racines);
+    } else
+        memcpy(transformeeB, resultat, taille * sizeof *resultat);
+
+    for (size_t i = 0; i < taille; i++)
+        resultat[i] = multiplier_Montgomery(resultat[i], transformeeB[i],
+                                            premier);
+    NTT(resultat, taille, 1, premier, racines);
+
+    /* Retour a la forme ordinaire (multiplication par 1 / 2^32) */
+    for (size_t i = 0; i < taille; i++)
+        resultat[i] = multiplier_Montgomery(resultat[i], 1, premier);
+}
+
+/**
+ * Cette fonction multiplie deux nombres par NTT: on calcule la convolution des
+ * chiffres modulo trois premiers, on reconstruit les coefficients exacts par
+ * le theoreme des restes chinois (algorithme de Garner), puis on propage les
+ * retenues dans la base. Cela coute O(n log n) operations.
+ *
+ * r : Chiffres du produit (na + nb chiffres), distincts des facteurs
+ * a, na : Premier facteur et son nombre de chiffres
+ * b, nb : Deuxieme facteur et son nombre de chiffres
+ * base : Base des chiffres
+ */
+void multiplier_NTT(uint32_t r[], const uint32_t a[], const size_t na,
+                    const uint32_t b[], const size_t nb, const uint64_t base) {
+    /* Taille de la transformee */
+    size_t taille = 1;
+    while (taille < na + nb) taille <<= 1;
+    if (taille > TAILLE_NTT_MAX) {
+        printf("Produit trop grand pour la NTT (%zu chiffres)\n", na + nb);
+        exit(1);
+    }
+
+    uint32_t* residus = malloc((3 * taille + taille + taille / 2) *
+                               sizeof *residus);
+    if (!residus) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+    for (int k = 0; k < 3; k++)
+        convoluer(residus + k * taille, a, na, b, nb, taille, &premiers[k],
+                  residus + 3 * taille);
+
+    /* Constantes de Garner */
+    const uint64_t p0 = premiers[0].p, p1 = premiers[1].p, p2 = premiers[2].p;
+    const uint64_t inverseP0 = puissance_modulaire(p0 % p1, p1 - 2, p1);
+    const uint64_t inverseP0P1 =
+        puissance_modulaire(p0 * p1 % p2, p2 - 2, p2);
+
+    unsigned __int128 retenue = 0;
+    for (size_t i = 0; i < na + nb; i++) {
+        const uint64_t r0 = residus[i], r1 = residus[taille + i],
+                       r2 = residus[2 * taille + i];
+        /* x = r0 + p0 * t1 + p0 * p1 * t2, avec t1 < p1 et t2 < p2 */
+        const uint64_t t1 = (r1 + p1 - r0 % p1) % p1 * inverseP0 % p1;
+        const uint64_t x01 = r0 + p0 * t1;
+        const uint64_t t2 = (r2 + p2 - x01 % p2) % p2 * inverseP0P1 % p2;
+        const unsigned __int128 t =
+            x01 + (unsigned __int128)(p0 * p1) * t2 + retenue;
+        r[i] = (uint32_t)(t % base);
+        retenue = t / base;
+    }
+
+    free(residus);
+}
+
+/**
+ * Cette fonction multiplie deux nombres avec la methode qui convient a leur
+ * taille. Si les tailles sont differentes, on multiplie par tranches du plus
+ * grand facteur de la taille du plus petit.
+ *
+ * r : Chiffres du produit (na + nb chiffres), distincts des facteurs
+ * a, na : Premier facteur et son nombre de chiffres
+ * b, nb : Deuxieme facteur et son nombre de chiffres
+ * base : Base des chiffres
+ */
+void multiplier(uint32_t r[], const uint32_t a[], const size_t na,
+                const uint32_t b[], const size_t nb, const uint64_t base) {
+    if (na < nb) {
+        multiplier(r, b, nb, a, na, base);
+        return;
+    }
+
+    if (nb < SEUIL_KARATSUBA) {
+        multiplier_naif(r, a, na, b, nb, base);
+        return;
+    }
+    if (nb >= SEUIL_NTT) {
+        multiplier_NTT(r, a, na, b, nb, base);
+        return;
+    }
+
+    /* Produit d'une tranche et espace de travail de Karatsuba */
+    uint32_t* produit =
+        malloc((2 * nb + taille_travail_Karatsuba(nb)) * sizeof *produit);
+    if (!produit) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+
+    memset(r, 0, (na + nb) * sizeof *r);
+    for (size_t i = 0; i < na; i += nb) {
+        if (na - i >= nb)
+            multiplier_Karatsuba(produit, a + i, b, nb, base, produit + 2 * nb);
+        else
+            multiplier(produit, b, nb, a + i, na - i, base);
+        /* La tranche i n'a pas encore de chiffres au-dela de i + nb */
+        const size_t nProduit = nb + (na - i < nb ? na - i : nb);
+        additionner(r + i, r + i, na + nb - i, produit, nProduit, base);
+    }
+
+    free(produit);
+}
+
+/**
+ * Cette fonction calcule le terme suivant de la suite de Motzkin a partir des
+ * deux termes precedents, avec M_n = ((2n + 1) M_(n-1) + (3n - 3) M_(n-2)) /
+ * (n + 2). Le produit est exactement divisible par n + 2 = 2^s * d avec d
+ * impair: on divise par d pendant la meme passe que la multiplication (division
+ * exacte de Hensel, du poids faible au poids fort, avec l'inverse de d modulo
+ * 2^32 au lieu d'une division par chiffre), puis on decale de s bits.
+ *
+ * courant : Chiffres de M_n (au moins precedent->n + 1 chiffres)
+ * precedent : M_(n-1)
+ * avantPrecedent : M_(n-2)
+ * n : Indice du terme a calculer, au moins 2
+ *
+ * return : Nombre de chiffres de M_n
+ */
+size_t Motzkin_suivant(uint32_t courant[], const struct grand* precedent,
+                       const struct grand* avantPrecedent, const uint32_t n) {
+    const uint64_t coefficient1 = 2 * n + 1, coefficient2 = 3 * n - 3;
+    /* Facteurs 2 et partie impaire de n + 2 */
+    const int s = __builtin_ctz(n + 2);
+    const uint32_t diviseur = (n + 2) >> s;
+    /* Inverse du diviseur modulo 2^32 par la methode de Newton */
+    uint32_t inverse = diviseur;
+    for (int i = 0; i < 5; i++) inverse *= 2 - diviseur * inverse;
+
+    /* Retenue de la multiplication et emprunt de la division exacte */
+    uint64_t retenue = 0, emprunt = 0;
+    for (size_t i = 0; i <= precedent->n; i++) {
+        const uint64_t t =
+            (i < precedent->n ? coefficient1 * precedent->chiffres[i] : 0) +
+            (i < avantPrecedent->n ? coefficient2 * avantPrecedent->chiffres[i]
+                                   : 0) +
+            retenue;
+        retenue = t >> 32;
+        /* Chiffre i du quotient: le chiffre du produit moins ce que les
+         * chiffres plus faibles du quotient y ont deja mis */
+        const uint32_t chiffre = (uint32_t)t, difference =
+                                                  chiffre - (uint32_t)emprunt;
+        const uint32_t q = difference * inverse;
+        courant[i] = q;
+        emprunt = (difference > chiffre) + (((uint64_t)q * diviseur) >> 32);
+    }
+
+    size_t nCourant = precedent->n + 1;
+    if (s) {
+        for (size_t i = 0; i + 1 < nCourant; i++)
+            courant[i] = courant[i] >> s | courant[i + 1] << (32 - s);
+        courant[nCourant - 1] >>= s;
+    }
+
+    return normaliser(courant, nCourant);
+}
+
+/**
+ * Cette fonction calcule les termes de la suite de Motzkin jusqu'a un certain
+ * indice, en gardant seulement les deux derniers termes.
+ *
+ * nTerme : Indice du terme a calculer
+ *
+ * return : M_nTerme (a liberer avec free)
+ */
+struct grand Motzkin_exact(const uint32_t nTerme) {
+    /* Borne du nombre de chiffres: M_n < 3^n < 2^(1.585 n) */
+    const size_t capacite = (size_t)nTerme * 1585 / 32000 + 3;
+    struct grand termes[3];
+    for (int k = 0; k < 3; k++) {
+        termes[k].chiffres = malloc(capacite * sizeof(uint32_t));
+        if (!termes[k].chiffres) {
+            printf("Memoire insuffisante\n");
+            exit(1);
+        }
+        termes[k].chiffres[0] = 1;
+        termes[k].n = 1;
+    }
+
+    /* Indices de M_(n-2) et M_(n-1) dans termes, qui tournent */
+    int avantPrecedent = 0, precedent = 1;
+    for (uint32_t n = 2; n <= nTerme; n++) {
+        const int courant = 3 - precedent - avantPrecedent;
+        termes[courant].n =
+            Motzkin_suivant(termes[courant].chiffres, &termes[precedent],
+                            &termes[avantPrecedent], n);
+        avantPrecedent = precedent;
+        precedent = courant;
+    }
+
+    for (int k = 0; k < 3; k++)
+        if (k != precedent) free(termes[k].chiffres);
+    return termes[precedent];
+}
+
+/**
+ * Cette fonction trouve une borne du nombre de chiffres en base 10^9 d'un
+ * nombre de n chiffres en base 2^32 (32 log10(2) / 9 < 1 + 1 / 14).
+ *
+ * n : Nombre de chiffres en base 2^32
+ *
+ * return : Borne du nombre de chiffres en base 10^9
+ */
+size_t taille_decimale(const size_t n) { return n + n / 14 + 3; }
+
+/**
+ * Cette fonction convertit un nombre en base 10^9 chiffre par chiffre, avec la
+ * methode de Horner (d = d * 2^32 + a_i a partir du poids fort), en O(n^2).
+ *
+ * decimal : Chiffres en base 10^9 (taille_decimale(n) chiffres)
+ * a, n : Nombre en base 2^32 et son nombre de chiffres
+ *
+ * return : Nombre de chiffres en base 10^9
+ */
+size_t convertir_naif(uint32_t decimal[], const uint32_t a[], const size_t n) {
+    size_t nDecimal = 0;
+
+    for (size_t i = n; i-- > 0;) {
+        uint64_t retenue = a[i];
+        for (size_t j = 0; j < nDecimal; j++) {
+            const uint64_t t = ((uint64_t)decimal[j] << 32) + retenue;
+            decimal[j] = (uint32_t)(t % BASE_DECIMALE);
+            retenue = t / BASE_DECIMALE;
+        }
+        for (; retenue; retenue /= BASE_DECIMALE)
+            decimal[nDecimal++] = (uint32_t)(retenue % BASE_DECIMALE);
+    }
+
+    return nDecimal;
+}
+
+/**
+ * Cette fonction convertit les puissances de 2^32 utilisees par la conversion
+ * rapide: la k-ieme est 2^(32 * SEUIL_CONVERSION * 2^k), calculee en base
+ * 10^9 en elevant la precedente au carre.
+ *
+ * puissances : Tableau des puissances a remplir
+ * n : Nombre de chiffres en base 2^32 du plus grand nombre a convertir
+ *
+ * return : Nombre de puissances calculees
+ */
+int convertir_puissances(struct grand puissances[], const size_t n) {
+    int nPuissances = 0;
+
+    for (size_t m = SEUIL_CONVERSION; m < n && nPuissances < N_PUISSANCES_MAX;
+         m *= 2, nPuissances++) {
+        struct grand* puissance = &puissances[nPuissances];
+        /* Le carre de la puissance precedente a au plus deux fois ses
+         * chiffres */
+        const size_t capacite = nPuissances
+                                    ? 2 * puissances[nPuissances - 1].n
+                                    : taille_decimale(SEUIL_CONVERSION + 1);
+        puissance->chiffres = malloc(capacite * sizeof(uint32_t));
+        if (!puissance->chiffres) {
+            printf("Memoire insuffisante\n");
+            exit(1);
+        }
+        if (!nPuissances) {
+            /* 2^(32 * SEUIL_CONVERSION) */
+            uint32_t unite[SEUIL_CONVERSION + 1] = {0};
+            unite[SEUIL_CONVERSION] = 1;
+            puissance->n = convertir_naif(puissance->chiffres, unite,
+                                          SEUIL_CONVERSION + 1);
+        } else {
+            const struct grand* moitie = &puissances[nPuissances - 1];
+            multiplier(puissance->chiffres, moitie->chiffres, moitie->n,
+                       moitie->chiffres, moitie->n, BASE_DECIMALE);
+            puissance->n = normaliser(puissance->chiffres, 2 * moitie->n);
+        }
+    }
+
+    return nPuissances;
+}
+
+/**
+ * Cette fonction convertit un nombre en base 10^9 en le coupant en deux: si a
+ * = haut * 2^(32m) + bas, la conversion de a est celle de haut multipliee par
+ * celle de 2^(32m), plus celle de bas. Avec la multiplication par NTT, cela
+ * coute O(n log^2 n) operations.
+ *
+ * decimal : Chiffres en base 10^9 (taille_decimale(n) chiffres)
+ * a, n : Nombre en base 2^32 et son nombre de chiffres
+ * puissances : Puissances de 2^32 converties par convertir_puissances
+ *
+ * return : Nombre de chiffres en base 10^9
+ */
+size_t convertir_rapide(uint32_t decimal[], const uint32_t a[], size_t n,
+                        const struct grand puissances[]) {
+    n = normaliser(a, n);
+    if (n <= SEUIL_CONVERSION) return convertir_naif(decimal, a, n);
+
+    /* Nombre de chiffres de bas, la plus grande puissance de 2 fois
+     * SEUIL_CONVERSION plus petite que n */
+    size_t m = SEUIL_CONVERSION;
+    int k = 0;
+    for (; 2 * m < n; m *= 2) k++;
+
+    uint32_t* bas = malloc((taille_decimale(m) + taille_decimale(n - m)) *
+                           sizeof *bas);
+    if (!bas) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+    uint32_t* haut = bas + taille_decimale(m);
+    const size_t nBas = convertir_rapide(bas, a, m, puissances);
+    const size_t nHaut = convertir_rapide(haut, a + m, n - m, puissances);
+
+    /* bas < 2^(32m), donc il a au plus autant de chiffres que la puissance */
+    multiplier(decimal, haut, nHaut, puissances[k].chiffres, puissances[k].n,
+               BASE_DECIMALE);
+    const size_t nDecimal = nHaut + puissances[k].n;
+    additionner(decimal, decimal, nDecimal, bas, nBas, BASE_DECIMALE);
+
+    free(bas);
+    return normaliser(decimal, nDecimal);
+}
+
+/**
+ * Cette fonction ecrit un nombre en base 10^9 en caracteres decimaux.
+ *
+ * texte : Chaine d'au moins 9 * n + 1 caracteres
+ * decimal, n : Nombre en base 10^9 et son nombre de chiffres
+ *
+ * return : Nombre de caracteres ecrits
+ */
+size_t ecrire_decimal(char texte[], const uint32_t decimal[], const size_t n) {
+    if (!n) return (size_t)sprintf(texte, "0");
+
+    size_t longueur = (size_t)sprintf(texte, "%u", decimal[n - 1]);
+    for (size_t i = n - 1; i-- > 0;) {
+        /* Chiffres du chiffre i, zeros de tete compris */
+        uint32_t chiffre = decimal[i];
+        for (int j = N_CHIFFRES_BASE_DECIMALE - 1; j >= 0; j--) {
+            texte[longueur + j] = (char)('0' + chiffre % 10);
+            chiffre /= 10;
+        }
+        longueur += N_CHIFFRES_BASE_DECIMALE;
+    }
+    texte[longueur] = '\0';
+
+    return longueur;
+}
+
+/**
+ * Cette fonction ecrit un nombre en base 2^32 en caracteres decimaux avec la
+ * conversion rapide.
+ *
+ * a : Nombre a ecrire
+ * longueur : Nombre de caracteres ecrits (ignore si NULL)
+ *
+ * return : Chaine de caracteres (a liberer avec free)
+ */
+char* texte_decimal(const struct grand* a, size_t* longueur) {
+    struct grand puissances[N_PUISSANCES_MAX];
+    const int nPuissances = convertir_puissances(puissances, a->n);
+
+    uint32_t* decimal = malloc(taille_decimale(a->n) * sizeof *decimal);
+    char* texte = malloc(N_CHIFFRES_BASE_DECIMALE * taille_decimale(a->n) + 1);
+    if (!decimal || !texte) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+    const size_t nDecimal = convertir_rapide(decimal, a->chiffres, a->n,
+                                             puissances);
+    const size_t n = ecrire_decimal(texte, decimal, nDecimal);
+    if (longueur) *longueur = n;
+
+    for (int k = 0; k < nPuissances; k++) free(puissances[k].chiffres);
+    free(decimal);
+    return texte;
+}
+
+/**
+ * Cette fonction calcule la suite de Motzkin de maniere iterative en double,
+ * comme Motzkin_iteratif1 dans TP4A.
+ *
+ * nTerme : Numero du terme a calculer
+ *
+ * return : Nombre de Motzkin d'indice nTerme
+ */
+double Motzkin_double(const int nTerme) {
+    /* Le dernier terme et l'avant-dernier terme calcules */
+    double dernier = 1, avantDernier = 1;
+
+    for (int i = 2; i <= nTerme; i++) {
+        const double courant = (2 * i + 1) / (i + 2.0) * dernier +
+                               (3 * i - 3) / (i + 2.0) * avantDernier;
+        avantDernier = dernier;
+        dernier = courant;
+    }
+
+    return dernier;
+}
+
+/**
+ * Cette fonction cherche le premier terme calcule en double qui n'est pas
+ * exact et l'affiche avec le terme exact.
+ */
+void comparer_double(void) {
+    for (int n = 0; n < N_TERMES_DOUBLE; n++) {
+        struct grand exact = Motzkin_exact(n);
+        char* texte = texte_decimal(&exact, NULL);
+        char approximation[64];
+        sprintf(approximation, "%.0f", Motzkin_double(n));
+
+        const int different = strcmp(texte, approximation);
+        if (different) {
+            printf("Premier terme inexact en double : M%d\n", n);
+            printf("Exact     : %s\nEn double : %s\n\n", texte, approximation);
+        }
+        free(texte);
+        free(exact.chiffres);
+        if (different) return;
+    }
+
+    printf("Les %d premiers termes en double sont exacts\n\n",
+           N_TERMES_DOUBLE);
+}
+
+/**
+ * Cette fonction verifie un terme avec la recurrence de convolution
+ * M_n = M_(n-1) + Somme(M_i * M_(n-2-i)), avec i allant de 0 a n-2, en
+ * multipliant les termes exacts (la somme est symetrique, donc on n'en calcule
+ * que la moitie).
+ *
+ * nTerme : Indice du terme a verifier, au moins 2
+ *
+ * return : 1 si les deux recurrences donnent le meme terme, 0 sinon
+ */
+int verifier_convolution(const uint32_t nTerme) {
+    /* Tous les termes jusqu'a nTerme, par la recurrence a trois termes */
+    struct grand* termes = malloc((nTerme + 1) * sizeof *termes);
+    const size_t capacite = (size_t)nTerme * 1585 / 32000 + 3;
+    /* Somme de la convolution et produit courant */
+    uint32_t* somme = calloc(2 * capacite + 1, sizeof *somme);
+    uint32_t* produit = malloc(2 * capacite * sizeof *produit);
+    if (!termes || !somme || !produit) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+    for (uint32_t n = 0; n <= nTerme; n++) {
+        termes[n].chiffres = malloc(capacite * sizeof(uint32_t));
+        if (!termes[n].chiffres) {
+            printf("Memoire insuffisante\n");
+            exit(1);
+        }
+        termes[n].chiffres[0] = 1;
+        termes[n].n = 1;
+        if (n >= 2)
+            termes[n].n = Motzkin_suivant(termes[n].chiffres, &termes[n - 1],
+                                          &termes[n - 2], n);
+    }
+
+    const uint32_t limiteSomme = nTerme - 2;
+    for (uint32_t i = 0; i <= limiteSomme / 2; i++) {
+        const struct grand *a = &termes[i], *b = &termes[limiteSomme - i];
+        multiplier(produit, a->chiffres, a->n, b->chiffres, b->n,
+                   BASE_BINAIRE);
+        const size_t nProduit = normaliser(produit, a->n + b->n);
+        /* Les termes symetriques comptent deux fois */
+        for (int fois = 2 * i == limiteSomme ? 1 : 2; fois; fois--)
+            additionner(somme, somme, 2 * capacite + 1, produit, nProduit,
+                        BASE_BINAIRE);
+    }
+    additionner(somme, somme, 2 * capacite + 1, termes[nTerme - 1].chiffres,
+                termes[nTerme - 1].n, BASE_BINAIRE);
+
+    const int egal =
+        normaliser(somme, 2 * capacite + 1) == termes[nTerme].n &&
+        !memcmp(somme, termes[nTerme].chiffres,
+                termes[nTerme].n * sizeof(uint32_t));
+
+    for (uint32_t n = 0; n <= nTerme; n++) free(termes[n].chiffres);
+    free(termes);
+    free(somme);
+    free(produit);
+    return egal;
+}
+
+/**
+ * Cette fonction donne le temps ecoule depuis un instant donne.
+ *
+ * debut : Instant de depart
+ *
+ * return : Temps ecoule en secondes
+ */
+double secondes_depuis(const struct timespec* debut) {
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (fin.tv_sec - debut->tv_sec) + (fin.tv_nsec - debut->tv_nsec) * 1e-9;
+}
+
+/**
+ * Cette fonction calcule un grand terme, mesure le temps du calcul et des deux
+ * conversions en decimal, et affiche le debut et la fin du terme.
+ *
+ * nTerme : Indice du terme
+ */
+void mesurer(const uint32_t nTerme) {
+    struct timespec debut;
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    struct grand terme = Motzkin_exact(nTerme);
+    const double tempsCalcul = secondes_depuis(&debut);
+
+    uint32_t* decimal = malloc(taille_decimale(terme.n) * sizeof *decimal);
+    if (!decimal) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    const size_t nNaif = convertir_naif(decimal, terme.chiffres, terme.n);
+    const double tempsNaif = secondes_depuis(&debut);
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    size_t longueur;
+    char* texte = texte_decimal(&terme, &longueur);
+    const double tempsRapide = secondes_depuis(&debut);
+
+    /* Les deux conversions doivent donner les memes chiffres */
+    char* texteNaif = malloc(N_CHIFFRES_BASE_DECIMALE * nNaif + 1);
+    if (!texteNaif) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+    ecrire_decimal(texteNaif, decimal, nNaif);
+
+    printf("%7u %9zu %12.4f %12.4f %12.4f  %.*s...%s%s\n", nTerme, longueur,
+           tempsCalcul, tempsNaif, tempsRapide, N_CHIFFRES_AFFICHES, texte,
+           texte + longueur - N_CHIFFRES_AFFICHES,
+           strcmp(texte, texteNaif) ? " (conversions differentes)" : "");
+
+    free(texteNaif);
+    free(texte);
+    free(decimal);
+    free(terme.chiffres);
+}
+
+int main(int argc, char* argv[]) {
+    initialiser_premiers();
+
+    if (argc > 1) {
+        /* Fin du nombre lu, qui doit etre la fin de l'argument */
+        char* fin;
+        const long nTerme = strtol(argv[1], &fin, 10);
+        if (argc > 2 || fin == argv[1] || *fin || nTerme < 0 ||
+            nTerme > N_MAX) {
+            printf("Utilisation : %s [n], avec un indice n entier entre 0 et "
+                   "%d\n",
+                   argv[0], N_MAX);
+            return 1;
+        }
+        struct grand terme = Motzkin_exact((uint32_t)nTerme);
+        char* texte = texte_decimal(&terme, NULL);
+        printf("M%ld = %s\n", nTerme, texte);
+        free(texte);
+        free(terme.chiffres);
+        return 0;
+    }
+
+    comparer_double();
+
+    printf("Verification de M%d avec la recurrence de convolution : %s\n\n",
+           N_VERIFICATION,
+           verifier_convolution(N_VERIFICATION) ? "identique" : "different");
+
+    /* Indices des grands termes mesures */
+    const uint32_t indices[] = {1000, 10000, 100000, 300000};
+    printf("      n  Chiffres  Calcul (s)  Conv. naive  Conv. rapide  "
+           "Chiffres de M_n\n");
+    for (size_t i = 0; i < sizeof indices / sizeof indices[0]; i++)
+        mesurer(indices[i]);
+
+    return 0;
+}
+
+/*
+Premier terme inexact en double : M39
+Exact     : 22944749046030949
+En double : 22944749046030948
+
+Verification de M2000 avec la recurrence de convolution : identique
+
+      n  Chiffres  Calcul (s)  Conv. naive  Conv. rapide  Chiffres de M_n
+   1000       473       0.0001       0.0000       0.0000  61132765976771855043...93770266157466468457
+  10000      4766       0.0101       0.0004       0.0004  23906626534306007992...88620360778322036227
+ 100000     47705       0.9658       0.0361       0.0171  61878293842705385256...94193193424866467713
+ 300000    143129       8.7447       0.3377       0.0615  21223032449188224842...52515340068170877473
+*/
@@ -0,0 +1,940 @@
+/**
+ * Auteur : Nicolas Levasseur
+ *
+ * Ce programme calcule les nombres de Motzkin modulo un premier p pour des
+ * indices astronomiques (10^12 et plus), sans calculer les termes precedents.
+ *
+ * La recurrence de Motzkin_iteratif1 dans TP4A, (n + 2) M_n = (2n + 1) M_(n-1)
+ * + (3n - 3) M_(n-2), s'ecrit comme un produit de matrices 2 x 2 dont les
+ * entrees sont des polynomes de degre 1 en n. Avec s = racine de n, on calcule
+ * les valeurs du produit de s matrices consecutives en s points espaces de s
+ * (pas de bebe), par doublement et interpolation de Lagrange, puis on multiplie
+ * ces s matrices (pas de geant): cela coute O(racine(n) log n) operations au
+ * lieu de O(n). La recurrence divise par n + 2, donc elle ne s'applique que
+ * pour n < p - 2.
+ *
+ * Pour n >= p, on utilise M_n = terme constant de (1/x + 1 + x)^n (1 - x^2).
+ * Modulo p, (1/x + 1 + x)^p = 1/x^p + 1 + x^p, donc en ecrivant n en base p,
+ * M_n ne depend que de M_(n0) pour le chiffre n0 des unites et de coefficients
+ * trinomiaux des autres chiffres (comme le theoreme de Lucas pour les
+ * coefficients binomiaux). Les coefficients trinomiaux centraux suivent eux
+ * aussi une recurrence a coefficients polynomiaux, evaluee par pas de bebe et
+ * pas de geant, donc M_n mod p coute O(log(n) / log(p) * racine(p) log p).
+ *
+ * Les produits de polynomes de l'interpolation sont calcules par transformee
+ * de Fourier modulo trois premiers (NTT), ce qui limite p a 2^30.
+ *
+ * Utilisation : MotzkinModulaire [n p]...
+ * Les requetes (n, p) sont reparties entre plusieurs fils d'execution. Sans
+ * argument, le programme verifie les resultats et traite une liste de
+ * requetes par defaut.
+ *
+ * Compilation : gcc MotzkinModulaire.c -o MotzkinModulaire -pthread
+ */
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Plus grand premier accepte (exclus), pour que les produits de polynomes
+ * modulo p soient exacts avec trois premiers de NTT */
+#define P_MAX (1u << 30)
+/* Nombre de premiers de la NTT */
+#define N_PREMIERS_NTT 3
+/* Nombre de pas sous lequel on applique la recurrence pas a pas */
+#define SEUIL_PAS_A_PAS 1024
+/* Taille sous laquelle les produits de polynomes sont calcules directement */
+#define SEUIL_CONVOLUTION 32
+/* Entrees d'une matrice 2 x 2 et son denominateur */
+#define N_COMPOSANTES 5
+/* Nombre maximal de fils d'execution */
+#define N_FILS_MAX 64
+/* Nombre de termes verifies avec la recurrence de convolution */
+#define N_VERIFICATION 2000
+/* Indice verifie avec la recurrence pas a pas */
+#define N_PAS_A_PAS 100000000
+
+/**
+ * Polynome de degre 1 en i: c1 * i + c0.
+ */
+struct lineaire {
+    int64_t c1, c0;
+};
+
+/**
+ * Suite definie par u_0 = u_1 = 1 et
+ * u_i = (alpha(i) u_(i-1) + beta(i) u_(i-2)) / gamma(i).
+ */
+struct recurrence {
+    struct lineaire alpha, beta, gamma;
+};
+
+/* Nombres de Motzkin: (i + 2) M_i = (2i + 1) M_(i-1) + (3i - 3) M_(i-2) */
+static const struct recurrence Motzkin = {{2, 1}, {3, -3}, {1, 2}};
+/* Coefficients trinomiaux centraux (terme constant de (1/x + 1 + x)^i):
+ * i T_i = (2i - 1) T_(i-1) + (3i - 3) T_(i-2) */
+static const struct recurrence trinomes = {{2, -1}, {3, -3}, {1, 0}};
+
+/**
+ * Un premier de la NTT, avec les constantes de sa multiplication de
+ * Montgomery (les residus a sont gardes sous la forme a * 2^32 mod q).
+ */
+struct premier {
+    uint32_t q, racine;
+    /* -1 / q mod 2^32 et 2^64 mod q */
+    uint32_t qInverse, r2;
+};
+
+/* Premiers de la forme c * 2^k + 1 (k >= 23), avec 3 comme racine primitive */
+static struct premier premiers[N_PREMIERS_NTT] = {
+    {998244353, 3, 0, 0}, {167772161, 3, 0, 0}, {469762049, 3, 0, 0}};
+
+/**
+ * Calculs modulo p: le premier et les inverses des factorielles utilises par
+ * l'interpolation de Lagrange.
+ */
+struct modulo {
+    uint32_t p;
+    uint32_t* inversesFactorielles;
+};
+
+/**
+ * Requete d'un calcul de M_n mod p, avec son resultat et son temps de calcul.
+ */
+struct requete {
+    uint64_t n;
+    uint32_t p, resultat;
+    double temps;
+};
+
+/**
+ * Cette fonction calcule une puissance modulaire.
+ *
+ * base : Base, plus petite que le module
+ * exposant : Exposant
+ * module : Module, plus petit que 2^32
+ *
+ * return : base^exposant mod module
+ */
+uint32_t puissance_modulaire(uint64_t base, uint64_t exposant,
+                             const uint32_t module) {
+    uint64_t resultat = 1 % module;
+
+    for (; exposant; exposant >>= 1) {
+        if (exposant & 1) resultat = resultat * base % module;
+        base = base * base % module;
+    }
+
+    return (uint32_t)resultat;
+}
+
+/**
+ * Cette fonction calcule l'inverse d'un entier modulo un premier avec le petit
+ * theoreme de Fermat.
+ *
+ * a : Entier non nul modulo p
+ * p : Premier
+ *
+ * return : 1 / a mod p
+ */
+uint32_t inverse_modulaire(const uint32_t a, const uint32_t p) {
+    return puissance_modulaire(a % p, p - 2, p);
+}
+
+/**
+ * Cette fonction evalue un polynome de degre 1 modulo p.
+ *
+ * polynome : Polynome
+ * x : Point ou evaluer, plus petit que p
+ * p : Premier
+ *
+ * return : polynome(x) mod p
+ */
+uint32_t evaluer(const struct lineaire* polynome, const uint64_t x,
+                 const uint32_t p) {
+    const int64_t c1 = polynome->c1 % p + p, c0 = polynome->c0 % p + p;
+    return (uint32_t)((c1 * x + c0) % p);
+}
+
+/**
+ * Cette fonction multiplie deux residus sous forme de Montgomery.
+ *
+ * a, b : Residus sous forme de Montgomery
+ * premier : Premier et ses constantes
+ *
+ * return : Produit sous forme de Montgomery
+ */
+static inline uint32_t multiplier_Montgomery(const uint32_t a, const uint32_t b,
+                                             const struct premier* premier) {
+    const uint64_t t = (uint64_t)a * b;
+    const uint32_t m = (uint32_t)t * premier->qInverse;
+    const uint32_t u = (uint32_t)((t + (uint64_t)m * premier->q) >> 32);
+    return u >= premier->q ? u - premier->q : u;
+}
+
+/**
+ * Cette fonction calcule les constantes de Montgomery des premiers de la NTT.
+ */
+void initialiser_premiers(void) {
+    for (int k = 0; k < N_PREMIERS_NTT; k++) {
+        const uint32_t q = premiers[k].q;
+        /* Inverse de q modulo 2^32 par la methode de Newton (chaque iteration
+         * double le nombre de bits exacts) */
+        uint32_t inverse = q;
+        for (int i = 0; i < 5; i++) inverse *= 2 - q * inverse;
+        premiers[k].qInverse = -inverse;
+        const uint64_t r = (1ull << 32) % q;
+        premiers[k].r2 = (uint32_t)(r * r % q);
+    }
+}
+
+/**
+ * Cette fonction calcule la transformee d'un tableau de residus sous forme de
+ * Montgomery en place. La transformee directe (decimation en frequence) donne
+ * les indices aux bits inverses et la transformee inverse (decimation en
+ * temps) les reprend dans cet ordre, ce qui evite la permutation. La
+ * transformee inverse n'est pas divisee par n.
+ *
+ * a : Residus, remplaces par leur transformee
+ * n : Taille, une puissance de 2
+ * inverse : 1 pour la transformee inverse, 0 sinon
+ * premier : Premier et ses constantes
+ * racines : Tableau de n / 2 residus pour les racines de l'unite
+ */
+void NTT(uint32_t a[], const size_t n, const int inverse,
+         const struct premier* premier, uint32_t racines[]) {
+    const uint32_t q = premier->q;
+    /* Racine primitive d'ordre n de l'unite (ou son inverse), sous forme de
+     * Montgomery */
+    const uint32_t racine = multiplier_Montgomery(
+        puissance_modulaire(premier->racine,
+                            inverse ? q - 1 - (q - 1) / n : (q - 1) / n, q),
+        premier->r2, premier);
+
+    /* Puissances de la racine d'ordre n; celle d'ordre 2m est racines[n/2m] */
+    racines[0] = multiplier_Montgomery(1, premier->r2, premier);
+    for (size_t j = 1; j < n / 2; j++)
+        racines[j] = multiplier_Montgomery(racines[j - 1], racine, premier);
+
+    for (size_t m = inverse ? 1 : n / 2; inverse ? m < n : m > 0;
+         m = inverse ? 2 * m : m / 2)
+        for (size_t i = 0; i < n; i += 2 * m)
+            for (size_t j = 0; j < m; j++) {
+                const uint32_t w = racines[j * (n / (2 * m))];
+                uint32_t u = a[i + j], v = a[i + j + m];
+                if (inverse) v = multiplier_Montgomery(v, w, premier);
+                const uint32_t somme = u + v >= q ? u + v - q : u + v;
+                const uint32_t difference = u >= v ? u - v : u + q - v;
+                a[i + j] = somme;
+                a[i + j + m] = inverse ? difference
+                                       : multiplier_Montgomery(difference, w,
+                                                               premier);
+            }
+}
+
+/**
+ * Cette fonction multiplie plusieurs polynomes par un meme polynome modulo p.
+ * Les coefficients des produits sont reconstruits exactement a partir de leurs
+ * restes modulo les trois premiers de la NTT (algorithme de Garner), puis
+ * reduits modulo p. La transformee du facteur commun n'est calculee qu'une
+ * fois par premier.
+ *
+ * produits : Produits a remplir (na + nb - 1 coefficients chacun)
+ * facteurs : Polynomes de na coefficients
+ * nFacteurs : Nombre de polynomes
+ * na : Nombre de coefficients des polynomes
+ * commun, nb : Facteur commun et son nombre de coefficients
+ * p : Premier, plus petit que P_MAX
+ */
+void multiplier_polynomes(uint32_t* produits[], uint32_t* const facteurs[],
+                          const int nFacteurs, const size_t na,
+                          const uint32_t commun[], const size_t nb,
+                          const uint32_t p) {
+    const size_t nProduit = na + nb - 1;
+
+    if (na < SEUIL_CONVOLUTION || nb < SEUIL_CONVOLUTION) {
+        for (int f = 0; f < nFacteurs; f++)
+            for (size_t k = 0; k < nProduit; k++) {
+                uint64_t somme = 0;
+                const size_t iDebut = k >= nb ? k - nb + 1 : 0;
+                for (size_t i = iDebut; i < na && i <= k; i++)
+                    somme = (somme + (uint64_t)facteurs[f][i] * commun[k - i]) %
+                            p;
+                produits[f][k] = (uint32_t)somme;
+            }
+        return;
+    }
+
+    size_t taille = 1;
+    while (taille < nProduit) taille <<= 1;
+    /* Residus des produits pour chaque premier, transformee du facteur commun
+     * et racines de l'unite */
+    uint32_t* residus =
+        malloc(((size_t)nFacteurs * N_PREMIERS_NTT + 1) * taille * 3 / 2 *
+               sizeof *residus);
+    if (!residus) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+    uint32_t* transformee =
+        residus + (size_t)nFacteurs * N_PREMIERS_NTT * taille;
+    uint32_t* racines = transformee + taille;
+
+    for (int k = 0; k < N_PREMIERS_NTT; k++) {
+        const struct premier* premier = &premiers[k];
+        for (size_t i = 0; i < taille; i++)
+            transformee[i] = i < nb ? multiplier_Montgomery(
+                                          commun[i] % premier->q, premier->r2,
+                                          premier)
+                                    : 0;
+        NTT(transformee, taille, 0, premier, racines);
+        /* 1 / taille, pour la transformee inverse, et retour a la forme
+         * ordinaire en meme temps */
+        const uint32_t facteur =
+            inverse_modulaire((uint32_t)taille, premier->q);
+
+        for (int f = 0; f < nFacteurs; f++) {
+            uint32_t* residu =
+                residus + ((size_t)f * N_PREMIERS_NTT + k) * taille;
+            for (size_t i = 0; i < taille; i++)
+                residu[i] = i < na ? multiplier_Montgomery(
+                                         facteurs[f][i] % premier->q,
+                                         premier->r2, premier)
+                                   : 0;
+            NTT(residu, taille, 0, premier, racines);
+            for (size_t i = 0; i < taille; i++)
+                residu[i] = multiplier_Montgomery(residu[i], transformee[i],
+                                                  premier);
+            NTT(residu, taille, 1, premier, racines);
+            for (size_t i = 0; i < nProduit; i++)
+                residu[i] = multiplier_Montgomery(residu[i], facteur, premier);
+        }
+    }
+
+    /* Constantes de Garner */
+    const uint64_t q0 = premiers[0].q, q1 = premiers[1].q, q2 = premiers[2].q;
+    const uint64_t inverseQ0 = inverse_modulaire((uint32_t)(q0 % q1), q1);
+    const uint64_t inverseQ0Q1 =
+        inverse_modulaire((uint32_t)(q0 * q1 % q2), q2);
+    const uint64_t q0q1ModuloP = q0 * q1 % p;
+
+    for (int f = 0; f < nFacteurs; f++) {
+        const uint32_t* residu = residus + (size_t)f * N_PREMIERS_NTT * taille;
+        for (size_t i = 0; i < nProduit; i++) {
+            const uint64_t r0 = residu[i], r1 = residu[taille + i],
+                           r2 = residu[2 * taille + i];
+            /* x = r0 + q0 * t1 + q0 * q1 * t2, avec t1 < q1 et t2 < q2 */
+            const uint64_t t1 = (r1 + q1 - r0 % q1) % q1 * inverseQ0 % q1;
+            const uint64_t x01 = r0 + q0 * t1;
+            const uint64_t t2 = (r2 + q2 - x01 % q2) % q2 * inverseQ0Q1 % q2;
+            produits[f][i] = (uint32_t)((x01 % p + q0q1ModuloP * t2) % p);
+        }
+    }
+
+    free(residus);
+}
+
+/**
+ * Cette fonction decale des echantillons de polynomes: a partir des valeurs
+ * g(0), g(1), ..., g(d) de polynomes g de degre d au plus, elle calcule
+ * g(a), g(a + 1), ..., g(a + d) par interpolation de Lagrange. Ecrite avec
+ * x_t = a - d + t, la formule
+ *     g(a + k) = Produit(x_(k+j), j = 0..d) *
+ *                Somme(g(i) / (i! (d - i)! (-1)^(d-i)) / x_(k+d-i), i = 0..d)
+ * est une convolution, calculee avec un seul produit de polynomes. Les x_t
+ * doivent etre non nuls modulo p.
+ *
+ * sorties : Valeurs decalees (d + 1 valeurs par composante)
+ * entrees : Echantillons (d + 1 valeurs par composante)
+ * d : Degre des polynomes
+ * a : Decalage, modulo p
+ * modulo : Premier et inverses des factorielles jusqu'a d
+ */
+void decaler(uint32_t* sorties[], uint32_t* const entrees[], const size_t d,
+             const uint32_t a, const struct modulo* modulo) {
+    const uint32_t p = modulo->p;
+    /* Poids de Lagrange, inverses des x_t et produits de convolution, pour
+     * toutes les composantes */
+    uint32_t* memoire = malloc((N_COMPOSANTES * (d + 1) + 2 * (2 * d + 1) +
+                                N_COMPOSANTES * (3 * d + 1)) *
+                               sizeof *memoire);
+    if (!memoire) {
+        printf("Memoire insuffisante\n");
+        exit(1);
+    }
+    uint32_t *poids[N_COMPOSANTES], *produits[N_COMPOSANTES];
+    uint32_t* inverses = memoire + N_COMPOSANTES * (d + 1);
+    uint32_t* prefixes = inverses + 2 * d + 1;
+    for (int c = 0; c < N_COMPOSANTES; c++) {
+        poids[c] = memoire + c * (d + 1);
+        produits[c] = prefixes + 2 * d + 1 + c * (3 * d + 1);
+    }
+
+    for (size_t i = 0; i <= d; i++) {
+        uint64_t facteur = (uint64_t)modulo->inversesFactorielles[i] *
+                           modulo->inversesFactorielles[d - i] % p;
+        if ((d - i) & 1) facteur = (p - facteur) % p;
+        for (int c = 0; c < N_COMPOSANTES; c++)
+            poids[c][i] = (uint32_t)(entrees[c][i] * facteur % p);
+    }
+
+    /* Inverses des x_t avec une seule inversion: on inverse le produit de
+     * tous les x_t, puis on remonte les produits partiels */
+    const uint64_t x0 = ((uint64_t)a + p - d % p) % p;
+    uint64_t produit = 1;
+    for (size_t t = 0; t <= 2 * d; t++) {
+        prefixes[t] = (uint32_t)produit;
+        produit = produit * ((x0 + t) % p) % p;
+    }
+    uint64_t inverse = inverse_modulaire((uint32_t)produit, p);
+    for (size_t t = 2 * d + 1; t-- > 0;) {
+        inverses[t] = (uint32_t)(inverse * prefixes[t] % p);
+        inverse = inverse * ((x0 + t) % p) % p;
+    }
+
+    multiplier_polynomes(produits, poids, N_COMPOSANTES, d + 1, inverses,
+                         2 * d + 1, p);
+
+    /* Produit glissant des x_(k+j), j = 0..d */
+    uint64_t glissant = 1;
+    for (size_t t = 0; t <= d; t++) glissant = glissant * ((x0 + t) % p) % p;
+    for (size_t k = 0; k <= d; k++) {
+        if (k)
+            glissant = glissant * ((x0 + k + d) % p) % p * inverses[k - 1] % p;
+        for (int c = 0; c < N_COMPOSANTES; c++)
+            sorties[c][k] = (uint32_t)(glissant * produits[c][d + k] % p);
+    }
+
+    free(memoire);
+}
+
+/**
+ * Cette fonction multiplie a gauche les matrices echantillonnees (et leurs
+ * denominateurs) par d'autres matrices echantillonnees: e[k] = g[k] * e[k].
+ *
+ * echantillons : Matrices a multiplier, remplacees par les produits
+ * gauches : Matrices de gauche
+ * iDebut, iFin : Indices des echantillons a multiplier
+ * p : Premier
+ */
+void multiplier_echantillons(uint32_t* echantillons[],
+                             uint32_t* const gauches[], const size_t iDebut,
+                             const size_t iFin, const uint32_t p) {
+    for (size_t k = iDebut; k < iFin; k++) {
+        const uint64_t a00 = gauches[0][k], a01 = gauches[1][k],
+                       a10 = gauches[2][k], a11 = gauches[3][k];
+        const uint64_t b00 = echantillons[0][k], b01 = echantillons[1][k],
+                       b10 = echantillons[2][k], b11 = echantillons[3][k];
+        echantillons[0][k] = (uint32_t)((a00 * b00 + a01 * b10) % p);
+        echantillons[1][k] = (uint32_t)((a00 * b01 + a01 * b11) % p);
+        echantillons[2][k] = (uint32_t)((a10 * b00 + a11 * b10) % p);
+        echantillons[3][k] = (uint32_t)((a10 * b01 + a11 * b11) % p);
+        echantillons[4][k] =
+            (uint32_t)((uint64_t)gauches[4][k] * echantillons[4][k] % p);
+    }
+}
+
+/**
+ * Cette fonction multiplie a gauche un vecteur (u_(i-1), u_(i-2)) par la
+ * matrice de la recurrence a l'indice i, et le denominateur par gamma(i).
+ *
+ * recurrence : Recurrence
+ * i : Indice, modulo p
+ * vecteur : Vecteur a multiplier
+ * denominateur : Denominateur a multiplier
+ * p : Premier
+ */
+void pas_recurrence(const struct recurrence* recurrence, const uint64_t i,
+                    uint64_t vecteur[2], uint64_t* denominateur,
+                    const uint32_t p) {
+    const uint64_t gamma = evaluer(&recurrence->gamma, i, p);
+    const uint64_t u = (evaluer(&recurrence->alpha, i, p) * vecteur[0] +
+                        evaluer(&recurrence->beta, i, p) * vecteur[1]) %
+                       p;
+    vecteur[1] = gamma * vecteur[0] % p;
+    vecteur[0] = u;
+    *denominateur = *denominateur * gamma % p;
+}
+
+/**
+ * Cette fonction calcule les matrices de la recurrence (et leurs
+ * denominateurs) aux indices x_k + decalage, ou x_k = depart + k * pas.
+ *
+ * echantillons : Composantes a remplir
+ * recurrence : Recurrence
+ * iDebut, iFin : Indices k des echantillons a remplir
+ * decalage : Decalage de l'indice par rapport au point x_k
+ * depart, pas : Points x_k = depart + k * pas
+ * p : Premier
+ */
+void echantillonner_matrice(uint32_t* echantillons[],
+                            const struct recurrence* recurrence,
+                            const size_t iDebut, const size_t iFin,
+                            const uint64_t decalage, const uint64_t depart,
+                            const uint64_t pas, const uint32_t p) {
+    for (size_t k = iDebut; k < iFin; k++) {
+        const uint64_t i = (depart + k * pas + decalage) % p;
+        echantillons[0][k] = evaluer(&recurrence->alpha, i, p);
+        echantillons[1][k] = evaluer(&recurrence->beta, i, p);
+        echantillons[2][k] = echantillons[4][k] =
+            evaluer(&recurrence->gamma, i, p);
+        echantillons[3][k] = 0;
+    }
+}
+
+/**
+ * Cette fonction calcule u_n et u_(n-1) modulo p pour une recurrence a
+ * coefficients polynomiaux, avec n < p et gamma(i) non nul modulo p pour
+ * 2 <= i <= n.
+ *
+ * En notant A(i) la matrice de la recurrence et f_d(x) = A(x + d) ... A(x + 1)
+ * (une matrice de polynomes de degre d), on garde les valeurs de f_d aux
+ * points x_k = 1 + k s, k = 0..d. Le doublement f_2d(x) = f_d(x + d) f_d(x)
+ * demande f_d aux points x_k + d (decalage de d / s en k) et aux points
+ * suivants (decalage de d + 1), que l'on obtient par interpolation. On suit
+ * les bits de s, avec un pas direct f_(d+1)(x) = A(x + d + 1) f_d(x) pour
+ * chaque bit a 1. Les valeurs f_s(x_k) sont les produits de s matrices
+ * consecutives, qu'il reste a multiplier entre eux.
+ *
+ * recurrence : Recurrence
+ * n : Indice du terme a calculer
+ * p : Premier, plus grand que n
+ * termes : Tableau ou ecrire u_n et u_(n-1) (0 pour u_(-1))
+ */
+void evaluer_recurrence(const struct recurrence* recurrence, const uint64_t n,
+                        const uint32_t p, uint32_t termes[2]) {
+    /* Vecteur (u_i, u_(i-1)) multiplie par le produit des gamma(i) */
+    uint64_t vecteur[2] = {1 % p, (n ? 1 : 0) % p}, denominateur = 1 % p;
+    /* Nombre de matrices a multiplier (i = 2..n) */
+    const uint64_t nPas = n >= 2 ? n - 1 : 0;
+    /* Prochain indice a traiter pas a pas */
+    uint64_t i = 2;
+
+    if (nPas > SEUIL_PAS_A_PAS) {
+        /* Nombre de matrices par bloc, pour que s (s + 1) + s / 2 < p */
+        uint64_t s = 1;
+        while ((s + 1) * (s + 1) <= nPas / 2) s++;
+        /* Les echantillons vont jusqu'a k = 2s + 1 */
+        const size_t nEchantillons = 2 * s + 2;
+
+        struct modulo modulo = {p, malloc((s + 1) * sizeof(uint32_t))};
+        uint32_t* memoire =
+            malloc(3 * N_COMPOSANTES * nEchantillons * sizeof *memoire);
+        if (!modulo.inversesFactorielles || !memoire) {
+            printf("Memoire insuffisante\n");
+            exit(1);
+        }
+        uint64_t factorielle = 1;
+        for (uint64_t j = 1; j <= s; j++) factorielle = factorielle * j % p;
+        modulo.inversesFactorielles[s] =
+            inverse_modulaire((uint32_t)factorielle, p);
+        for (uint64_t j = s; j > 0; j--)
+            modulo.inversesFactorielles[j - 1] =
+                (uint32_t)((uint64_t)modulo.inversesFactorielles[j] * j % p);
+
+        /* Valeurs de f_d aux points x_k, aux points x_k + d, et espace pour
+         * les matrices A(x_k + d + 1) */
+        uint32_t *f[N_COMPOSANTES], *g[N_COMPOSANTES], *h[N_COMPOSANTES];
+        for (int c = 0; c < N_COMPOSANTES; c++) {
+            f[c] = memoire + c * nEchantillons;
+            g[c] = memoire + (N_COMPOSANTES + c) * nEchantillons;
+            h[c] = memoire + (2 * N_COMPOSANTES + c) * nEchantillons;
+        }
+
+        /* f_1(x_k) = A(x_k + 1) pour k = 0 et 1 */
+        uint64_t d = 1;
+        echantillonner_matrice(f, recurrence, 0, 2, 1, 1, s, p);
+        /* s / d, pour les decalages de d / s */
+        const uint32_t inverseS = inverse_modulaire((uint32_t)(s % p), p);
+
+        int bit = 63 - __builtin_clzll(s);
+        while (bit-- > 0) {
+            /* f_d aux points x_(d+1), ..., x_(2d+1) */
+            uint32_t *fSuite[N_COMPOSANTES], *gSuite[N_COMPOSANTES];
+            for (int c = 0; c < N_COMPOSANTES; c++) {
+                fSuite[c] = f[c] + d + 1;
+                gSuite[c] = g[c] + d + 1;
+            }
+            decaler(fSuite, f, d, (uint32_t)((d + 1) % p), &modulo);
+            /* f_d aux points x_k + d, soit k + d / s */
+            const uint32_t dSurS = (uint32_t)(d % p * inverseS % p);
+            decaler(g, f, d, dSurS, &modulo);
+            decaler(gSuite, f, d, (uint32_t)((dSurS + d + 1) % p), &modulo);
+            multiplier_echantillons(f, g, 0, 2 * d + 1, p);
+            d *= 2;
+
+            if (s >> bit & 1) {
+                /* f_d au point x_(d+1), calcule directement */
+                echantillonner_matrice(f, recurrence, d + 1, d + 2, 1, 1, s,
+                                       p);
+                for (uint64_t j = 2; j <= d; j++) {
+                    echantillonner_matrice(h, recurrence, d + 1, d + 2, j, 1,
+                                           s, p);
+                    multiplier_echantillons(f, h, d + 1, d + 2, p);
+                }
+                echantillonner_matrice(h, recurrence, 0, d + 2, d + 1, 1, s,
+                                       p);
+                multiplier_echantillons(f, h, 0, d + 2, p);
+                d++;
+            }
+        }
+
+        /* f_s aux points x_(s+1), ..., x_(2s+1) */
+        uint32_t* fSuite[N_COMPOSANTES];
+        for (int c = 0; c < N_COMPOSANTES; c++) fSuite[c] = f[c] + s + 1;
+        decaler(fSuite, f, s, (uint32_t)((s + 1) % p), &modulo);
+
+        /* Pas de geant: chaque echantillon est le produit de s matrices */
+        const uint64_t nBlocs =
+            nPas / s < nEchantillons ? nPas / s : nEchantillons;
+        for (uint64_t k = 0; k < nBlocs; k++) {
+            const uint64_t u = (f[0][k] * vecteur[0] + f[1][k] * vecteur[1]) %
+                               p;
+            vecteur[1] = (f[2][k] * vecteur[0] + f[3][k] * vecteur[1]) % p;
+            vecteur[0] = u;
+            denominateur = denominateur * f[4][k] % p;
+        }
+        i += nBlocs * s;
+
+        free(modulo.inversesFactorielles);
+        free(memoire);
+    }
+
+    for (; i <= n; i++)
+        pas_recurrence(recurrence, i, vecteur, &denominateur, p);
+
+    const uint64_t inverse = inverse_modulaire((uint32_t)denominateur, p);
+    termes[0] = (uint32_t)(vecteur[0] * inverse % p);
+    termes[1] = (uint32_t)(vecteur[1] * inverse % p);
+}
+
+/**
+ * Cette fonction calcule le coefficient de x^q de la serie
+ * 1 / (1 + x + x^2)^e = (1 - x)^e / (1 - x^3)^e modulo p, pour e = 1 ou 2.
+ *
+ * e : Exposant, 1 ou 2
+ * q : Indice du coefficient
+ * p : Premier
+ *
+ * return : Coefficient modulo p
+ */
+uint32_t coefficient_inverse(const int e, const int64_t q, const uint32_t p) {
+    /* Coefficients binomiaux de (1 - x)^e */
+    const int64_t binomiaux[2][3] = {{1, -1, 0}, {1, -2, 1}};
+    int64_t somme = 0;
+
+    for (int i = 0; i <= e; i++) {
+        const int64_t r = q - i;
+        /* Coefficient de x^r de 1 / (1 - x^3)^e: 1 ou r / 3 + 1 */
+        if (r >= 0 && r % 3 == 0)
+            somme += binomiaux[e - 1][i] * (e == 1 ? 1 : (r / 3 + 1) % p);
+    }
+
+    return (uint32_t)((somme % p + p) % p);
+}
+
+/**
+ * Cette fonction calcule le coefficient trinomial T(m, j) (coefficient de x^j
+ * de (1/x + 1 + x)^m) modulo p pour m = p - 1 ou p - 2. La recurrence ne
+ * s'applique pas pres de p, mais (1 + x + x^2)^m = (1 + x^p + x^2p) /
+ * (1 + x + x^2)^(p - m) modulo p.
+ *
+ * m : Exposant, p - 2 <= m < p
+ * j : Indice du coefficient, positif
+ * p : Premier
+ *
+ * return : T(m, j) mod p
+ */
+uint32_t trinome_bord(const uint64_t m, const uint64_t j, const uint32_t p) {
+    uint64_t somme = 0;
+
+    for (int r = 0; r < 3 && m + j >= (uint64_t)r * p; r++)
+        somme += coefficient_inverse((int)(p - m), (int64_t)(m + j - r * p), p);
+
+    return (uint32_t)(somme % p);
+}
+
+/**
+ * Cette fonction calcule les coefficients trinomiaux T(m, 0) et T(m, 1)
+ * modulo p pour un chiffre m < p. Si m + 1 < p,
+ * T(m, 1) = (T(m + 1, 0) - T(m, 0)) / 2 = m (T(m, 0) + 3 T(m - 1, 0)) /
+ * (2 (m + 1)).
+ *
+ * m : Chiffre, plus petit que p
+ * p : Premier
+ * trinome : Tableau ou ecrire T(m, 0) et T(m, 1)
+ */
+void trinomes_chiffre(const uint64_t m, const uint32_t p, uint32_t trinome[2]) {
+    if (m + 2 >= p) {
+        trinome[0] = trinome_bord(m, 0, p);
+        trinome[1] = trinome_bord(m, 1, p);
+        return;
+    }
+
+    uint32_t centraux[2];
+    evaluer_recurrence(&trinomes, m, p, centraux);
+    trinome[0] = centraux[0];
+    trinome[1] =
+        (uint32_t)(m * ((centraux[0] + 3ull * centraux[1]) % p) % p *
+                   inverse_modulaire((uint32_t)(2 * (m + 1) % p), p) % p);
+}
+
+/**
+ * Cette fonction calcule M_n modulo p. Avec n = n0 + p n', ou n0 est le
+ * chiffre des unites en base p, et P(x) = 1/x + 1 + x,
+ *     M_n = terme constant de P(x)^n0 (1 - x^2) P(x^p)^n'
+ *         = M_n0 T(n', 0) + (T(n0, p) - T(n0, p - 2)) T(n', 1) mod p,
+ * ou le second terme n'existe que si n0 >= p - 2. Les T(n', j) se calculent
+ * de la meme facon chiffre par chiffre:
+ *     T(n', 0) = T(m0, 0) T(m', 0)
+ *     T(n', 1) = T(m0, 1) T(m', 0) + [m0 = p - 1] T(m', 1)
+ * pour n' = m0 + p m'.
+ *
+ * n : Indice du terme
+ * p : Premier, plus petit que P_MAX
+ *
+ * return : M_n mod p
+ */
+uint32_t Motzkin_modulo(const uint64_t n, const uint32_t p) {
+    const uint64_t n0 = n % p;
+    /* M_n0 et coefficient de T(n', 1) */
+    uint64_t Mn0, coefficient = 0;
+
+    if (n0 + 2 < p) {
+        uint32_t termes[2];
+        evaluer_recurrence(&Motzkin, n0, p, termes);
+        Mn0 = termes[0];
+    } else {
+        Mn0 = (trinome_bord(n0, 0, p) + p - trinome_bord(n0, 2, p)) % p;
+        coefficient =
+            (trinome_bord(n0, p, p) + p - trinome_bord(n0, p - 2, p)) % p;
+    }
+
+    /* Chiffres de n' en base p, du poids faible au poids fort */
+    uint64_t chiffres[64];
+    int nChiffres = 0;
+    for (uint64_t reste = n / p; reste; reste /= p)
+        chiffres[nChiffres++] = reste % p;
+
+    /* T(n', 0) et T(n', 1) en ajoutant les chiffres a partir du poids fort */
+    uint64_t central = 1 % p, voisin = 0;
+    while (nChiffres-- > 0) {
+        const uint64_t m0 = chiffres[nChiffres];
+        uint32_t trinome[2];
+        trinomes_chiffre(m0, p, trinome);
+        voisin = (trinome[1] * central + (m0 == p - 1 ? voisin : 0)) % p;
+        central = trinome[0] * central % p;
+    }
+
+    return (uint32_t)((Mn0 * central + coefficient * voisin) % p);
+}
+
+/**
+ * Cette fonction verifie si un nombre est premier par divisions successives.
+ *
+ * p : Nombre a verifier
+ *
+ * return : 1 si p est premier, 0 sinon
+ */
+int est_premier(const uint32_t p) {
+    if (p < 2) return 0;
+    for (uint32_t d = 2; d * d <= p; d++)
+        if (!(p % d)) return 0;
+    return 1;
+}
+
+/**
+ * Cette fonction donne le temps ecoule depuis un instant donne.
+ *
+ * debut : Instant de depart
+ *
+ * return : Temps ecoule en secondes
+ */
+double secondes_depuis(const struct timespec* debut) {
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (fin.tv_sec - debut->tv_sec) + (fin.tv_nsec - debut->tv_nsec) * 1e-9;
+}
+
+/**
+ * Travail d'un fil d'execution: il traite les requetes iDebut, iDebut + pas,
+ * iDebut + 2 * pas, ...
+ */
+struct travail {
+    struct requete* requetes;
+    int nRequetes, iDebut, pas;
+};
+
+/**
+ * Cette fonction est executee par chaque fil d'execution.
+ *
+ * argument : Pointeur vers la struct travail du fil
+ *
+ * return : NULL
+ */
+void* executer_travail(void* argument) {
+    const struct travail* travail = argument;
+
+    for (int i = travail->iDebut; i < travail->nRequetes; i += travail->pas) {
+        struct requete* requete = &travail->requetes[i];
+        struct timespec debut;
+        clock_gettime(CLOCK_MONOTONIC, &debut);
+        requete->resultat = Motzkin_modulo(requete->n, requete->p);
+        requete->temps = secondes_depuis(&debut);
+    }
+
+    return NULL;
+}
+
+/**
+ * Cette fonction traite des requetes en les repartissant entre plusieurs fils
+ * d'execution, puis les affiche.
+ *
+ * requetes : Requetes a traiter
+ * nRequetes : Nombre de requetes
+ * nFils : Nombre de fils d'execution a utiliser
+ */
+void traiter_requetes(struct requete requetes[], const int nRequetes,
+                      int nFils) {
+    pthread_t fils[N_FILS_MAX];
+    struct travail travaux[N_FILS_MAX];
+    int lance[N_FILS_MAX];
+
+    if (nFils > N_FILS_MAX) nFils = N_FILS_MAX;
+    if (nFils > nRequetes) nFils = nRequetes;
+    if (nFils < 1) nFils = 1;
+
+    for (int i = 0; i < nFils; i++) {
+        travaux[i] = (struct travail){requetes, nRequetes, i, nFils};
+        /* Si le fil ne peut pas etre cree, on fait son travail ici */
+        lance[i] = !pthread_create(&fils[i], NULL, executer_travail,
+                                   &travaux[i]);
+        if (!lance[i]) executer_travail(&travaux[i]);
+    }
+    for (int i = 0; i < nFils; i++)
+        if (lance[i]) pthread_join(fils[i], NULL);
+
+    printf("                   n           p   M_n mod p  Temps (ms)\n");
+    for (int i = 0; i < nRequetes; i++)
+        printf("%20lu  %10u  %10u  %10.3f\n", requetes[i].n, requetes[i].p,
+               requetes[i].resultat, 1e3 * requetes[i].temps);
+}
+
+/**
+ * Cette fonction verifie les N_VERIFICATION premiers termes modulo quelques
+ * premiers avec la recurrence de convolution de Motzkin_recursif1, qui ne
+ * divise pas, et M_n pour un grand n < p avec la recurrence pas a pas.
+ */
+void verifier(void) {
+    const uint32_t petitsPremiers[] = {2, 3, 5, 7, 11, 13, 101, 1009};
+    const int nPremiers = sizeof petitsPremiers / sizeof petitsPremiers[0];
+    uint32_t termes[N_VERIFICATION];
+    int egal = 1;
+
+    for (int k = 0; k < nPremiers; k++) {
+        const uint32_t p = petitsPremiers[k];
+        for (int n = 0; n < N_VERIFICATION; n++) {
+            uint64_t somme = n ? termes[n - 1] : 1;
+            for (int i = 0; i + 2 <= n; i++)
+                somme += (uint64_t)termes[i] * termes[n - 2 - i] % p;
+            termes[n] = (uint32_t)(somme % p);
+            egal &= Motzkin_modulo(n, p) == termes[n];
+        }
+    }
+    printf("Verification des %d premiers termes modulo 2 a 1009 avec la "
+           "convolution : %s\n",
+           N_VERIFICATION, egal ? "identique" : "different");
+
+    /* Recurrence pas a pas jusqu'a N_PAS_A_PAS */
+    const uint32_t p = 1000000007;
+    uint64_t vecteur[2] = {1, 1}, denominateur = 1;
+    struct timespec debut;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    for (uint64_t i = 2; i <= N_PAS_A_PAS; i++)
+        pas_recurrence(&Motzkin, i, vecteur, &denominateur, p);
+    const uint32_t pasAPas =
+        (uint32_t)(vecteur[0] * inverse_modulaire((uint32_t)denominateur, p) %
+                   p);
+    const double tempsPasAPas = secondes_depuis(&debut);
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    const uint32_t rapide = Motzkin_modulo(N_PAS_A_PAS, p);
+    const double tempsRapide = secondes_depuis(&debut);
+    printf("M_%d mod %u : %u pas a pas (%.3f s), %u par pas de bebe et pas de "
+           "geant (%.3f s)\n\n",
+           N_PAS_A_PAS, p, pasAPas, tempsPasAPas, rapide, tempsRapide);
+}
+
+int main(int argc, char* argv[]) {
+    /* Nombre de fils d'execution */
+    const int nFils = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    initialiser_premiers();
+
+    if (argc > 1) {
+        if (argc % 2 == 0) {
+            printf("Utilisation : %s [n p]...\n", argv[0]);
+            return 1;
+        }
+        const int nRequetes = (argc - 1) / 2;
+        struct requete* requetes = malloc(nRequetes * sizeof *requetes);
+        if (!requetes) {
+            printf("Memoire insuffisante\n");
+            return 1;
+        }
+        for (int i = 0; i < nRequetes; i++) {
+            requetes[i].n = strtoull(argv[2 * i + 1], NULL, 10);
+            const unsigned long p = strtoul(argv[2 * i + 2], NULL, 10);
+            if (p >= P_MAX || !est_premier((uint32_t)p)) {
+                printf("%lu n'est pas un premier plus petit que %u\n", p,
+                       P_MAX);
+                return 1;
+            }
+            requetes[i].p = (uint32_t)p;
+        }
+        traiter_requetes(requetes, nRequetes, nFils);
+        free(requetes);
+        return 0;
+    }
+
+    verifier();
+
+    struct requete requetes[] = {
+        {1000000000000ul, 2, 0, 0},
+        {1000000000000ul, 3, 0, 0},
+        {1000000000000ul, 7, 0, 0},
+        {1000000000000ul, 1009, 0, 0},
+        {1000000000000ul, 65537, 0, 0},
+        {1000000000000ul, 998244353, 0, 0},
+        {1000000000000ul, 1000000007, 0, 0},
+        {1000000000000ul, 1073741789, 0, 0},
+        {999999999999999999ul, 1000000007, 0, 0},
+        {1000000005ul, 1000000007, 0, 0},
+        {1000000006ul, 1000000007, 0, 0},
+        {2000000013ul, 1000000007, 0, 0}};
+    traiter_requetes(requetes, sizeof requetes / sizeof requetes[0], nFils);
+
+    return 0;
+}
+
+/*
+Verification des 2000 premiers termes modulo 2 a 1009 avec la convolution : identique
+M_100000000 mod 1000000007 : 843325672 pas a pas (0.728 s), 843325672 par pas de bebe et pas de geant (0.141 s)
+
+                   n           p   M_n mod p  Temps (ms)
+       1000000000000           2           1       0.003
+       1000000000000           3           0       0.002
+       1000000000000           7           0       0.002
+       1000000000000        1009         347       0.047
+       1000000000000       65537       48498       3.398
+       1000000000000   998244353    40355714     311.284
+       1000000000000  1000000007   864709011     643.465
+       1000000000000  1073741789   383284934     297.594
+  999999999999999999  1000000007   860883232     580.275
+          1000000005  1000000007  1000000006       0.001
+          1000000006  1000000007  1000000006       0.000
+          2000000013  1000000007           0       0.001
+*/
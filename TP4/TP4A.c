@@ -3,18 +3,31 @@
  *
  * Ce programme sert calculer la suite des nombres de Motzkin selon une methode
  * recursive et une methode iterative. On comapre ensuite diverses donnes pour
- * chaque methode d'execution afin de les comparer.
+ * chaque methode d'execution afin de les comparer. La recurrence de la methode
+ * recursive est aussi calculee avec un tableau de termes deja connus, rempli
+ * de haut en bas (memoisation) ou de bas en haut (programmation dynamique), ce
+ * qui ramene le calcul des NTERMEMAX premiers termes a O(n^2) operations.
+ *
+ * Le nombre d'operations de chaque type effectuees par chaque methode est
+ * compte avec les macros de compteurs.h, qui ne coutent rien dans la version
+ * chronometree. Pour la version instrumentee, compiler avec
+ * gcc -DCOMPTER_OPERATIONS TP4A.c -o TP4A
+ * (et -DCOMPTEURS_MATERIELS pour les compteurs du processeur).
+ *
+ * Avec l'argument --banc, le programme mesure plutot chaque methode avec le
+ * banc d'essai de banc.h (voir ce fichier pour les options).
  */
 
 #include <stdio.h>
-#include <time.h>
+#include <string.h>
 
-/* Afin de fonctionner correctement sur Linux ou Unix */
-#ifndef CLK_TCK
-#define CLK_TCK CLOCKS_PER_SEC
-#endif
+#include "../banc.h"
+#include "../compteurs.h"
 
 #define NTERMEMAX 28 /* Nombre maximum de termes calcules par la suite */
+/* Nombre de termes calcules par le banc d'essai de la methode recursive, qui
+ * prendrait sinon une minute par appel */
+#define NTERMES_BANC_RECURSIF 20
 
 /**
  * Fonction qui cherche a calculer la suite de Motzkin de maniere recursive, 
@@ -26,17 +39,50 @@
  * return: Nombre de Motzkin d'indice nTerme.
  */
 double Motzkin_recursif1(const int nTerme) {
+    /* 1 affectation pour la copie de nTerme */
+    COMPTER(AFFECTATIONS, 1);
+    /* 2 comparaisons pour ! et == (je n'ai pas compte || comme une
+     * comparaison) */
+    COMPTER(COMPARAISONS, 2);
     /* Definitions des deux premiers termes */
-    if (!nTerme || nTerme == 1)
+    if (!nTerme || nTerme == 1) {
+        /* Si nTerme est 0 alors on n'a pas effectue la comparaison pour le ==
+         * puisqu'on a un vrai du cote gauche du || */
+        if (!nTerme)
+            COMPTER(COMPARAISONS, -1);
+        /* 1 affectation pour return */
+        COMPTER(AFFECTATIONS, 1);
         return 1;
+    }
 
+    /* 3 affectations pour somme =, pour limiteSomme = et pour i = (dans le
+     * for) */
+    COMPTER(AFFECTATIONS, 3);
+    /* 1 comparaison pour <= dans le for */
+    COMPTER(COMPARAISONS, 1);
+    /* 1 addition pour le - dans limiteSomme */
+    COMPTER(ADDITIONS, 1);
     /* Terme sous la forme d'une sommation dans la definition de la suite */
     double somme = 0;
     /* Limite de la sommation */
     const int limiteSomme = nTerme - 2;
-    for (int i = 0; i <= limiteSomme; i++)
+    for (int i = 0; i <= limiteSomme; i++) {
+        /* 3 additions pour i++, somme += et le - dans les arguments de
+         * Motzkin_recursif1 */
+        COMPTER(ADDITIONS, 3);
+        /* 2 affectation pour i++ et somme += */
+        COMPTER(AFFECTATIONS, 2);
+        /* 1 multiplication pour * entre les termes de la somme */
+        COMPTER(MULTIPLICATIONS, 1);
         somme += Motzkin_recursif1(i) * Motzkin_recursif1(limiteSomme - i);
+        /* 1 comparaison pour <= dans le for */
+        COMPTER(COMPARAISONS, 1);
+    }
 
+    /* 1 affection pour return */
+    COMPTER(AFFECTATIONS, 1);
+    /* 2 additions pour - et + */
+    COMPTER(ADDITIONS, 2);
     return Motzkin_recursif1(nTerme - 1) + somme;
 }
 
@@ -50,209 +96,228 @@ double Motzkin_recursif1(const int nTerme) {
  * return: Nombre de Motzkin d'indice nTerme.
  */
 double Motzkin_iteratif1(const int nTerme) {
+    /* 1 affectation pour la copie de nTerme */
+    COMPTER(AFFECTATIONS, 1);
+    /* 2 comparaisons pour ! et == (je n'ai pas compte || comme une
+     * comparaison) */
+    COMPTER(COMPARAISONS, 2);
     /* Definitions des deux premiers termes */
-    if (!nTerme || nTerme == 1)
+    if (!nTerme || nTerme == 1) {
+        /* Si nTerme est 0 alors on n'a pas effectue la comparaison pour le ==
+         * puisqu'on a un vrai du cote gauche du || */
+        if (!nTerme)
+            COMPTER(COMPARAISONS, -1);
+        /* 1 affectation pour return */
+        COMPTER(AFFECTATIONS, 1);
         return 1;
+    }
+
+    /* 3 affectations pour dernier =, pour avantDernier = et pour i = (dans le
+     * for) */
+    COMPTER(AFFECTATIONS, 3);
 
     /* Le dernier terme calcule et l'avant-dernier terme calcule par la suite,
      * dans cet ordre */
     double dernier = 1, avantDernier = 1;
 
+    /* 1 comparaison pour i <= (dans le for) */
+    COMPTER(COMPARAISONS, 1);
     /* On calcule les termes de la suite iterativement, jusqu'a ce qu'on arrive
      * au terme voulu */
     for (int i = 2; i <= nTerme; i++){
+        /* 4 affectations pour i++, courant =, pour avantDernier = et pour
+         * dernier = */
+        COMPTER(AFFECTATIONS, 4);
+        /* 6 multiplications pour les 2 * dans les numerateurs, les 2 / entre
+         * les numerateurs et les denominateurs et les * entre les termes et
+         * leurs coefficients */
+        COMPTER(MULTIPLICATIONS, 6);
+        /* 6 additions pour le i++, les 2 + dans les numerateurs, pour les 2 -
+         * dans les denominateurs et pour le + entre les deux termes */
+        COMPTER(ADDITIONS, 6);
         double courant = (2 * i + 1) / (i + 2.0) * dernier +
                   (3 * i - 3) / (i + 2.0) * avantDernier;
         avantDernier = dernier;
         dernier = courant;
+        /* 1 comparaison pour le i <= (dans le for) */
+        COMPTER(COMPARAISONS, 1);
     }
 
+    /* 1 affectation pour le return */
+    COMPTER(AFFECTATIONS, 1);
     return dernier;
 }
 
+/* Termes deja calcules par Motzkin_memoise1, gardes d'un appel a l'autre (un
+ * nombre de Motzkin n'est jamais nul, donc 0 indique un terme pas encore
+ * calcule) */
+double memo[NTERMEMAX];
+
 /**
- * Fonction qui sert a afficher les temps d'executions et les resultats d'une 
- * fonction qui calcule la suite de Motzkin.
- * 
- * nom: Nom de la nom utilisee pour calculer la suite de Motzkin.
- * Motzkin1: Fonction qui calcule les termes de la suite de Motzkin.
+ * Fonction qui vide le tableau de Motzkin_memoise1, pour que le prochain appel
+ * recalcule les termes.
  */
-void afficher_temps(const char nom[], double (*Motzkin1)(const int)){
-    printf("Suite de Motzkin calculee %s...", nom);
-
-    /* Temps au debut */
-    const clock_t tempsDeb = clock();
-
-    /* On affiche les resultats de la fonction ici */
-    for(int i = 0; i < NTERMEMAX; i++){
-        /* Test pour formatter */ 
-        if (!(i % 4))
-            printf("\n");
-
-        printf("M%-2d = %-11.0lf ", i, Motzkin1(i));
-    }
-    /* Temps a la fin. */
-    const clock_t tempsFin = clock();
-    printf("\nTemps de calcul: %6.2f secondes\n\n",
-           ((float)tempsFin - tempsDeb) / CLK_TCK);
+void Motzkin_memoise_oublier() {
+    memset(memo, 0, sizeof memo);
 }
 
 /**
  * Fonction qui cherche a calculer la suite de Motzkin de maniere recursive,
  * grace a la formule M_n = M_(n-1) + Somme(M_i * M_(n-2-i)), avec i allant de
- * 0 a n-2. Elle tient aussi compte du nombre d'operation de chaque type
- * effectuees durant son executition.
+ * 0 a n-2. Chaque terme calcule est garde dans un tableau, ce qui evite de
+ * recalculer les sous-termes: un terme coute O(n) une fois les precedents
+ * connus.
+ *
+ * nTerme: Numero du terme a calculer, plus petit que NTERMEMAX.
  *
- * nTerme: Numero du terme a calculer.
- * nAffectations: Nombre d'affectations effectuées par la fonction de base.
- * nAdditions: Nombre d'additions effectuées par la fonction de base.
- * nMultiplications: Nombre de multîplications effectuées par la fonction de
- * base. 
- * nComparaisons: Nombre de comparaisons effectuées par la fonction de
- * base.
- * 
  * return: Nombre de Motzkin d'indice nTerme.
  */
-double Motzkin_recursif2(const int nTerme, double* nAffectations, double* nAdditions,
-                        double* nMultiplications, double* nComparaisons) {
+double Motzkin_memoise1(const int nTerme) {
     /* 1 affectation pour la copie de nTerme */
-    ++*nAffectations;
-    /* 2 comparaisons pour ! et == (je n'ai pas compte || comme une
-     * comparaison) */
-    *nComparaisons += 2;
+    COMPTER(AFFECTATIONS, 1);
+    /* 1 comparaison pour le test du tableau */
+    COMPTER(COMPARAISONS, 1);
+    if (memo[nTerme]) {
+        /* 1 affectation pour return */
+        COMPTER(AFFECTATIONS, 1);
+        return memo[nTerme];
+    }
+
+    /* 2 comparaisons pour ! et == */
+    COMPTER(COMPARAISONS, 2);
+    /* Definitions des deux premiers termes */
     if (!nTerme || nTerme == 1) {
         /* Si nTerme est 0 alors on n'a pas effectue la comparaison pour le ==
          * puisqu'on a un vrai du cote gauche du || */
         if (!nTerme)
-            --*nComparaisons;
-        /* 1 affectation pour return */
-        ++*nAffectations;
-        return 1;
+            COMPTER(COMPARAISONS, -1);
+        /* 2 affectations pour memo[nTerme] = et return */
+        COMPTER(AFFECTATIONS, 2);
+        return memo[nTerme] = 1;
     }
 
     /* 3 affectations pour somme =, pour limiteSomme = et pour i = (dans le
      * for) */
-    *nAffectations += 3;
+    COMPTER(AFFECTATIONS, 3);
     /* 1 comparaison pour <= dans le for */
-    ++*nComparaisons;
+    COMPTER(COMPARAISONS, 1);
     /* 1 addition pour le - dans limiteSomme */
-    ++*nAdditions;
+    COMPTER(ADDITIONS, 1);
     /* Terme sous la forme d'une sommation dans la definition de la suite */
     double somme = 0;
     /* Limite de la sommation */
     const int limiteSomme = nTerme - 2;
     for (int i = 0; i <= limiteSomme; i++) {
         /* 3 additions pour i++, somme += et le - dans les arguments de
-         * Motzkin_recursif2 */
-        *nAdditions += 3;
+         * Motzkin_memoise1 */
+        COMPTER(ADDITIONS, 3);
         /* 2 affectation pour i++ et somme += */
-        *nAffectations += 2;
+        COMPTER(AFFECTATIONS, 2);
         /* 1 multiplication pour * entre les termes de la somme */
-        ++*nMultiplications;
-        somme += Motzkin_recursif2(i, nAffectations, nAdditions,
-                                   nMultiplications, nComparaisons) *
-                 Motzkin_recursif2(limiteSomme - i, nAffectations, nAdditions,
-                                   nMultiplications, nComparaisons);
+        COMPTER(MULTIPLICATIONS, 1);
+        somme += Motzkin_memoise1(i) * Motzkin_memoise1(limiteSomme - i);
         /* 1 comparaison pour <= dans le for */
-        ++*nComparaisons;
+        COMPTER(COMPARAISONS, 1);
     }
 
-    /* 1 affection pour return */
-    ++*nAffectations;
+    /* 2 affectations pour memo[nTerme] = et return */
+    COMPTER(AFFECTATIONS, 2);
     /* 2 additions pour - et + */
-    *nAdditions += 2;
-    return Motzkin_recursif2(nTerme - 1, nAffectations, nAdditions,
-                             nMultiplications, nComparaisons) +
-           somme;
+    COMPTER(ADDITIONS, 2);
+    return memo[nTerme] = Motzkin_memoise1(nTerme - 1) + somme;
 }
 
+/* Termes deja calcules par Motzkin_dynamique1, en commencant par les deux
+ * premiers termes, et nombre de termes deja calcules dans ce tableau */
+double calcules[NTERMEMAX] = {1, 1};
+int nCalcules = 2;
+
 /**
- * Fonction qui cherche a calculer la suite de Motzkin de maniere iterative, 
- * grace a la formule M_n = (2n + 1) / (n + 2) * M_(n-1) + (3n - 3) / (n + 2) 
- * * M_(n-2). Elle tient aussi compte du nombre d'operation de chaque type 
- * effectuees durant son executition.
+ * Fonction qui oublie les termes calcules par Motzkin_dynamique1 sauf les deux
+ * premiers, pour que le prochain appel remplisse de nouveau le tableau.
+ */
+void Motzkin_dynamique_oublier() {
+    nCalcules = 2;
+}
+
+/**
+ * Fonction qui cherche a calculer la suite de Motzkin avec la meme formule que
+ * Motzkin_recursif1, mais en remplissant un tableau de bas en haut. Le tableau
+ * est garde d'un appel a l'autre et on ne calcule que les termes manquants,
+ * donc afficher les termes 0 a n coute O(n^2) operations au total.
+ *
+ * nTerme: Numero du terme a calculer, plus petit que NTERMEMAX.
  *
- * nTerme: Numero du terme a calculer.
- * nAffectations: Nombre d'affectations effectuées par la fonction de base.
- * nAdditions: Nombre d'additions effectuées par la fonction de base.
- * nMultiplications: Nombre de multîplications effectuées par la fonction de
- * base. 
- * nComparaisons: Nombre de comparaisons effectuées par la fonction de
- * base.
- * 
  * return: Nombre de Motzkin d'indice nTerme.
  */
-double Motzkin_iteratif2(const int nTerme, double* nAffectations, double* nAdditions,
-                         double* nMultiplications, double* nComparaisons) {
+double Motzkin_dynamique1(const int nTerme) {
     /* 1 affectation pour la copie de nTerme */
-    ++*nAffectations;
-    /* 2 comparaisons pour ! et == (je n'ai pas compte || comme une
-     * comparaison) */
-    *nComparaisons += 2;
-    if (!nTerme || nTerme == 1) {
-        /* Si nTerme est 0 alors on n'a pas effectue la comparaison pour le ==
-         * puisqu'on a un vrai du cote gauche du || */
-        if (!nTerme)
-            --*nComparaisons;
-        /* 1 affectation pour return */
-        ++*nAffectations;
-        return 1;
-    }
-
-    /* 3 affectations pour dernier =, pour avantDernier = et pour i = (dans le
-     * for) */
-    *nAffectations += 3;
-
-    /* Le dernier terme calcule et l'avant-dernier terme calcule par la suite,
-     * dans cet ordre */
-    double dernier = 1, avantDernier = 1;
-
-    /* 1 comparaison pour i <= (dans le for) */
-    ++*nComparaisons;
-    /* On calcule les termes de la suite iterativement, jusqu'a ce qu'on arrive
-     * au terme voulu */
-    for (int i = 2; i <= nTerme; i++){
-        /* 4 affectations pour i++, courant =, pour avantDernier = et pour
-         * dernier = */
-        *nAffectations += 4;
-        /* 6 multiplications pour les 2 * dans les numerateurs, les 2 / entre
-         * les numerateurs et les denominateurs et les * entre les termes et
-         * leurs coefficients */
-        *nMultiplications += 6;
-        /* 6 additions pour le i++, les 2 + dans les numerateurs, pour les 2 -
-         * dans les denominateurs et pour le + entre les deux termes */
-        *nAdditions += 6;
-        double courant = (2 * i + 1) / (i + 2.0) * dernier +
-                  (3 * i - 3) / (i + 2.0) * avantDernier;
-        avantDernier = dernier;
-        dernier = courant;
-        /* 1 comparaison pour le i <= (dans le for) */
-        ++*nComparaisons;
+    COMPTER(AFFECTATIONS, 1);
+    /* 1 comparaison pour <= dans le for */
+    COMPTER(COMPARAISONS, 1);
+    /* On calcule les termes manquants jusqu'a celui qui est demande */
+    for (; nCalcules <= nTerme; nCalcules++) {
+        /* 3 affectations pour somme =, pour limiteSomme = et pour i = (dans
+         * le for) */
+        COMPTER(AFFECTATIONS, 3);
+        /* 1 comparaison pour <= dans le for */
+        COMPTER(COMPARAISONS, 1);
+        /* 1 addition pour le - dans limiteSomme */
+        COMPTER(ADDITIONS, 1);
+        /* Terme sous la forme d'une sommation dans la definition de la suite */
+        double somme = 0;
+        /* Limite de la sommation */
+        const int limiteSomme = nCalcules - 2;
+        for (int i = 0; i <= limiteSomme; i++) {
+            /* 3 additions pour i++, somme += et le - dans l'indice */
+            COMPTER(ADDITIONS, 3);
+            /* 2 affectation pour i++ et somme += */
+            COMPTER(AFFECTATIONS, 2);
+            /* 1 multiplication pour * entre les termes de la somme */
+            COMPTER(MULTIPLICATIONS, 1);
+            somme += calcules[i] * calcules[limiteSomme - i];
+            /* 1 comparaison pour <= dans le for */
+            COMPTER(COMPARAISONS, 1);
+        }
+
+        /* 2 affectations pour calcules[nCalcules] = et nCalcules++ */
+        COMPTER(AFFECTATIONS, 2);
+        /* 3 additions pour -, + et nCalcules++ */
+        COMPTER(ADDITIONS, 3);
+        calcules[nCalcules] = calcules[nCalcules - 1] + somme;
+        /* 1 comparaison pour <= dans le for */
+        COMPTER(COMPARAISONS, 1);
     }
 
     /* 1 affectation pour le return */
-    ++*nAffectations;
-    return dernier;
+    COMPTER(AFFECTATIONS, 1);
+    return calcules[nTerme];
 }
 
 /**
- * Fonction qui sert a afficher le nombre d'operations de chaque type et les
- * resultats d'une fonction qui calcule la suite de Motzkin.
- *
+ * Fonction qui sert a afficher les temps d'executions et les resultats d'une 
+ * fonction qui calcule la suite de Motzkin. Si l'instrumentation est activee
+ * (voir compteurs.h), on affiche aussi les operations et les compteurs du
+ * processeur mesures pendant le calcul.
+ * 
  * nom: Nom de la nom utilisee pour calculer la suite de Motzkin.
- * Motzkin2: Fonction qui calcule les termes de la suite de Motzkin en tenant
- * compte du nombre d'operations de chaque type effectuees.
+ * Motzkin1: Fonction qui calcule les termes de la suite de Motzkin.
  */
-void afficher_mesures(const char nom[],
-                      double (*Motzkin2)(const int, double*, double*, double*, double*)) {
+void afficher_temps(const char nom[], double (*Motzkin1)(const int)){
+    /* Termes calcules, affiches seulement apres la mesure pour que le temps
+     * ne comprenne pas celui des printf */
+    double termes[NTERMEMAX];
+
     printf("Suite de Motzkin calculee %s...", nom);
 
-    /* Compteur d'affectations, compteur d'additions, compteur de
-     * multiplications et compteur de comparaisons, dans cet ordre */
-    double nAffectations = 0;
-    double nAdditions = 0;
-    double nMultiplications = 0;
-    double nComparaisons = 0;
+    MESURE_DEBUTER(mesure);
+    /* Temps au debut, sur une horloge monotone (clock() donnait le temps
+     * processeur avec une resolution grossiere) */
+    const double tempsDeb = banc_temps_ns();
+    for (int i = 0; i < NTERMEMAX; i++)
+        termes[i] = Motzkin1(i);
+    /* Temps a la fin. */
+    const double tempsFin = banc_temps_ns();
 
     /* On affiche les resultats de la fonction ici */
     for(int i = 0; i < NTERMEMAX; i++){
@@ -260,42 +325,76 @@ void afficher_mesures(const char nom[],
         if (!(i % 4))
             printf("\n");
 
-        printf("M%-2d = %-11.0lf ", i,
-               Motzkin2(i, &nAffectations, &nAdditions, &nMultiplications,
-                        &nComparaisons));
+        printf("M%-2d = %-11.0lf ", i, termes[i]);
     }
-
+    printf("\nTemps de calcul: %6.2f secondes\n",
+           (tempsFin - tempsDeb) * 1e-9);
+    MESURE_TERMINER(mesure, nom);
     printf("\n");
+}
+
+/**
+ * Donnees d'un noyau du banc d'essai: une methode de calcul de la suite de
+ * Motzkin, la fonction qui vide son tableau (NULL si elle n'en garde pas) et
+ * le nombre de termes a calculer.
+ */
+struct banc_Motzkin {
+    double (*Motzkin1)(const int);
+    void (*oublier)();
+    int nTermes;
+    /* Somme des termes calcules, resultat du noyau */
+    double somme;
+};
+
+/**
+ * Noyau du banc d'essai: calcule les termes 0 a nTermes - 1 de la suite. Les
+ * methodes par memoisation et par programmation dynamique gardent leurs
+ * tableaux d'un appel a l'autre, donc on les vide d'abord pour que chaque
+ * mesure remplisse le tableau au lieu de seulement le lire.
+ *
+ * donnees: Pointeur vers une struct banc_Motzkin.
+ */
+void banc_Motzkin(void* donnees) {
+    struct banc_Motzkin* banc = donnees;
+    double somme = 0;
 
-    /* On affiche les metriques mesurees au long des executions */
-    printf("Nombre d'affectations    : %-.0lf\n", nAffectations);
-    printf("Nombre d'additions       : %-.0lf\n", nAdditions);
-    printf("Nombre de multiplications: %-.0lf\n", nMultiplications);
-    printf("Nombre de comparaisons   : %-.0lf\n\n", nComparaisons);
+    if (banc->oublier) banc->oublier();
+    for (int i = 0; i < banc->nTermes; i++)
+        somme += banc->Motzkin1(i);
+    banc->somme = somme;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    /* Noyaux du banc d'essai */
+    static struct banc_Motzkin
+        recursif = {Motzkin_recursif1, NULL, NTERMES_BANC_RECURSIF, 0},
+        iteratif = {Motzkin_iteratif1, NULL, NTERMEMAX, 0},
+        memoise = {Motzkin_memoise1, Motzkin_memoise_oublier, NTERMEMAX, 0},
+        dynamique = {Motzkin_dynamique1, Motzkin_dynamique_oublier, NTERMEMAX,
+                     0};
+    banc_enregistrer("Motzkin recursif (M0 a M19)", banc_Motzkin, &recursif);
+    banc_enregistrer("Motzkin iteratif", banc_Motzkin, &iteratif);
+    banc_enregistrer("Motzkin memoise", banc_Motzkin, &memoise);
+    banc_enregistrer("Motzkin dynamique", banc_Motzkin, &dynamique);
+    if (banc_lancer(argc, argv)) return 0;
+
     afficher_temps("recursivement", Motzkin_recursif1);
     afficher_temps("iterativement", Motzkin_iteratif1);
-
-    printf("\n");
-
-    afficher_mesures("recursivement", Motzkin_recursif2);
-    afficher_mesures("iterativement", Motzkin_iteratif2);
+    afficher_temps("par memoisation", Motzkin_memoise1);
+    afficher_temps("par programmation dynamique", Motzkin_dynamique1);
 
     return 0;
 }
-
 /*
 Suite de Motzkin calculee recursivement...
 M0  = 1           M1  = 1           M2  = 2           M3  = 4
 M4  = 9           M5  = 21          M6  = 51          M7  = 127
 M8  = 323         M9  = 835         M10 = 2188        M11 = 5798
 M12 = 15511       M13 = 41835       M14 = 113634      M15 = 310572
-M16 = 853467      M17 = 2356779     M18 = 6536382     M19 = 18199284    
-M20 = 50852019    M21 = 142547559   M22 = 400763223   M23 = 1129760415  
-M24 = 3192727797  M25 = 9043402501  M26 = 25669818476 M27 = 73007772802 
-Temps de calcul: 136.29 secondes
+M16 = 853467      M17 = 2356779     M18 = 6536382     M19 = 18199284
+M20 = 50852019    M21 = 142547559   M22 = 400763223   M23 = 1129760415
+M24 = 3192727797  M25 = 9043402501  M26 = 25669818476 M27 = 73007772802
+Temps de calcul:  41.79 secondes
 
 Suite de Motzkin calculee iterativement...
 M0  = 1           M1  = 1           M2  = 2           M3  = 4
@@ -305,21 +404,49 @@ M12 = 15511       M13 = 41835       M14 = 113634      M15 = 310572
 M16 = 853467      M17 = 2356779     M18 = 6536382     M19 = 18199284
 M20 = 50852019    M21 = 142547559   M22 = 400763223   M23 = 1129760415
 M24 = 3192727797  M25 = 9043402501  M26 = 25669818476 M27 = 73007772802
-Temps de calcul:   0.01 secondes
+Temps de calcul:   0.00 secondes
 
+Suite de Motzkin calculee par memoisation...
+M0  = 1           M1  = 1           M2  = 2           M3  = 4
+M4  = 9           M5  = 21          M6  = 51          M7  = 127
+M8  = 323         M9  = 835         M10 = 2188        M11 = 5798
+M12 = 15511       M13 = 41835       M14 = 113634      M15 = 310572
+M16 = 853467      M17 = 2356779     M18 = 6536382     M19 = 18199284
+M20 = 50852019    M21 = 142547559   M22 = 400763223   M23 = 1129760415
+M24 = 3192727797  M25 = 9043402501  M26 = 25669818476 M27 = 73007772802
+Temps de calcul:   0.00 secondes
+
+Suite de Motzkin calculee par programmation dynamique...
+M0  = 1           M1  = 1           M2  = 2           M3  = 4
+M4  = 9           M5  = 21          M6  = 51          M7  = 127
+M8  = 323         M9  = 835         M10 = 2188        M11 = 5798
+M12 = 15511       M13 = 41835       M14 = 113634      M15 = 310572
+M16 = 853467      M17 = 2356779     M18 = 6536382     M19 = 18199284
+M20 = 50852019    M21 = 142547559   M22 = 400763223   M23 = 1129760415
+M24 = 3192727797  M25 = 9043402501  M26 = 25669818476 M27 = 73007772802
+Temps de calcul:   0.00 secondes
+
+
+-DCOMPTER_OPERATIONS -DCOMPTEURS_MATERIELS:
 
 Suite de Motzkin calculee recursivement...
 M0  = 1           M1  = 1           M2  = 2           M3  = 4
 M4  = 9           M5  = 21          M6  = 51          M7  = 127
 M8  = 323         M9  = 835         M10 = 2188        M11 = 5798
-M12 = 15511       M13 = 41835       M14 = 113634      M15 = 310572      
-M16 = 853467      M17 = 2356779     M18 = 6536382     M19 = 18199284    
-M20 = 50852019    M21 = 142547559   M22 = 400763223   M23 = 1129760415  
-M24 = 3192727797  M25 = 9043402501  M26 = 25669818476 M27 = 73007772802 
+M12 = 15511       M13 = 41835       M14 = 113634      M15 = 310572
+M16 = 853467      M17 = 2356779     M18 = 6536382     M19 = 18199284
+M20 = 50852019    M21 = 142547559   M22 = 400763223   M23 = 1129760415
+M24 = 3192727797  M25 = 9043402501  M26 = 25669818476 M27 = 73007772802
+Temps de calcul: 127.75 secondes
+Mesures (recursivement)
 Nombre d'affectations    : 82403133143
 Nombre d'additions       : 43904613045
 Nombre de multiplications: 9228778012
 Nombre de comparaisons   : 51549983118
+Nombre de cycles         : indisponible
+Nombre d'instructions    : indisponible
+Branchements mal predits : indisponible
+Defauts de cache         : indisponible
 
 Suite de Motzkin calculee iterativement...
 M0  = 1           M1  = 1           M2  = 2           M3  = 4
@@ -329,9 +456,62 @@ M12 = 15511       M13 = 41835       M14 = 113634      M15 = 310572
 M16 = 853467      M17 = 2356779     M18 = 6536382     M19 = 18199284
 M20 = 50852019    M21 = 142547559   M22 = 400763223   M23 = 1129760415
 M24 = 3192727797  M25 = 9043402501  M26 = 25669818476 M27 = 73007772802
+Temps de calcul:   0.00 secondes
+Mesures (iterativement)
 Nombre d'affectations    : 1538
 Nombre d'additions       : 2106
 Nombre de multiplications: 2106
 Nombre de comparaisons   : 432
+Nombre de cycles         : indisponible
+Nombre d'instructions    : indisponible
+Branchements mal predits : indisponible
+Defauts de cache         : indisponible
 
-*/
\ No newline at end of file
+Suite de Motzkin calculee par memoisation...
+M0  = 1           M1  = 1           M2  = 2           M3  = 4
+M4  = 9           M5  = 21          M6  = 51          M7  = 127
+M8  = 323         M9  = 835         M10 = 2188        M11 = 5798
+M12 = 15511       M13 = 41835       M14 = 113634      M15 = 310572
+M16 = 853467      M17 = 2356779     M18 = 6536382     M19 = 18199284
+M20 = 50852019    M21 = 142547559   M22 = 400763223   M23 = 1129760415
+M24 = 3192727797  M25 = 9043402501  M26 = 25669818476 M27 = 73007772802
+Temps de calcul:   0.00 secondes
+Mesures (par memoisation)
+Nombre d'affectations    : 2320
+Nombre d'additions       : 1131
+Nombre de multiplications: 351
+Nombre de comparaisons   : 1188
+Nombre de cycles         : indisponible
+Nombre d'instructions    : indisponible
+Branchements mal predits : indisponible
+Defauts de cache         : indisponible
+
+Suite de Motzkin calculee par programmation dynamique...
+M0  = 1           M1  = 1           M2  = 2           M3  = 4
+M4  = 9           M5  = 21          M6  = 51          M7  = 127
+M8  = 323         M9  = 835         M10 = 2188        M11 = 5798
+M12 = 15511       M13 = 41835       M14 = 113634      M15 = 310572
+M16 = 853467      M17 = 2356779     M18 = 6536382     M19 = 18199284
+M20 = 50852019    M21 = 142547559   M22 = 400763223   M23 = 1129760415
+M24 = 3192727797  M25 = 9043402501  M26 = 25669818476 M27 = 73007772802
+Temps de calcul:   0.00 secondes
+Mesures (par programmation dynamique)
+Nombre d'affectations    : 888
+Nombre d'additions       : 1157
+Nombre de multiplications: 351
+Nombre de comparaisons   : 431
+Nombre de cycles         : indisponible
+Nombre d'instructions    : indisponible
+Branchements mal predits : indisponible
+Defauts de cache         : indisponible
+
+
+--banc:
+
+Banc d'essai de TP4A: 11 echantillons, 3 appels d'echauffement
+Noyau                                   Appels     Min (ns) Mediane (ns)     90e (ns)     99e (ns)     Max (ns)
+Motzkin recursif (M0 a M19)                  1   42314479.0   43268083.0   45580278.0   45908844.0   45908844.0
+Motzkin iteratif                           779       1113.2       1125.7       1174.4       1186.6       1186.6
+Motzkin memoise                            641       1418.6       1449.9       1518.8       1614.8       1614.8
+Motzkin dynamique                         1511        443.0        443.6        449.1        464.1        464.1
+*/
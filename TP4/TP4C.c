@@ -4,9 +4,231 @@
  * Ce programme a ete concu pour tester 3 methodes d'integration numeriques
  * (methode du point milieu, de Simpson et de Newton-COtes a 10 points) sur un
  * ensemble de fonctions et de bornes.
+ *
+ * Les methodes evaluent les fonctions par blocs de noeuds pour que le
+ * compilateur puisse vectoriser les fonctions elementaires et les sommes
+ * ponderees; compiler avec optimisations, par exemple
+ * gcc -O3 -march=native TP4C.c -o TP4C -lm -pthread
+ *
+ * Avec l'argument --parallele (suivi facultativement du nombre maximal de fils
+ * d'execution), le programme mesure plutot l'acceleration des methodes
+ * paralleles selon le nombre de fils. Avec l'argument --lot, suivi d'un
+ * fichier de travaux et facultativement d'un fichier de resultats, il
+ * execute plutot chaque travail du fichier (une ligne "numero de fonction,
+ * bornes, methode, tolerance") sur plusieurs fils d'execution et ecrit les
+ * resultats en CSV dans l'ordre du fichier. Avec l'argument --expression,
+ * suivi d'une expression de x et des bornes, par exemple
+ * TP4C --expression "exp(-x*x)*cos(3*x)" 0 2
+ * il compile l'expression en ruban d'instructions et l'integre. Avec
+ * l'argument --vectorielle suivi des bornes, il integre toutes les fonctions
+ * en une seule passe sur les noeuds. Avec l'argument --oscillante, il compare
+ * Simpson aux methodes de Filon et de Levin pour e^x sin(kx), dont le cout ne
+ * depend pas de la frequence k. Avec l'argument --couts suivi d'un numero de
+ * fonction et des bornes, il mesure l'ecart et le cout des variantes de
+ * Simpson et de Newton-Cotes (double-double, sans branches, par lots), que le
+ * mode interactif ne mesure pas. Avec l'argument --banc, il mesure les
+ * methodes sur exp entre 0 et 1 avec le banc d'essai de banc.h (voir ce
+ * fichier pour les options).
+ *
+ * Compile avec -DCOMPTER_OPERATIONS ou -DCOMPTEURS_MATERIELS, le programme
+ * affiche aussi les operations et les compteurs du processeur des methodes sur
+ * la grille commune (voir compteurs.h).
  */
+#include <ctype.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../banc.h"
+#include "../compteurs.h"
+
+/* Temps minimal (en secondes) pendant lequel on repete une methode pour
+ * mesurer son cout */
+#define TEMPS_MESURE 0.05
+/* Nombre de noeuds evalues d'un coup par les methodes vectorielles */
+#define TAILLE_BLOC 256
+/* Nombre magique 1.5 * 2^52: l'ajouter a un double de moins de 2^51 en valeur
+ * absolue l'arrondit a l'entier le plus proche, qu'on retrouve dans les bits
+ * de poids faible de la mantisse */
+#define MAGIQUE 6755399441055744.0
+/* 1 / ln(2) et ln(2) en deux parties (la partie haute a des zeros a la fin,
+ * donc k * LN2_HAUT est exact) pour la reduction de l'exponentielle */
+#define LOG2E 1.44269504088896338700
+#define LN2_HAUT 6.93147180369123816490e-01
+#define LN2_BAS 1.90821492927058770002e-10
+/* 2 / pi et pi / 2 en trois parties pour la reduction du sinus et du cosinus
+ */
+#define DEUX_SUR_PI 6.36619772367581382433e-01
+#define PI_SUR_2_A 1.57079632673412561417e+00
+#define PI_SUR_2_B 6.07710050630396597660e-11
+#define PI_SUR_2_C 2.02226624871116645580e-21
+/* Plus grand argument (2^20 pi / 2) pour lequel la reduction en trois parties
+ * de sin_noyau reste exacte; au-dela, sin_general passe a math.h */
+#define SIN_NOYAU_MAX 1647099.3291652855
+/* Bornes ou l'exponentielle depasse le plus grand double et ou elle passe
+ * sous la moitie du plus petit double denormal, un peu elargies */
+#define EXP_MAX 710.0
+#define EXP_MIN -746.0
+/* Plus grand ordre (nombre d'intervalles par panneau) des regles de
+ * Newton-Cotes fermees; au-dela, les poids exacts depassent les entiers de 64
+ * bits */
+#define ORDRE_NEWTON_COTES_MAX 10
+/* Nombre maximal de niveaux de la methode tanh-sinh: le pas du dernier
+ * niveau est 2^-NIVEAUX_TANH_SINH */
+#define NIVEAUX_TANH_SINH 10
+/* Borne des parametres t de la methode tanh-sinh: a t = 4, les noeuds sont a
+ * environ 1e-37 (en fraction de la largeur) des bornes */
+#define T_MAX_TANH_SINH 4
+/* Nombre de noeuds t > 0 de tous les niveaux de la methode tanh-sinh */
+#define N_NOEUDS_TANH_SINH (T_MAX_TANH_SINH << NIVEAUX_TANH_SINH)
+/* Nombre de fonctions du tableau des fonctions a integrer */
+#define N_FONCTIONS_TEST 10
+/* Nombre de methodes du mode --lot */
+#define N_METHODES_LOT 3
+/* Longueur maximale d'une ligne du fichier de travaux */
+#define LONGUEUR_LIGNE 256
+/* Nombre maximal d'instructions d'un ruban pendant la compilation d'une
+ * expression */
+#define N_INSTRUCTIONS_MAX 256
+/* Nombre maximal de registres d'un ruban, chacun de TAILLE_BLOC doubles */
+#define N_REGISTRES_MAX 32
+/* Plus grand exposant entier remplace par des multiplications */
+#define EXPOSANT_ENTIER_MAX 64
+/* Codes des operations d'un ruban. Les fonctions elementaires suivent
+ * OP_PREMIERE_FONCTION dans l'ordre du tableau nomsFonctionsRuban. */
+#define OP_CONSTANTE 0
+#define OP_X 1
+#define OP_ADDITION 2
+#define OP_SOUSTRACTION 3
+#define OP_MULTIPLICATION 4
+#define OP_DIVISION 5
+#define OP_PUISSANCE 6
+#define OP_OPPOSE 7
+#define OP_PREMIERE_FONCTION 8
+#define OP_EXP 8
+#define OP_LOG 9
+#define OP_SQRT 10
+#define OP_ABS 11
+#define OP_SIN 12
+#define OP_COS 13
+#define OP_TAN 14
+#define OP_ASIN 15
+#define OP_ACOS 16
+#define OP_ATAN 17
+#define OP_SINH 18
+#define OP_COSH 19
+#define OP_TANH 20
+/* Nombre de fonctions elementaires reconnues dans les expressions */
+#define N_FONCTIONS_RUBAN 13
+/* Nombre de morceaux dans lesquels les methodes paralleles coupent les noeuds,
+ * independant du nombre de fils pour que le resultat n'en depende pas */
+#define N_MORCEAUX 64
+/* Nombre maximal de fils d'execution */
+#define N_FILS_MAX 64
+/* Nombre maximal de fonctions dont somme_noeuds_vectorielle garde les cumuls
+ * en meme temps */
+#define N_INTEGRANDES_MAX 16
+/* Nombre d'intervalles utilises pour mesurer l'acceleration parallele (un
+ * multiple de 2 et de 9) */
+#define N_TERMES_PARALLELE 9000000
+/* Erreur absolue visee par les methodes adaptatives */
+#define TOLERANCE_ADAPTATIVE 1e-12
+/* Erreur absolue visee par Simpson pour les integrandes oscillantes, et
+ * nombre maximal d'intervalles pour l'atteindre */
+#define TOLERANCE_OSCILLANTE 1e-8
+#define N_INTERVALLES_OSCILLANTE_MAX (1 << 26)
+/* Nombre d'intervalles de la methode de Filon (un multiple de 2) */
+#define N_TERMES_FILON 64
+/* Nombre de panneaux et de points de collocation par panneau de la methode
+ * de Levin */
+#define N_PANNEAUX_LEVIN 1
+#define N_POINTS_LEVIN 12
+/* Nombre maximal de panneaux gardes par la methode de Gauss-Kronrod */
+#define N_PANNEAUX_MAX 2000
+/* Nombre d'intervalles de la grille commune d'integration(): multiple de
+ * 2 * 10, 2 * 20 et 2 * 30 pour les points milieux, de 10, 20 et 30 pour
+ * Simpson et de 9 pour Newton-Cotes a 10 points */
+#define N_INTERVALLES_GRILLE 360
+/* Nombre maximal d'intervalles pour Simpson lorsqu'on double leur nombre */
+#define N_INTERVALLES_MAX (1 << 24)
+/* Plus grand ordre (nombre de noeuds par panneau) des regles de
+ * Gauss-Legendre */
+#define ORDRE_GAUSS_MAX 64
+/* Nombre maximal d'iterations de Newton pour trouver un noeud de
+ * Gauss-Legendre */
+#define N_ITERATIONS_NEWTON 100
+
+/* Noeuds positifs de la regle de Kronrod a 15 points sur [-1, 1] (les noeuds
+ * impairs sont ceux de la regle de Gauss a 7 points), leurs poids et les poids
+ * de la regle de Gauss correspondante */
+const double noeudsKronrod[8] = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
+const double poidsKronrod[8] = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+const double poidsGauss[4] = {
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327};
+
+/* Noeuds positifs de Gauss-Legendre sur [-1, 1] (en ordre decroissant) et
+ * leurs poids pour les ordres les plus utilises. Ce sont des constantes
+ * precalculees, avec 21 chiffres, et non le resultat d'un calcul du
+ * programme. On a verifie, avec la methode de Newton de regle_Gauss_Legendre
+ * refaite hors du programme en decimal a 60 chiffres, que chacune s'arrondit
+ * au double le plus proche de la vraie valeur. Le calcul en long double de
+ * regle_Gauss_Legendre, qui sert pour les autres ordres, donne les memes
+ * doubles sauf le premier noeud de l'ordre 8, a un ulp, dont la vraie valeur
+ * est presque au milieu de deux doubles. */
+const double noeudsLegendre2[1] = {0.577350269189625764509};
+const double poidsLegendre2[1] = {1.000000000000000000000};
+const double noeudsLegendre4[2] = {
+    0.861136311594052575224, 0.339981043584856264803};
+const double poidsLegendre4[2] = {
+    0.347854845137453857373, 0.652145154862546142627};
+const double noeudsLegendre8[4] = {
+    0.960289856497536231684, 0.796666477413626739592,
+    0.525532409916328985818, 0.183434642495649804939};
+const double poidsLegendre8[4] = {
+    0.101228536290376259153, 0.222381034453374470544,
+    0.313706645877887287338, 0.362683783378361982965};
+const double noeudsLegendre16[8] = {
+    0.989400934991649932596, 0.944575023073232576078,
+    0.865631202387831743880, 0.755404408355003033895,
+    0.617876244402643748447, 0.458016777657227386342,
+    0.281603550779258913230, 0.095012509837637440185};
+const double poidsLegendre16[8] = {
+    0.027152459411754094852, 0.062253523938647892863,
+    0.095158511682492784810, 0.124628971255533872052,
+    0.149595988816576732082, 0.169156519395002538189,
+    0.182603415044923588867, 0.189450610455068496285};
+const double noeudsLegendre32[16] = {
+    0.997263861849481563545, 0.985611511545268335400,
+    0.964762255587506430774, 0.934906075937739689171,
+    0.896321155766052123965, 0.849367613732569970134,
+    0.794483795967942406963, 0.732182118740289680387,
+    0.663044266930215200975, 0.587715757240762329041,
+    0.506899908932229390024, 0.421351276130635345364,
+    0.331868602282127649780, 0.239287362252137074545,
+    0.144471961582796493485, 0.048307665687738316235};
+const double poidsLegendre32[16] = {
+    0.007018610009470096600, 0.016274394730905670605,
+    0.025392065309262059456, 0.034273862913021433103,
+    0.042835898022226680657, 0.050998059262376176196,
+    0.058684093478535547145, 0.065822222776361846838,
+    0.072345794108848506225, 0.078193895787070306472,
+    0.083311924226946755222, 0.087652093004403811143,
+    0.091173878695763884713, 0.093844399080804565639,
+    0.095638720079274859419, 0.096540088514727800567};
 
 /**
  * Toutes les fonctions commencant par le suffixe "integrale_" ci-apres ont
@@ -36,191 +258,3850 @@ double integrale_cos(const double borneInf, const double borneSup) {
     return sin(borneSup) - sin(borneInf);
 }
 
-double integrale_tan(const double borneInf, const double borneSup) {
-    return log(cos(borneInf)) - log(cos(borneSup));
-}
+double integrale_tan(const double borneInf, const double borneSup) {
+    return log(cos(borneInf)) - log(cos(borneSup));
+}
+
+double integrale_asin(const double borneInf, const double borneSup) {
+    return borneSup * asin(borneSup) + sqrt(1 - borneSup * borneSup) -
+           (borneInf * asin(borneInf) + sqrt(1 - borneInf * borneInf));
+}
+
+double integrale_acos(const double borneInf, const double borneSup) {
+    return borneSup * acos(borneSup) - sqrt(1 - borneSup * borneSup) -
+           (borneInf * acos(borneInf) - sqrt(1 - borneInf * borneInf));
+}
+
+double integrale_atan(const double borneInf, const double borneSup) {
+    return borneSup * atan(borneSup) - 0.5 * log(1 + borneSup * borneSup) -
+           (borneInf * atan(borneInf) - 0.5 * log(1 + borneInf * borneInf));
+}
+
+double integrale_sinh(const double borneInf, const double borneSup) {
+    return cosh(borneSup) - cosh(borneInf);
+}
+
+double integrale_cosh(const double borneInf, const double borneSup) {
+    return sinh(borneSup) - sinh(borneInf);
+}
+
+double integrale_tanh(const double borneInf, const double borneSup) {
+    return log(cosh(borneSup)) - log(cosh(borneInf));
+}
+
+/**
+ * Noyaux sans branchement des fonctions elementaires. Contrairement aux
+ * fonctions de math.h, ils ne font que des operations arithmetiques et des
+ * selections, donc le compilateur peut les vectoriser dans les boucles des
+ * fonctions par lots ci-dessous. Ils sont precis a quelques ulp pres sur
+ * tout le domaine de l'exponentielle (qui deborde vers l'infini ou vers 0 comme
+ * celle de math.h) et pour |x| <= SIN_NOYAU_MAX pour le sinus et le cosinus;
+ * sin_general et les fonctions par lots passent a math.h au-dela.
+ */
+
+/**
+ * Cette fonction construit 2^k dans les bits de l'exposant d'un double.
+ *
+ * k : Entier, entre -1022 et 1023.
+ *
+ * return : 2^k.
+ */
+double puissance_de_2(const double k) {
+    /* Les bits de poids faible de decale contiennent k */
+    const double decale = k + MAGIQUE;
+    uint64_t bits;
+    memcpy(&bits, &decale, sizeof bits);
+    bits = (bits + 1023) << 52;
+    double puissance;
+    memcpy(&puissance, &bits, sizeof puissance);
+    return puissance;
+}
+
+/**
+ * Cette fonction trouve l'exponentielle d'un nombre: x = k ln(2) + r, avec
+ * |r| <= ln(2) / 2, puis e^x = 2^k * e^r ou e^r est un polynome de Taylor de
+ * degre 13. On multiplie par 2^k en deux facteurs 2^k1 et 2^(k - k1) qui
+ * sont toujours des doubles normaux, donc le produit deborde vers l'infini ou
+ * devient denormal (puis nul) exactement comme l'exponentielle de math.h.
+ *
+ * x : Argument de l'exponentielle.
+ *
+ * return : e^x.
+ */
+double exp_noyau(double x) {
+    /* Hors de ces bornes le resultat est deja infini ou nul, on ne ramene x
+     * que pour garder k petit (un NaN passe sans changer) */
+    x = x < EXP_MIN ? EXP_MIN : x > EXP_MAX ? EXP_MAX : x;
+
+    /* k est l'entier le plus proche de x / ln(2) */
+    const double decale = x * LOG2E + MAGIQUE;
+    const double k = decale - MAGIQUE;
+    const double r = (x - k * LN2_HAUT) - k * LN2_BAS;
+
+    /* Polynome de Taylor de e^r par la methode de Horner */
+    double p = 1 / 6227020800.0;
+    p = p * r + 1 / 479001600.0;
+    p = p * r + 1 / 39916800.0;
+    p = p * r + 1 / 3628800.0;
+    p = p * r + 1 / 362880.0;
+    p = p * r + 1 / 40320.0;
+    p = p * r + 1 / 5040.0;
+    p = p * r + 1 / 720.0;
+    p = p * r + 1 / 120.0;
+    p = p * r + 1 / 24.0;
+    p = p * r + 1 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1;
+    p = p * r + 1;
+
+    /* k1 est l'entier le plus proche de k / 2 */
+    const double k1 = (k * 0.5 + MAGIQUE) - MAGIQUE;
+    return p * puissance_de_2(k1) * puissance_de_2(k - k1);
+}
+
+/**
+ * Cette fonction trouve le sinus d'un nombre, ou son cosinus puisque
+ * cos(x) = sin(x + pi / 2): x = q pi / 2 + r, avec |r| <= pi / 4, puis on
+ * choisit entre les polynomes de Taylor de sin(r) et de cos(r) et leur signe
+ * selon le quadrant q. La reduction n'est exacte que pour
+ * |x| <= SIN_NOYAU_MAX, utiliser sin_general au-dela. Elle est declaree
+ * inline: sans cela, GCC refuse de l'integrer dans les boucles qui l'appellent
+ * apres un test de domaine, et ces boucles ne sont plus vectorisees.
+ *
+ * x : Argument du sinus.
+ * decalage : 0 pour le sinus, 1 pour le cosinus.
+ *
+ * return : sin(x + decalage * pi / 2).
+ */
+static inline double sin_noyau(const double x, const int decalage) {
+    /* q est l'entier le plus proche de x / (pi / 2) */
+    const double decale = x * DEUX_SUR_PI + MAGIQUE;
+    const double q = decale - MAGIQUE;
+    const double r = ((x - q * PI_SUR_2_A) - q * PI_SUR_2_B) - q * PI_SUR_2_C;
+    const double r2 = r * r;
+
+    /* Polynomes de Taylor de sin(r) (degre 17) et de cos(r) (degre 18) */
+    double s = 1 / 355687428096000.0;
+    s = s * r2 - 1 / 1307674368000.0;
+    s = s * r2 + 1 / 6227020800.0;
+    s = s * r2 - 1 / 39916800.0;
+    s = s * r2 + 1 / 362880.0;
+    s = s * r2 - 1 / 5040.0;
+    s = s * r2 + 1 / 120.0;
+    s = s * r2 - 1 / 6.0;
+    s = r + r * r2 * s;
+
+    double c = -1 / 6402373705728000.0;
+    c = c * r2 + 1 / 20922789888000.0;
+    c = c * r2 - 1 / 87178291200.0;
+    c = c * r2 + 1 / 479001600.0;
+    c = c * r2 - 1 / 3628800.0;
+    c = c * r2 + 1 / 40320.0;
+    c = c * r2 - 1 / 720.0;
+    c = c * r2 + 1 / 24.0;
+    c = c * r2 - 0.5;
+    c = 1 + r2 * c;
+
+    /* Quadrant: les bits de poids faible de decale contiennent q */
+    uint64_t bits;
+    memcpy(&bits, &decale, sizeof bits);
+    const uint64_t quadrant = bits + decalage;
+
+    const double valeur = quadrant & 1 ? c : s;
+    return quadrant & 2 ? -valeur : valeur;
+}
+
+/**
+ * Cette fonction trouve sin(x + decalage * pi / 2) comme sin_noyau, mais
+ * passe a math.h hors du domaine de sin_noyau.
+ *
+ * x : Argument du sinus.
+ * decalage : Nombre de quarts de tour a ajouter, positif.
+ *
+ * return : sin(x + decalage * pi / 2).
+ */
+double sin_general(const double x, const int decalage) {
+    if (fabs(x) <= SIN_NOYAU_MAX) return sin_noyau(x, decalage);
+
+    const double valeur = decalage & 1 ? cos(x) : sin(x);
+    return decalage & 2 ? -valeur : valeur;
+}
+
+/**
+ * Cette fonction trouve sin(x[i] + decalage * pi / 2) pour i allant de 0 a
+ * n - 1. On verifie d'abord que tous les arguments sont dans le domaine de
+ * sin_noyau, pour garder une boucle vectorisable; sinon, ce qui n'arrive pas
+ * pour les arguments courants, tout le lot passe par sin_general. Le test
+ * precede l'ecriture de y, donc x et y peuvent etre le meme tableau.
+ *
+ * x : Arguments du sinus.
+ * y : Tableau ou on ecrit les valeurs.
+ * n : Nombre d'arguments.
+ * decalage : Nombre de quarts de tour a ajouter, positif.
+ */
+void sin_decale_lot(const double x[], double y[], const int n,
+                    const int decalage) {
+    int horsDomaine = 0;
+    for (int i = 0; i < n; i++) horsDomaine |= fabs(x[i]) > SIN_NOYAU_MAX;
+
+    if (horsDomaine)
+        for (int i = 0; i < n; i++) y[i] = sin_general(x[i], decalage);
+    else
+        for (int i = 0; i < n; i++) y[i] = sin_noyau(x[i], decalage);
+}
+
+/**
+ * Cette fonction trouve e^|x| / 2 comme le carre de e^(|x| / 2) divise par 2,
+ * ce qui reste fini jusqu'a |x| = 710.47, comme sinh et cosh, alors que e^|x|
+ * deborde des 709.78.
+ *
+ * x : Argument.
+ *
+ * return : e^|x| / 2.
+ */
+double demi_exp(const double x) {
+    const double h = exp_noyau(fabs(x) * 0.5);
+    return h * (0.5 * h);
+}
+
+/**
+ * Cette fonction trouve le sinus hyperbolique d'un nombre. Pres de 0,
+ * (e^x - e^-x) / 2 perd des chiffres par soustraction, donc on y utilise
+ * plutot le polynome de Taylor de degre 17.
+ *
+ * x : Argument du sinus hyperbolique.
+ *
+ * return : sinh(x).
+ */
+double sinh_noyau(const double x) {
+    const double a = fabs(x);
+    const double moitie = demi_exp(a);
+    const double grand = moitie - 0.25 / moitie;
+
+    const double a2 = a * a;
+    double petit = 1 / 355687428096000.0;
+    petit = petit * a2 + 1 / 1307674368000.0;
+    petit = petit * a2 + 1 / 6227020800.0;
+    petit = petit * a2 + 1 / 39916800.0;
+    petit = petit * a2 + 1 / 362880.0;
+    petit = petit * a2 + 1 / 5040.0;
+    petit = petit * a2 + 1 / 120.0;
+    petit = petit * a2 + 1 / 6.0;
+    petit = a + a * a2 * petit;
+
+    return copysign(a < 1 ? petit : grand, x);
+}
+
+/**
+ * Fonctions par lots: elles calculent y[i] = f(x[i]) pour i allant de 0 a
+ * n - 1. Les fonctions exp, sin, cos, tan, sinh, cosh et tanh utilisent les
+ * noyaux vectorisables ci-dessus. Pour asin, acos et atan, on garde math.h
+ * dans une boucle simple, que le compilateur peut remplacer par sa
+ * bibliotheque vectorielle quand il en a une. x et y peuvent etre le meme
+ * tableau (le ruban les appelle ainsi).
+ *
+ * x : Noeuds ou evaluer la fonction.
+ * y : Tableau ou on ecrit les valeurs.
+ * n : Nombre de noeuds.
+ * contexte : Ignore par ces fonctions.
+ */
+void exp_lot(const double x[], double y[], const int n, const void* contexte) {
+    (void)contexte;
+    for (int i = 0; i < n; i++) y[i] = exp_noyau(x[i]);
+}
+
+void sin_lot(const double x[], double y[], const int n, const void* contexte) {
+    (void)contexte;
+    sin_decale_lot(x, y, n, 0);
+}
+
+void cos_lot(const double x[], double y[], const int n, const void* contexte) {
+    (void)contexte;
+    sin_decale_lot(x, y, n, 1);
+}
+
+void tan_lot(const double x[], double y[], const int n, const void* contexte) {
+    (void)contexte;
+    for (int i = 0; i < n; i++)
+        y[i] = sin_general(x[i], 0) / sin_general(x[i], 1);
+}
+
+void asin_lot(const double x[], double y[], const int n, const void* contexte) {
+    (void)contexte;
+    for (int i = 0; i < n; i++) y[i] = asin(x[i]);
+}
+
+void acos_lot(const double x[], double y[], const int n, const void* contexte) {
+    (void)contexte;
+    for (int i = 0; i < n; i++) y[i] = acos(x[i]);
+}
+
+void atan_lot(const double x[], double y[], const int n, const void* contexte) {
+    (void)contexte;
+    for (int i = 0; i < n; i++) y[i] = atan(x[i]);
+}
+
+void sinh_lot(const double x[], double y[], const int n, const void* contexte) {
+    (void)contexte;
+    for (int i = 0; i < n; i++) y[i] = sinh_noyau(x[i]);
+}
+
+void cosh_lot(const double x[], double y[], const int n, const void* contexte) {
+    (void)contexte;
+    for (int i = 0; i < n; i++) {
+        const double moitie = demi_exp(x[i]);
+        y[i] = moitie + 0.25 / moitie;
+    }
+}
+
+/* tanh(x) = 1 - 2 / (e^2|x| + 1) au signe pres, qui tend vers 1 sans
+ * deborder; pres de 0, ou cette forme perd des chiffres, on prend
+ * sinh / cosh */
+void tanh_lot(const double x[], double y[], const int n, const void* contexte) {
+    (void)contexte;
+    for (int i = 0; i < n; i++) {
+        const double a = fabs(x[i]);
+        const double moitie = demi_exp(a);
+        const double petit = sinh_noyau(a) / (moitie + 0.25 / moitie);
+        const double grand = 1 - 2 / (exp_noyau(2 * a) + 1);
+        y[i] = copysign(a < 1 ? petit : grand, x[i]);
+    }
+}
+
+/**
+ * Instruction d'un ruban: code de l'operation, registre ou on ecrit le
+ * resultat, registres des operandes (0, jamais lu, s'il n'y en a pas) et
+ * valeur des constantes. Pendant la compilation, la destination n'est pas
+ * encore choisie et les operandes sont les indices des instructions qui les
+ * calculent (-1 s'il n'y en a pas).
+ */
+struct instruction {
+    int operation, destination, a, b;
+    double valeur;
+};
+
+/**
+ * Expression compilee en ruban: suite d'instructions sans branchement,
+ * executees dans l'ordre sur des blocs de noeuds. Les nConstantes premieres
+ * instructions sont les constantes, dont les registres ne sont remplis qu'une
+ * fois par appel. Le resultat est le registre qui contient la valeur de
+ * l'expression.
+ */
+struct ruban {
+    struct instruction instructions[N_INSTRUCTIONS_MAX];
+    int nInstructions, nConstantes, nRegistres, resultat;
+};
+
+/* Noms des fonctions elementaires, dans l'ordre de leurs codes */
+const char* nomsFonctionsRuban[N_FONCTIONS_RUBAN] = {
+    "exp",  "log",  "sqrt", "abs",  "sin",  "cos", "tan",
+    "asin", "acos", "atan", "sinh", "cosh", "tanh"};
+
+/**
+ * Etat de la compilation d'une expression: debut du texte, prochain caractere
+ * a lire, ruban en construction et premiere erreur rencontree (NULL s'il n'y
+ * en a pas), avec sa position dans le texte.
+ */
+struct compilation {
+    const char *texte, *position;
+    struct ruban* ruban;
+    const char* erreur;
+    int positionErreur;
+};
+
+/**
+ * Cette fonction applique une operation a des operandes constants, pour
+ * plier les constantes pendant la compilation.
+ *
+ * operation : Code de l'operation.
+ * a : Premier operande.
+ * b : Second operande, ignore par les operations a un operande.
+ *
+ * return : Resultat de l'operation.
+ */
+double appliquer_operation(const int operation, const double a,
+                           const double b) {
+    switch (operation) {
+        case OP_ADDITION:
+            return a + b;
+        case OP_SOUSTRACTION:
+            return a - b;
+        case OP_MULTIPLICATION:
+            return a * b;
+        case OP_DIVISION:
+            return a / b;
+        case OP_PUISSANCE:
+            return pow(a, b);
+        case OP_OPPOSE:
+            return -a;
+        case OP_EXP:
+            return exp(a);
+        case OP_LOG:
+            return log(a);
+        case OP_SQRT:
+            return sqrt(a);
+        case OP_ABS:
+            return fabs(a);
+        case OP_SIN:
+            return sin(a);
+        case OP_COS:
+            return cos(a);
+        case OP_TAN:
+            return tan(a);
+        case OP_ASIN:
+            return asin(a);
+        case OP_ACOS:
+            return acos(a);
+        case OP_ATAN:
+            return atan(a);
+        case OP_SINH:
+            return sinh(a);
+        case OP_COSH:
+            return cosh(a);
+        case OP_TANH:
+            return tanh(a);
+        default:
+            return NAN;
+    }
+}
+
+/**
+ * Cette fonction garde la premiere erreur de la compilation et la position
+ * courante dans le texte.
+ *
+ * compilation : Etat de la compilation.
+ * message : Description de l'erreur.
+ *
+ * return : -1, l'indice qui indique une erreur aux fonctions appelantes.
+ */
+int signaler_erreur(struct compilation* compilation, const char message[]) {
+    if (!compilation->erreur) {
+        compilation->erreur = message;
+        compilation->positionErreur =
+            (int)(compilation->position - compilation->texte);
+    }
+    return -1;
+}
+
+/**
+ * Cette fonction ajoute une instruction au ruban en construction. Si tous ses
+ * operandes sont constants, elle est remplacee par la constante qu'elle
+ * calcule (pliage des constantes), et si une instruction identique existe
+ * deja, on reprend son resultat au lieu de le recalculer (elimination des
+ * sous-expressions communes).
+ *
+ * compilation : Etat de la compilation.
+ * operation : Code de l'operation.
+ * a : Indice de l'instruction du premier operande, -1 s'il n'y en a pas.
+ * b : Indice de l'instruction du second operande, -1 s'il n'y en a pas.
+ * valeur : Valeur d'une constante.
+ *
+ * return : Indice de l'instruction qui calcule le resultat, -1 en cas
+ * d'erreur.
+ */
+int emettre(struct compilation* compilation, int operation, int a, int b,
+            double valeur) {
+    struct ruban* ruban = compilation->ruban;
+    const struct instruction* instructions = ruban->instructions;
+    /* Nombre d'operandes de l'operation */
+    int arite = operation <= OP_X           ? 0
+                      : operation <= OP_PUISSANCE ? 2
+                                                  : 1;
+
+    /* Un operande manquant vient d'une erreur deja signalee */
+    if ((arite >= 1 && a < 0) || (arite == 2 && b < 0)) return -1;
+
+    if (arite >= 1 && instructions[a].operation == OP_CONSTANTE &&
+        (arite == 1 || instructions[b].operation == OP_CONSTANTE)) {
+        valeur = appliquer_operation(operation, instructions[a].valeur,
+                                     arite == 2 ? instructions[b].valeur : 0);
+        operation = OP_CONSTANTE;
+        arite = 0;
+    }
+    if (arite < 2) b = -1;
+    if (arite < 1) a = -1;
+
+    /* Ordre fixe des operandes des operations commutatives, pour que x * y et
+     * y * x soient la meme sous-expression */
+    if ((operation == OP_ADDITION || operation == OP_MULTIPLICATION) && a > b) {
+        const int temporaire = a;
+        a = b;
+        b = temporaire;
+    }
+
+    /* Les constantes sont comparees bit a bit, pour distinguer 0 et -0 */
+    for (int i = 0; i < ruban->nInstructions; i++)
+        if (instructions[i].operation == operation && instructions[i].a == a &&
+            instructions[i].b == b &&
+            (operation != OP_CONSTANTE ||
+             !memcmp(&instructions[i].valeur, &valeur, sizeof valeur)))
+            return i;
+
+    if (ruban->nInstructions == N_INSTRUCTIONS_MAX)
+        return signaler_erreur(compilation, "expression trop longue");
+    ruban->instructions[ruban->nInstructions] =
+        (struct instruction){operation, -1, a, b, valeur};
+    return ruban->nInstructions++;
+}
+
+/**
+ * Cette fonction saute les espaces avant le prochain symbole.
+ *
+ * compilation : Etat de la compilation.
+ */
+void sauter_espaces(struct compilation* compilation) {
+    while (isspace((unsigned char)*compilation->position))
+        compilation->position++;
+}
+
+/**
+ * Cette fonction lit un caractere obligatoire, comme une parenthese.
+ *
+ * compilation : Etat de la compilation.
+ * caractere : Caractere attendu.
+ * message : Erreur a signaler s'il est absent.
+ *
+ * return : 1 si le caractere etait present, 0 sinon.
+ */
+int attendre(struct compilation* compilation, const char caractere,
+             const char message[]) {
+    sauter_espaces(compilation);
+    if (*compilation->position != caractere) {
+        signaler_erreur(compilation, message);
+        return 0;
+    }
+    compilation->position++;
+    return 1;
+}
+
+/**
+ * Toutes les fonctions commencant par le prefixe "compiler_" ci-apres lisent
+ * une partie de l'expression par descente recursive, selon la grammaire
+ *
+ *     somme     = produit { ("+" | "-") produit }
+ *     produit   = facteur { ("*" | "/") facteur }
+ *     facteur   = ("-" | "+") facteur | puissance
+ *     puissance = primaire [ "^" facteur ]
+ *     primaire  = nombre | "x" | "pi" | fonction "(" somme ")" | "(" somme ")"
+ *
+ * et emettent les instructions qui la calculent.
+ *
+ * compilation : Etat de la compilation.
+ *
+ * return : Indice de l'instruction qui calcule la partie lue, -1 en cas
+ * d'erreur.
+ */
+int compiler_somme(struct compilation* compilation);
+
+int compiler_primaire(struct compilation* compilation) {
+    sauter_espaces(compilation);
+    const char* debut = compilation->position;
+
+    if (isdigit((unsigned char)*debut) || *debut == '.') {
+        char* fin;
+        const double valeur = strtod(debut, &fin);
+        if (fin == debut)
+            return signaler_erreur(compilation, "nombre invalide");
+        compilation->position = fin;
+        return emettre(compilation, OP_CONSTANTE, -1, -1, valeur);
+    }
+
+    if (*debut == '(') {
+        compilation->position++;
+        const int resultat = compiler_somme(compilation);
+        return attendre(compilation, ')', "parenthese fermante attendue")
+                   ? resultat
+                   : -1;
+    }
+
+    if (isalpha((unsigned char)*debut)) {
+        /* Longueur du nom */
+        int longueur = 0;
+        while (isalnum((unsigned char)debut[longueur])) longueur++;
+
+        if (longueur == 1 && *debut == 'x') {
+            compilation->position++;
+            return emettre(compilation, OP_X, -1, -1, 0);
+        }
+        if (longueur == 2 && !strncmp(debut, "pi", 2)) {
+            compilation->position += 2;
+            return emettre(compilation, OP_CONSTANTE, -1, -1, M_PI);
+        }
+        for (int i = 0; i < N_FONCTIONS_RUBAN; i++)
+            if ((int)strlen(nomsFonctionsRuban[i]) == longueur &&
+                !strncmp(debut, nomsFonctionsRuban[i], longueur)) {
+                compilation->position += longueur;
+                if (!attendre(compilation, '(',
+                              "parenthese ouvrante attendue"))
+                    return -1;
+                const int argument = compiler_somme(compilation);
+                if (!attendre(compilation, ')',
+                              "parenthese fermante attendue"))
+                    return -1;
+                return emettre(compilation, OP_PREMIERE_FONCTION + i,
+                               argument, -1, 0);
+            }
+        return signaler_erreur(compilation, "nom inconnu");
+    }
+
+    return signaler_erreur(compilation,
+                           *debut ? "symbole inattendu" : "fin inattendue");
+}
+
+/**
+ * Cette fonction emet base^n par exponentiation rapide, avec au plus
+ * 2 log2(|n|) multiplications, au lieu d'un appel a pow pour chaque noeud.
+ *
+ * compilation : Etat de la compilation.
+ * base : Indice de l'instruction qui calcule la base.
+ * n : Exposant entier.
+ *
+ * return : Indice de l'instruction qui calcule base^n.
+ */
+int puissance_entiere(struct compilation* compilation, const int base,
+                      const int n) {
+    /* Produit des puissances retenues et puissance base^(2^k) courante */
+    int resultat = -1, carre = base;
+
+    if (n == 0) return emettre(compilation, OP_CONSTANTE, -1, -1, 1);
+
+    for (int m = abs(n); m; m >>= 1) {
+        if (m & 1)
+            resultat = resultat < 0 ? carre
+                                    : emettre(compilation, OP_MULTIPLICATION,
+                                              resultat, carre, 0);
+        if (m > 1)
+            carre = emettre(compilation, OP_MULTIPLICATION, carre, carre, 0);
+    }
+
+    if (n < 0)
+        resultat =
+            emettre(compilation, OP_DIVISION,
+                    emettre(compilation, OP_CONSTANTE, -1, -1, 1), resultat, 0);
+    return resultat;
+}
+
+int compiler_facteur(struct compilation* compilation);
+
+int compiler_puissance(struct compilation* compilation) {
+    const int base = compiler_primaire(compilation);
+
+    sauter_espaces(compilation);
+    if (*compilation->position != '^') return base;
+    compilation->position++;
+
+    const int exposant = compiler_facteur(compilation);
+    if (base < 0 || exposant < 0) return -1;
+
+    /* Les petits exposants entiers d'une base variable deviennent des
+     * multiplications */
+    const struct instruction* instructions = compilation->ruban->instructions;
+    const double valeur = instructions[exposant].valeur;
+    if (instructions[base].operation != OP_CONSTANTE &&
+        instructions[exposant].operation == OP_CONSTANTE &&
+        valeur == rint(valeur) && fabs(valeur) <= EXPOSANT_ENTIER_MAX)
+        return puissance_entiere(compilation, base, (int)valeur);
+
+    return emettre(compilation, OP_PUISSANCE, base, exposant, 0);
+}
+
+int compiler_facteur(struct compilation* compilation) {
+    sauter_espaces(compilation);
+
+    if (*compilation->position == '-') {
+        compilation->position++;
+        return emettre(compilation, OP_OPPOSE, compiler_facteur(compilation),
+                       -1, 0);
+    }
+    if (*compilation->position == '+') {
+        compilation->position++;
+        return compiler_facteur(compilation);
+    }
+
+    return compiler_puissance(compilation);
+}
+
+int compiler_produit(struct compilation* compilation) {
+    int resultat = compiler_facteur(compilation);
+
+    for (;;) {
+        sauter_espaces(compilation);
+        const char operateur = *compilation->position;
+        if (operateur != '*' && operateur != '/') return resultat;
+        compilation->position++;
+        resultat = emettre(
+            compilation, operateur == '*' ? OP_MULTIPLICATION : OP_DIVISION,
+            resultat, compiler_facteur(compilation), 0);
+    }
+}
+
+int compiler_somme(struct compilation* compilation) {
+    int resultat = compiler_produit(compilation);
+
+    for (;;) {
+        sauter_espaces(compilation);
+        const char operateur = *compilation->position;
+        if (operateur != '+' && operateur != '-') return resultat;
+        compilation->position++;
+        resultat = emettre(
+            compilation, operateur == '+' ? OP_ADDITION : OP_SOUSTRACTION,
+            resultat, compiler_produit(compilation), 0);
+    }
+}
+
+/**
+ * Cette fonction termine la compilation: elle retire les instructions dont le
+ * resultat ne sert plus (les constantes pliees, par exemple), place les
+ * constantes au debut du ruban et donne un registre a chaque instruction.
+ * Les registres sont alloues par balayage lineaire: le registre d'une valeur
+ * est libere apres sa derniere lecture et peut etre repris par le resultat de
+ * cette meme instruction, qui lit et ecrit ses registres element par element.
+ * Les fonctions par lots appelees par le ruban doivent donc accepter x et y
+ * dans le meme tableau (voir sin_decale_lot). Les constantes gardent leur
+ * registre jusqu'a la fin.
+ *
+ * compilation : Etat de la compilation.
+ * resultat : Indice de l'instruction qui calcule l'expression.
+ */
+void allouer_registres(struct compilation* compilation, const int resultat) {
+    struct ruban* ruban = compilation->ruban;
+    struct instruction* instructions = ruban->instructions;
+    /* Instructions gardees, dans leur nouvel ordre */
+    struct instruction gardees[N_INSTRUCTIONS_MAX];
+    /* Nouvel indice de chaque instruction, -1 si elle est retiree */
+    int nouvelIndice[N_INSTRUCTIONS_MAX];
+    /* Indice de la derniere instruction qui lit chaque valeur */
+    int derniereLecture[N_INSTRUCTIONS_MAX];
+    /* Pile des registres libres */
+    int registresLibres[N_REGISTRES_MAX], nLibres = 0;
+    int n = 0;
+
+    /* Une instruction est utile si elle calcule le resultat ou un operande
+     * d'une instruction utile, qui la suit toujours dans le ruban */
+    for (int i = 0; i < ruban->nInstructions; i++) nouvelIndice[i] = -1;
+    nouvelIndice[resultat] = 0;
+    for (int i = ruban->nInstructions - 1; i >= 0; i--)
+        if (nouvelIndice[i] >= 0) {
+            if (instructions[i].a >= 0) nouvelIndice[instructions[i].a] = 0;
+            if (instructions[i].b >= 0) nouvelIndice[instructions[i].b] = 0;
+        }
+
+    /* Constantes, puis les autres instructions dans leur ordre */
+    for (int constantes = 1; constantes >= 0; constantes--) {
+        for (int i = 0; i < ruban->nInstructions; i++)
+            if (nouvelIndice[i] >= 0 &&
+                (instructions[i].operation == OP_CONSTANTE) == constantes) {
+                nouvelIndice[i] = n;
+                gardees[n++] = instructions[i];
+            }
+        if (constantes) ruban->nConstantes = n;
+    }
+    for (int i = 0; i < n; i++) {
+        if (gardees[i].a >= 0) gardees[i].a = nouvelIndice[gardees[i].a];
+        if (gardees[i].b >= 0) gardees[i].b = nouvelIndice[gardees[i].b];
+        derniereLecture[i] = i;
+    }
+    for (int i = 0; i < n; i++) {
+        if (gardees[i].a >= 0) derniereLecture[gardees[i].a] = i;
+        if (gardees[i].b >= 0) derniereLecture[gardees[i].b] = i;
+    }
+    for (int i = 0; i < ruban->nConstantes; i++) derniereLecture[i] = n;
+    derniereLecture[nouvelIndice[resultat]] = n;
+
+    ruban->nRegistres = 0;
+    for (int i = 0; i < n; i++) {
+        const int a = gardees[i].a, b = gardees[i].b;
+        if (a >= 0 && derniereLecture[a] == i)
+            registresLibres[nLibres++] = gardees[a].destination;
+        if (b >= 0 && b != a && derniereLecture[b] == i)
+            registresLibres[nLibres++] = gardees[b].destination;
+
+        if (nLibres)
+            gardees[i].destination = registresLibres[--nLibres];
+        else if (ruban->nRegistres < N_REGISTRES_MAX)
+            gardees[i].destination = ruban->nRegistres++;
+        else {
+            signaler_erreur(compilation, "trop de registres");
+            return;
+        }
+    }
+
+    /* Les operandes deviennent des registres */
+    for (int i = 0; i < n; i++) {
+        instructions[i] = gardees[i];
+        instructions[i].a =
+            gardees[i].a >= 0 ? gardees[gardees[i].a].destination : 0;
+        instructions[i].b =
+            gardees[i].b >= 0 ? gardees[gardees[i].b].destination : 0;
+    }
+    ruban->nInstructions = n;
+    ruban->resultat = gardees[nouvelIndice[resultat]].destination;
+}
+
+/**
+ * Cette fonction compile une expression de la variable x en ruban.
+ *
+ * texte : Expression, par exemple "exp(-x*x)*cos(3*x)".
+ * ruban : Ruban ou on ecrit l'expression compilee.
+ * positionErreur : Pointeur ou on ecrit la position de l'erreur.
+ *
+ * return : Description de l'erreur, NULL si l'expression est valide.
+ */
+const char* compiler_expression(const char texte[], struct ruban* ruban,
+                                int* positionErreur) {
+    struct compilation compilation = {texte, texte, ruban, NULL, 0};
+
+    ruban->nInstructions = 0;
+    const int resultat = compiler_somme(&compilation);
+    sauter_espaces(&compilation);
+    if (*compilation.position)
+        signaler_erreur(&compilation, "symbole inattendu");
+    if (!compilation.erreur) allouer_registres(&compilation, resultat);
+
+    *positionErreur = compilation.positionErreur;
+    return compilation.erreur;
+}
+
+/**
+ * Cette fonction evalue un ruban par lots, avec la signature des fonctions
+ * par lots. Chaque instruction est appliquee a un bloc entier de noeuds par
+ * une boucle simple que le compilateur vectorise; le choix de l'operation ne
+ * coute donc qu'une fois par instruction et par bloc, pas a chaque noeud.
+ * Les fonctions elementaires utilisent les memes noyaux que exp_lot, sin_lot,
+ * etc.
+ *
+ * x : Noeuds ou evaluer l'expression.
+ * y : Tableau ou on ecrit les valeurs.
+ * n : Nombre de noeuds.
+ * contexte : Pointeur vers le struct ruban a evaluer.
+ */
+void ruban_lot(const double x[], double y[], const int n,
+               const void* contexte) {
+    const struct ruban* ruban = contexte;
+    double registres[N_REGISTRES_MAX][TAILLE_BLOC];
+
+    for (int k = 0; k < ruban->nConstantes; k++)
+        for (int j = 0; j < TAILLE_BLOC; j++)
+            registres[ruban->instructions[k].destination][j] =
+                ruban->instructions[k].valeur;
+
+    for (int debut = 0; debut < n; debut += TAILLE_BLOC) {
+        /* Nombre de noeuds du bloc */
+        const int m = n - debut < TAILLE_BLOC ? n - debut : TAILLE_BLOC;
+
+        for (int k = ruban->nConstantes; k < ruban->nInstructions; k++) {
+            const struct instruction* instruction = &ruban->instructions[k];
+            double* d = registres[instruction->destination];
+            const double* a = registres[instruction->a];
+            const double* b = registres[instruction->b];
+
+            switch (instruction->operation) {
+                case OP_X:
+                    for (int j = 0; j < m; j++) d[j] = x[debut + j];
+                    break;
+                case OP_ADDITION:
+                    for (int j = 0; j < m; j++) d[j] = a[j] + b[j];
+                    break;
+                case OP_SOUSTRACTION:
+                    for (int j = 0; j < m; j++) d[j] = a[j] - b[j];
+                    break;
+                case OP_MULTIPLICATION:
+                    for (int j = 0; j < m; j++) d[j] = a[j] * b[j];
+                    break;
+                case OP_DIVISION:
+                    for (int j = 0; j < m; j++) d[j] = a[j] / b[j];
+                    break;
+                case OP_PUISSANCE:
+                    for (int j = 0; j < m; j++) d[j] = pow(a[j], b[j]);
+                    break;
+                case OP_OPPOSE:
+                    for (int j = 0; j < m; j++) d[j] = -a[j];
+                    break;
+                case OP_EXP:
+                    exp_lot(a, d, m, NULL);
+                    break;
+                case OP_LOG:
+                    for (int j = 0; j < m; j++) d[j] = log(a[j]);
+                    break;
+                case OP_SQRT:
+                    for (int j = 0; j < m; j++) d[j] = sqrt(a[j]);
+                    break;
+                case OP_ABS:
+                    for (int j = 0; j < m; j++) d[j] = fabs(a[j]);
+                    break;
+                case OP_SIN:
+                    sin_lot(a, d, m, NULL);
+                    break;
+                case OP_COS:
+                    cos_lot(a, d, m, NULL);
+                    break;
+                case OP_TAN:
+                    tan_lot(a, d, m, NULL);
+                    break;
+                case OP_ASIN:
+                    asin_lot(a, d, m, NULL);
+                    break;
+                case OP_ACOS:
+                    acos_lot(a, d, m, NULL);
+                    break;
+                case OP_ATAN:
+                    atan_lot(a, d, m, NULL);
+                    break;
+                case OP_SINH:
+                    sinh_lot(a, d, m, NULL);
+                    break;
+                case OP_COSH:
+                    cosh_lot(a, d, m, NULL);
+                    break;
+                case OP_TANH:
+                    tanh_lot(a, d, m, NULL);
+                    break;
+            }
+        }
+
+        for (int j = 0; j < m; j++)
+            y[debut + j] = registres[ruban->resultat][j];
+    }
+}
+
+/**
+ * Cette fonction evalue un ruban en un seul noeud avec math.h (par
+ * appliquer_operation), sans les noyaux ni les registres partages de
+ * ruban_lot. Elle sert a verifier ruban_lot.
+ *
+ * ruban : Ruban a evaluer.
+ * x : Noeud ou evaluer l'expression.
+ *
+ * return : Valeur de l'expression en x.
+ */
+double ruban_scalaire(const struct ruban* ruban, const double x) {
+    double registres[N_REGISTRES_MAX];
+
+    for (int k = 0; k < ruban->nInstructions; k++) {
+        const struct instruction* instruction = &ruban->instructions[k];
+        const int operation = instruction->operation;
+        registres[instruction->destination] =
+            operation == OP_CONSTANTE ? instruction->valeur
+            : operation == OP_X
+                ? x
+                : appliquer_operation(operation, registres[instruction->a],
+                                      registres[instruction->b]);
+    }
+
+    return registres[ruban->resultat];
+}
+
+/**
+ * Cette fonction trouve le plus grand ecart entre ruban_lot et ruban_scalaire
+ * sur n noeuds equidistants entre deux bornes. L'ecart est relatif pour les
+ * valeurs de plus de 1 en valeur absolue et absolu sinon; deux valeurs egales
+ * (infinies ou NaN comprises) ne s'ecartent pas.
+ *
+ * ruban : Ruban a verifier.
+ * borneInf : Premier noeud.
+ * borneSup : Dernier noeud.
+ * n : Nombre de noeuds, au moins 2.
+ *
+ * return : Le plus grand ecart, NaN si une seule des deux valeurs est NaN.
+ */
+double verifier_ruban(const struct ruban* ruban, const double borneInf,
+                      const double borneSup, const int n) {
+    const double pas = (borneSup - borneInf) / (n - 1);
+    double x[TAILLE_BLOC], y[TAILLE_BLOC];
+    double ecartMax = 0;
+
+    for (int debut = 0; debut < n; debut += TAILLE_BLOC) {
+        /* Nombre de noeuds du bloc */
+        const int m = n - debut < TAILLE_BLOC ? n - debut : TAILLE_BLOC;
+        for (int j = 0; j < m; j++) x[j] = borneInf + (debut + j) * pas;
+        ruban_lot(x, y, m, ruban);
+
+        for (int j = 0; j < m; j++) {
+            const double attendu = ruban_scalaire(ruban, x[j]);
+            if (y[j] == attendu || (isnan(y[j]) && isnan(attendu))) continue;
+            const double ecart =
+                fabs(y[j] - attendu) / fmax(fabs(attendu), 1);
+            if (!(ecart <= ecartMax)) ecartMax = ecart;
+        }
+    }
+
+    return ecartMax;
+}
+
+/**
+ * Cette fonction affiche les instructions d'un ruban, une par ligne.
+ *
+ * ruban : Ruban a afficher.
+ */
+void afficher_ruban(const struct ruban* ruban) {
+    /* Symboles des operations a deux operandes */
+    const char symboles[] = "+-*/^";
+
+    for (int k = 0; k < ruban->nInstructions; k++) {
+        const struct instruction* instruction = &ruban->instructions[k];
+        const int operation = instruction->operation;
+
+        printf("    r%-2d = ", instruction->destination);
+        if (operation == OP_CONSTANTE)
+            printf("%.17g\n", instruction->valeur);
+        else if (operation == OP_X)
+            printf("x\n");
+        else if (operation == OP_OPPOSE)
+            printf("-r%d\n", instruction->a);
+        else if (operation >= OP_PREMIERE_FONCTION)
+            printf("%s(r%d)\n",
+                   nomsFonctionsRuban[operation - OP_PREMIERE_FONCTION],
+                   instruction->a);
+        else
+            printf("r%d %c r%d\n", instruction->a,
+                   symboles[operation - OP_ADDITION], instruction->b);
+    }
+}
+
+/**
+ * Fonction a integrer. Elle peut etre donnee par lots (lot n'est pas NULL),
+ * ce qui permet la vectorisation, ou seulement par une fonction scalaire de
+ * math.h, auquel cas evaluer_lot sert d'adaptateur. Le contexte est passe tel
+ * quel a la fonction par lots (parametres de la fonction, par exemple).
+ */
+struct integrande {
+    void (*lot)(const double x[], double y[], int n, const void* contexte);
+    double (*scalaire)(double);
+    const void* contexte;
+};
+
+/**
+ * Cette fonction evalue une fonction a integrer sur un bloc de noeuds, par
+ * lots si c'est possible et noeud par noeud sinon.
+ *
+ * integrande : Fonction a integrer.
+ * x : Noeuds ou evaluer la fonction.
+ * y : Tableau ou on ecrit les valeurs.
+ * n : Nombre de noeuds.
+ */
+void evaluer_lot(const struct integrande* integrande, const double x[],
+                 double y[], const int n) {
+    if (integrande->lot)
+        integrande->lot(x, y, n, integrande->contexte);
+    else
+        for (int i = 0; i < n; i++) y[i] = integrande->scalaire(x[i]);
+}
+
+/**
+ * Cette fonction trouve la somme des poids[i] * valeurs[i]. On garde quatre
+ * sommes partielles independantes, ce qui permet au compilateur de faire
+ * plusieurs produits a la fois sans changer l'ordre des additions d'une
+ * compilation a l'autre.
+ *
+ * poids : Poids de chaque valeur.
+ * valeurs : Valeurs a sommer.
+ * n : Nombre de valeurs.
+ *
+ * return : La somme ponderee.
+ */
+double somme_ponderee(const double poids[], const double valeurs[],
+                      const int n) {
+    double partielles[4] = {0, 0, 0, 0};
+
+    int i;
+    for (i = 0; i + 4 <= n; i += 4)
+        for (int j = 0; j < 4; j++)
+            partielles[j] += poids[i + j] * valeurs[i + j];
+    for (; i < n; i++) partielles[0] += poids[i] * valeurs[i];
+
+    return (partielles[0] + partielles[1]) + (partielles[2] + partielles[3]);
+}
+
+/**
+ * Regle de Newton-Cotes fermee composee d'un certain ordre: poids entiers
+ * des noeuds interieurs selon leur indice modulo l'ordre (le noeud 0 d'un
+ * panneau est partage par deux panneaux, donc son poids est double), poids
+ * des deux extremites et facteur numerateur / denominateur par lequel on
+ * multiplie le pas.
+ */
+struct regle_newton_cotes {
+    double poids[ORDRE_NEWTON_COTES_MAX];
+    double extremite, numerateur, denominateur;
+};
+
+/* Regles deja calculees, selon leur ordre (denominateur nul sinon) */
+struct regle_newton_cotes reglesNewtonCotes[ORDRE_NEWTON_COTES_MAX + 1];
+
+/**
+ * Cette fonction trouve le plus grand commun diviseur de deux entiers par
+ * l'algorithme d'Euclide.
+ *
+ * a : Premier entier.
+ * b : Deuxieme entier.
+ *
+ * return : Le plus grand commun diviseur, positif.
+ */
+long long pgcd(long long a, long long b) {
+    while (b) {
+        const long long reste = a % b;
+        a = b;
+        b = reste;
+    }
+    return a < 0 ? -a : a;
+}
+
+/**
+ * Cette fonction trouve la regle de Newton-Cotes fermee d'un certain ordre.
+ * Le poids du noeud i d'un panneau [0, ordre] (en unites de pas) est
+ * l'integrale du polynome de Lagrange prod(t - j) / prod(i - j), j != i. On
+ * la calcule exactement en fractions d'entiers: avec L = ppcm(1, ..., ordre +
+ * 1), L * integrale(t^k) = ordre^(k + 1) * L / (k + 1) est entier. Les poids
+ * sont ensuite mis au meme denominateur et divises par leur plus grand commun
+ * diviseur, ce qui redonne par exemple 1, 4, 1 et 1 / 3 pour Simpson. La
+ * regle est gardee pour les appels suivants.
+ *
+ * ordre : Nombre d'intervalles par panneau, entre 1 et
+ * ORDRE_NEWTON_COTES_MAX.
+ *
+ * return : La regle, NULL si l'ordre n'est pas permis.
+ */
+const struct regle_newton_cotes* regle_Newton_Cotes(const int ordre) {
+    if (ordre < 1 || ordre > ORDRE_NEWTON_COTES_MAX) return NULL;
+
+    struct regle_newton_cotes* regle = &reglesNewtonCotes[ordre];
+    if (regle->denominateur) return regle;
+
+    /* Poids exacts numerateurs[i] / denominateurs[i] */
+    long long numerateurs[ORDRE_NEWTON_COTES_MAX + 1];
+    long long denominateurs[ORDRE_NEWTON_COTES_MAX + 1];
+    /* Plus petit commun multiple de 1, ..., ordre + 1 */
+    long long ppcm = 1;
+    for (long long k = 2; k <= ordre + 1; k++) ppcm = ppcm / pgcd(ppcm, k) * k;
+
+    for (int i = 0; i <= ordre; i++) {
+        /* Coefficients de prod(t - j), j != i, et prod(i - j) */
+        long long coefficients[ORDRE_NEWTON_COTES_MAX + 1] = {1};
+        long long produit = 1;
+        int degre = 0;
+        for (int j = 0; j <= ordre; j++) {
+            if (j == i) continue;
+            for (int k = ++degre; k >= 0; k--)
+                coefficients[k] = (k ? coefficients[k - 1] : 0) -
+                                  (k < degre ? j * coefficients[k] : 0);
+            produit *= i - j;
+        }
+
+        /* ppcm fois l'integrale de 0 a ordre du polynome */
+        long long integrale = 0, puissance = ordre;
+        for (int k = 0; k <= degre; k++) {
+            integrale += coefficients[k] * puissance * (ppcm / (k + 1));
+            puissance *= ordre;
+        }
+
+        const long long diviseur = pgcd(integrale, ppcm * produit);
+        numerateurs[i] = integrale / diviseur;
+        denominateurs[i] = ppcm * produit / diviseur;
+        if (denominateurs[i] < 0) {
+            numerateurs[i] = -numerateurs[i];
+            denominateurs[i] = -denominateurs[i];
+        }
+    }
+
+    /* Denominateur commun et plus grand commun diviseur des numerateurs */
+    long long commun = 1, diviseur = 0;
+    for (int i = 0; i <= ordre; i++)
+        commun = commun / pgcd(commun, denominateurs[i]) * denominateurs[i];
+    for (int i = 0; i <= ordre; i++) {
+        numerateurs[i] *= commun / denominateurs[i];
+        diviseur = pgcd(diviseur, numerateurs[i]);
+    }
+
+    regle->extremite = numerateurs[0] / diviseur;
+    regle->poids[0] = 2 * regle->extremite;
+    for (int i = 1; i < ordre; i++) regle->poids[i] = numerateurs[i] / diviseur;
+    regle->numerateur = diviseur;
+    regle->denominateur = commun;
+
+    return regle;
+}
+
+/**
+ * Cette fonction trouve, pour plusieurs fonctions a la fois, la somme ponderee
+ * de leurs valeurs aux noeuds borneInf + (i + decalage) * pas, pour i allant
+ * de iDebut a iFin - 1, ou le poids du noeud i est poids[i % periode]. Les
+ * noeuds sont generes par blocs d'un multiple de la periode, une seule fois
+ * pour toutes les fonctions, et chaque fonction evalue le bloc pendant qu'il
+ * est encore dans le cache. Ses valeurs sont ajoutees element par element a
+ * sa ligne d'un tableau de cumuls, ce qui se vectorise et ne choisit aucun
+ * poids noeud par noeud. Comme chaque bloc commence sur le meme poids, on
+ * multiplie les cumuls par les poids seulement a la fin, par un produit
+ * scalaire par pas de la periode. Les fonctions sont traitees par groupes
+ * d'au plus N_INTEGRANDES_MAX, pour que les cumuls d'un groupe restent dans
+ * le cache.
+ *
+ * integrandes : Fonctions a integrer.
+ * nIntegrandes : Nombre de fonctions.
+ * iDebut : Indice du premier noeud.
+ * iFin : Indice qui suit le dernier noeud.
+ * borneInf : Borne inferieure d'integration.
+ * pas : Ecart entre deux noeuds.
+ * decalage : Position du noeud dans son intervalle (0 ou 0.5).
+ * poids : Poids des noeuds selon leur indice modulo la periode.
+ * periode : Nombre de poids differents, au plus ORDRE_NEWTON_COTES_MAX.
+ * sommes : Tableau ou on ecrit la somme ponderee de chaque fonction.
+ */
+void somme_noeuds_vectorielle(const struct integrande integrandes[],
+                              const int nIntegrandes, const int iDebut,
+                              const int iFin, const double borneInf,
+                              const double pas, const double decalage,
+                              const double poids[], const int periode,
+                              double sommes[]) {
+    double x[TAILLE_BLOC], y[TAILLE_BLOC];
+    double cumuls[N_INTEGRANDES_MAX][TAILLE_BLOC];
+    /* Taille des blocs, un multiple de la periode */
+    const int taille = TAILLE_BLOC / periode * periode;
+
+    for (int premiere = 0; premiere < nIntegrandes;
+         premiere += N_INTEGRANDES_MAX) {
+        /* Nombre de fonctions du groupe */
+        const int nGroupe = nIntegrandes - premiere < N_INTEGRANDES_MAX
+                                ? nIntegrandes - premiere
+                                : N_INTEGRANDES_MAX;
+        for (int k = 0; k < nGroupe; k++)
+            for (int j = 0; j < taille; j++) cumuls[k][j] = 0;
+
+        for (int debut = iDebut; debut < iFin; debut += taille) {
+            const int n = iFin - debut < taille ? iFin - debut : taille;
+            for (int j = 0; j < n; j++)
+                x[j] = borneInf + (debut + j + decalage) * pas;
+            for (int k = 0; k < nGroupe; k++) {
+                evaluer_lot(&integrandes[premiere + k], x, y, n);
+                for (int j = 0; j < n; j++) cumuls[k][j] += y[j];
+            }
+        }
+
+        /* Le cumul j a le poids du noeud iDebut + j */
+        for (int k = 0; k < nGroupe; k++) {
+            double somme = 0;
+            for (int r = 0; r < periode; r++) {
+                double sommeReste = 0;
+                for (int j = r; j < taille; j += periode)
+                    sommeReste += cumuls[k][j];
+                somme += poids[(iDebut + r) % periode] * sommeReste;
+            }
+            sommes[premiere + k] = somme;
+        }
+    }
+}
+
+/**
+ * Cette fonction trouve la somme ponderee de somme_noeuds_vectorielle pour
+ * une seule fonction.
+ *
+ * integrande : Fonction a integrer.
+ * Les autres parametres sont ceux de somme_noeuds_vectorielle.
+ *
+ * return : La somme ponderee.
+ */
+double somme_noeuds(const struct integrande* integrande, const int iDebut,
+                    const int iFin, const double borneInf, const double pas,
+                    const double decalage, const double poids[],
+                    const int periode) {
+    double somme;
+
+    somme_noeuds_vectorielle(integrande, 1, iDebut, iFin, borneInf, pas,
+                             decalage, poids, periode, &somme);
+    return somme;
+}
+
+/**
+ * On trouve la valeur de l'integrale de plusieurs fonctions entre borneInf et
+ * borneSup par la regle de Newton-Cotes fermee composee d'un certain ordre
+ * (1 pour les trapezes, 2 pour Simpson, 3 pour Simpson 3/8, 9 pour la
+ * methode a 10 points). Les noeuds interieurs sont generes une seule fois et
+ * sommes par somme_noeuds_vectorielle, et les extremites sont ajoutees a
+ * part. Le resultat de chaque fonction est exactement celui qu'elle aurait
+ * seule.
+ *
+ * ordre : Nombre d'intervalles par panneau, entre 1 et
+ * ORDRE_NEWTON_COTES_MAX.
+ * nTermes : Nombre de termes a calculer, un multiple de l'ordre.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * integrandes : Fonctions a integrer.
+ * nIntegrandes : Nombre de fonctions.
+ * resultats : Tableau ou on ecrit l'integrale approximee de chaque fonction,
+ * NAN si l'ordre n'est pas permis.
+ */
+void Newton_Cotes_vectorielle(const int ordre, const int nTermes,
+                              const double borneInf, const double borneSup,
+                              const struct integrande integrandes[],
+                              const int nIntegrandes, double resultats[]) {
+    const struct regle_newton_cotes* regle = regle_Newton_Cotes(ordre);
+    if (!regle) {
+        for (int k = 0; k < nIntegrandes; k++) resultats[k] = NAN;
+        return;
+    }
+
+    const double pas = (borneSup - borneInf) / nTermes;
+    const double bornes[2] = {borneInf, borneSup};
+    double extremites[2];
+
+    somme_noeuds_vectorielle(integrandes, nIntegrandes, 1, nTermes, borneInf,
+                             pas, 0, regle->poids, ordre, resultats);
+    for (int k = 0; k < nIntegrandes; k++) {
+        evaluer_lot(&integrandes[k], bornes, extremites, 2);
+        resultats[k] = pas * regle->numerateur / regle->denominateur *
+                       (regle->extremite * (extremites[0] + extremites[1]) +
+                        resultats[k]);
+    }
+}
+
+/**
+ * On trouve la valeur de l'integrale d'une fonction par la regle de
+ * Newton-Cotes fermee composee, comme Newton_Cotes_vectorielle.
+ *
+ * integrande : Fonction a integrer.
+ * Les autres parametres sont ceux de Newton_Cotes_vectorielle.
+ *
+ * return : Valeur de l'integrale approximee, NAN si l'ordre n'est pas permis.
+ */
+double Newton_Cotes_lot(const int ordre, const int nTermes,
+                        const double borneInf, const double borneSup,
+                        const struct integrande* integrande) {
+    double resultat;
+
+    Newton_Cotes_vectorielle(ordre, nTermes, borneInf, borneSup, integrande, 1,
+                             &resultat);
+    return resultat;
+}
+
+/**
+ * Versions par lots des methodes du point milieu, de Simpson et de
+ * Newton-Cotes a 10 points. Elles generent les noeuds par blocs et les
+ * evaluent avec un seul appel a la fonction par bloc.
+ *
+ * nTermes : Nombre de termes a calculer (un multiple de 2 pour Simpson et de 9
+ * pour Newton-Cotes).
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * integrande : Fonction a integrer.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double point_milieu_lot(const int nTermes, const double borneInf,
+                        const double borneSup,
+                        const struct integrande* integrande) {
+    const double pas = (borneSup - borneInf) / nTermes;
+    const double poids[1] = {1};
+
+    return pas *
+           somme_noeuds(integrande, 0, nTermes, borneInf, pas, 0.5, poids, 1);
+}
+
+double Simpson_lot(const int nTermes, const double borneInf,
+                   const double borneSup, const struct integrande* integrande) {
+    return Newton_Cotes_lot(2, nTermes, borneInf, borneSup, integrande);
+}
+
+double Newton_Cotes10_lot(const int nTermes, const double borneInf,
+                          const double borneSup,
+                          const struct integrande* integrande) {
+    return Newton_Cotes_lot(9, nTermes, borneInf, borneSup, integrande);
+}
+
+/**
+ * Travail d'un fil d'execution des methodes paralleles: il calcule la somme
+ * ponderee des morceaux iPremier, iPremier + pas, iPremier + 2 * pas, ... et
+ * l'ecrit dans le tableau des sommes partielles. Les autres champs sont les
+ * parametres de somme_noeuds.
+ */
+struct travail {
+    const struct integrande* integrande;
+    const double* poids;
+    double* partielles;
+    double borneInf, pas, decalage;
+    int iDebut, iFin, taille, periode, iPremier, pasMorceaux;
+};
+
+/**
+ * Cette fonction est executee par chaque fil d'execution.
+ *
+ * argument : Pointeur vers la struct travail du fil
+ *
+ * return : NULL
+ */
+void* executer_travail(void* argument) {
+    const struct travail* travail = argument;
+
+    for (int i = travail->iPremier; i < N_MORCEAUX;
+         i += travail->pasMorceaux) {
+        /* Noeuds du morceau, coupes a la fin de l'intervalle */
+        const int debut = travail->iDebut + i * travail->taille;
+        const int fin = debut + travail->taille < travail->iFin
+                            ? debut + travail->taille
+                            : travail->iFin;
+
+        travail->partielles[i] =
+            debut < fin ? somme_noeuds(travail->integrande, debut, fin,
+                                       travail->borneInf, travail->pas,
+                                       travail->decalage, travail->poids,
+                                       travail->periode)
+                        : 0;
+    }
+
+    return NULL;
+}
+
+/**
+ * Cette fonction calcule la meme somme que somme_noeuds, mais en coupant les
+ * noeuds en N_MORCEAUX morceaux repartis entre plusieurs fils d'execution.
+ * Chaque morceau commence a iDebut plus un multiple de la periode, donc avec
+ * le meme poids que le premier noeud de la regle, et les sommes partielles
+ * sont additionnees dans l'ordre des morceaux: le resultat est donc le meme,
+ * au bit pres, peu importe le nombre de fils.
+ *
+ * integrande : Fonction a integrer.
+ * iDebut : Indice du premier noeud.
+ * iFin : Indice qui suit le dernier noeud.
+ * borneInf : Borne inferieure d'integration.
+ * pas : Ecart entre deux noeuds.
+ * decalage : Position du noeud dans son intervalle (0 ou 0.5).
+ * poids : Poids des noeuds selon leur indice modulo la periode.
+ * periode : Nombre de poids differents.
+ * nFils : Nombre de fils d'execution a utiliser.
+ *
+ * return : La somme ponderee.
+ */
+double somme_noeuds_parallele(const struct integrande* integrande,
+                              const int iDebut, const int iFin,
+                              const double borneInf, const double pas,
+                              const double decalage, const double poids[],
+                              const int periode, int nFils) {
+    pthread_t fils[N_FILS_MAX];
+    struct travail travaux[N_FILS_MAX];
+    double partielles[N_MORCEAUX];
+    /* Indique si le travail i tourne dans un fil qu'il faudra attendre */
+    int lance[N_FILS_MAX] = {0};
+
+    /* Taille d'un morceau, arrondie au multiple de la periode superieur */
+    const int taille =
+        ((iFin - iDebut + N_MORCEAUX - 1) / N_MORCEAUX + periode - 1) /
+        periode * periode;
+
+    if (nFils > N_FILS_MAX) nFils = N_FILS_MAX;
+    if (nFils < 1) nFils = 1;
+
+    for (int i = 0; i < nFils; i++) {
+        travaux[i] = (struct travail){integrande, poids, partielles,
+                                      borneInf,   pas,   decalage,
+                                      iDebut,     iFin,  taille,
+                                      periode,    i,     nFils};
+        /* Le fil principal fait le premier travail lui-meme, et ceux dont le
+         * fil n'a pas pu etre cree */
+        if (i)
+            lance[i] = !pthread_create(&fils[i], NULL, executer_travail,
+                                       &travaux[i]);
+        if (i && !lance[i]) executer_travail(&travaux[i]);
+    }
+    executer_travail(&travaux[0]);
+    for (int i = 1; i < nFils; i++)
+        if (lance[i]) pthread_join(fils[i], NULL);
+
+    /* Reduction dans un ordre fixe */
+    double somme = 0;
+    for (int i = 0; i < N_MORCEAUX; i++) somme += partielles[i];
+
+    return somme;
+}
+
+/**
+ * Versions paralleles des methodes du point milieu, de Newton-Cotes fermees
+ * d'un certain ordre, de Simpson et de Newton-Cotes a 10 points. Elles
+ * donnent le meme resultat pour tous les nombres de fils d'execution.
+ *
+ * ordre : Nombre d'intervalles par panneau (Newton_Cotes_parallele).
+ * nTermes : Nombre de termes a calculer (un multiple de 2 pour Simpson et de 9
+ * pour Newton-Cotes).
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * integrande : Fonction a integrer.
+ * nFils : Nombre de fils d'execution a utiliser.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double point_milieu_parallele(const int nTermes, const double borneInf,
+                              const double borneSup,
+                              const struct integrande* integrande,
+                              const int nFils) {
+    const double pas = (borneSup - borneInf) / nTermes;
+    const double poids[1] = {1};
+
+    return pas * somme_noeuds_parallele(integrande, 0, nTermes, borneInf, pas,
+                                        0.5, poids, 1, nFils);
+}
+
+double Newton_Cotes_parallele(const int ordre, const int nTermes,
+                              const double borneInf, const double borneSup,
+                              const struct integrande* integrande,
+                              const int nFils) {
+    const struct regle_newton_cotes* regle = regle_Newton_Cotes(ordre);
+    if (!regle) return NAN;
+
+    const double pas = (borneSup - borneInf) / nTermes;
+    const double bornes[2] = {borneInf, borneSup};
+    double extremites[2];
+
+    evaluer_lot(integrande, bornes, extremites, 2);
+    return pas * regle->numerateur / regle->denominateur *
+           (regle->extremite * (extremites[0] + extremites[1]) +
+            somme_noeuds_parallele(integrande, 1, nTermes, borneInf, pas, 0,
+                                   regle->poids, ordre, nFils));
+}
+
+double Simpson_parallele(const int nTermes, const double borneInf,
+                         const double borneSup,
+                         const struct integrande* integrande, const int nFils) {
+    return Newton_Cotes_parallele(2, nTermes, borneInf, borneSup, integrande,
+                                  nFils);
+}
+
+double Newton_Cotes10_parallele(const int nTermes, const double borneInf,
+                                const double borneSup,
+                                const struct integrande* integrande,
+                                const int nFils) {
+    return Newton_Cotes_parallele(9, nTermes, borneInf, borneSup, integrande,
+                                  nFils);
+}
+
+/**
+ * On trouve la valeur de l'integrale par la methode du point milieu d'une
+ * fonction entre borneInf et borneSup. La fonction scalaire passe par
+ * l'adaptateur de la version par lots.
+ *
+ * nTermes : Nombre de termes a calculer.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * fonction : Fonction a integrer.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double point_milieu(const int nTermes, const double borneInf,
+                    const double borneSup, double (*fonction)(double)) {
+    const struct integrande integrande = {NULL, fonction, NULL};
+    return point_milieu_lot(nTermes, borneInf, borneSup, &integrande);
+}
+
+/**
+ * On trouve la valeur de l'integrale par la methode de Simpson d'une fonction
+ * entre borneInf et borneSup. On prend des doubles pour les bornes parce que
+ * sinon les resultats dependent de l'ordinateur (mon portable produit des
+ * resultats differents de mon ordinateur de bureau avec des floats). La
+ * fonction scalaire passe par l'adaptateur de la version par lots.
+ *
+ * nTermes : Nombre de termes a calculer pour la sommation, doit etre un
+ * multiple de 2.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * fonction : Fonction a integrer.
+ *
+ * return : Valeur de l'integrale approximee
+ */
+double Simpson(const int nTermes, const double borneInf, const double borneSup,
+               double (*fonction)(double)) {
+    const struct integrande integrande = {NULL, fonction, NULL};
+    return Simpson_lot(nTermes, borneInf, borneSup, &integrande);
+}
+
+/**
+ * On trouve la valeur de l'integrale par une methode de Newton-Cotes a 10
+ * points d'une fonction entre borneInf et borneSup. La fonction scalaire
+ * passe par l'adaptateur de la version par lots.
+ *
+ * nTermes : Nombre de termes a calculer pour la sommation, doit etre un
+ * multiple de 9.
+ * borneInf : Borne inferieure d'integration
+ * borneSup : Borne superieure d'integration
+ * fonction : Fonction a integrer
+ *
+ * return : Valeur de l'integrale approximee
+ */
+double Newton_Cotes10(const int nTermes, const double borneInf,
+                      const double borneSup, double (*fonction)(double)) {
+    const struct integrande integrande = {NULL, fonction, NULL};
+    return Newton_Cotes10_lot(nTermes, borneInf, borneSup, &integrande);
+}
+
+/**
+ * Versions d'origine de Simpson et de Newton-Cotes a 10 points, qui
+ * choisissent le poids de chaque noeud avec des if. On les garde seulement
+ * comme reference pour mesurer le gain de la regle de Newton-Cotes generale.
+ *
+ * nTermes : Nombre de termes a calculer pour la sommation, doit etre un
+ * multiple de 2 pour Simpson et de 9 pour Newton-Cotes.
+ * borneInf : Borne inferieure d'integration
+ * borneSup : Borne superieure d'integration
+ * fonction : Fonction a integrer
+ *
+ * return : Valeur de l'integrale approximee
+ */
+double Simpson_branches(const int nTermes, const double borneInf,
+                        const double borneSup, double (*fonction)(double)) {
+    /* Pas d'integration (largeur dx) */
+    const double pas = (borneSup - borneInf) / nTermes;
+
+    double integrale = fonction(borneInf) + fonction(borneSup);
+    for (int i = 1; i < nTermes; i++) {
+        if (i % 2)
+            integrale += 4 * fonction(borneInf + i * pas);
+        else
+            integrale += 2 * fonction(borneInf + i * pas);
+    }
+
+    return pas / 3.0 * integrale;
+}
+
+double Newton_Cotes10_branches(const int nTermes, const double borneInf,
+                               const double borneSup,
+                               double (*fonction)(double)) {
+    /* Pas d'integration (largeur dx) */
+    const double pas = (borneSup - borneInf) / nTermes;
+
+    double integrale = 2857 * (fonction(borneInf) + fonction(borneSup));
+    for (int i = 1; i < nTermes; i++) {
+        if (i % 9 == 1 || i % 9 == 8)
+            integrale += 15741 * fonction(borneInf + pas * i);
+        else if (i % 9 == 2 || i % 9 == 7)
+            integrale += 1080 * fonction(borneInf + pas * i);
+        else if (i % 9 == 3 || i % 9 == 6)
+            integrale += 19344 * fonction(borneInf + pas * i);
+        else if (i % 9 == 4 || i % 9 == 5)
+            integrale += 5778 * fonction(borneInf + pas * i);
+        else
+            integrale += 5714 * fonction(borneInf + pas * i);
+    }
+
+    return 9 * pas / 89600 * integrale;
+}
+
+/**
+ * Nombre en double-double: la valeur representee est haut + bas, ce qui donne
+ * environ 106 bits de mantisse. On s'en sert pour accumuler les sommes des
+ * methodes d'integration sans que l'arrondi ne masque l'erreur de la methode.
+ * Les operations n'ont pas de branchement pour rester vectorisables.
+ */
+struct double_double {
+    double haut, bas;
+};
+
+/**
+ * Cette fonction additionne exactement deux doubles (algorithme de Knuth).
+ *
+ * a, b : Nombres a additionner.
+ *
+ * return : La somme exacte a + b en double-double.
+ */
+struct double_double dd_somme_exacte(const double a, const double b) {
+    struct double_double resultat;
+    resultat.haut = a + b;
+    const double bVirtuel = resultat.haut - a;
+    resultat.bas = (a - (resultat.haut - bVirtuel)) + (b - bVirtuel);
+    return resultat;
+}
+
+/**
+ * Cette fonction additionne exactement deux doubles quand |a| >= |b|
+ * (algorithme de Dekker), elle sert a renormaliser un double-double.
+ *
+ * a, b : Nombres a additionner, avec |a| >= |b|.
+ *
+ * return : La somme exacte a + b en double-double.
+ */
+struct double_double dd_somme_rapide(const double a, const double b) {
+    struct double_double resultat;
+    resultat.haut = a + b;
+    resultat.bas = b - (resultat.haut - a);
+    return resultat;
+}
+
+/**
+ * Cette fonction multiplie exactement deux doubles grace a fma.
+ *
+ * a, b : Nombres a multiplier.
+ *
+ * return : Le produit exact a * b en double-double.
+ */
+struct double_double dd_produit_exact(const double a, const double b) {
+    struct double_double resultat;
+    resultat.haut = a * b;
+    resultat.bas = fma(a, b, -resultat.haut);
+    return resultat;
+}
+
+/**
+ * Cette fonction additionne deux double-doubles.
+ *
+ * x, y : Nombres a additionner.
+ *
+ * return : La somme x + y.
+ */
+struct double_double dd_addition(const struct double_double x,
+                                 const struct double_double y) {
+    struct double_double somme = dd_somme_exacte(x.haut, y.haut);
+    const struct double_double sommeBas = dd_somme_exacte(x.bas, y.bas);
+
+    somme = dd_somme_rapide(somme.haut, somme.bas + sommeBas.haut);
+    return dd_somme_rapide(somme.haut, somme.bas + sommeBas.bas);
+}
+
+/**
+ * Cette fonction multiplie un double-double par un double.
+ *
+ * x : Double-double a multiplier.
+ * a : Facteur en double.
+ *
+ * return : Le produit x * a.
+ */
+struct double_double dd_multiplication_double(const struct double_double x,
+                                              const double a) {
+    struct double_double produit = dd_produit_exact(x.haut, a);
+    produit.bas += x.bas * a;
+    return dd_somme_rapide(produit.haut, produit.bas);
+}
+
+/**
+ * Cette fonction ajoute poids * valeur a une somme en double-double, le
+ * produit etant lui aussi calcule exactement.
+ *
+ * somme : Somme a laquelle on ajoute le terme.
+ * poids : Poids de la methode d'integration.
+ * valeur : Valeur de la fonction au noeud.
+ *
+ * return : La nouvelle somme.
+ */
+struct double_double dd_accumuler(const struct double_double somme,
+                                  const double poids, const double valeur) {
+    return dd_addition(somme, dd_produit_exact(poids, valeur));
+}
+
+/**
+ * Version double-double de la methode de Simpson: les noeuds et les valeurs de
+ * la fonction sont les memes, mais la somme ponderee et le facteur pas / 3 sont
+ * calcules sur environ 106 bits.
+ *
+ * nTermes : Nombre de termes a calculer pour la sommation, doit etre un
+ * multiple de 2.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * fonction : Fonction a integrer.
+ *
+ * return : Valeur de l'integrale approximee, arrondie en double.
+ */
+double Simpson_dd(const int nTermes, const double borneInf,
+                  const double borneSup, double (*fonction)(double)) {
+    /* Pas d'integration (largeur dx) */
+    const double pas = (borneSup - borneInf) / nTermes;
+
+    struct double_double integrale =
+        dd_somme_exacte(fonction(borneInf), fonction(borneSup));
+    for (int i = 1; i < nTermes; i++)
+        integrale = dd_accumuler(integrale, i % 2 ? 4.0 : 2.0,
+                                 fonction(borneInf + i * pas));
+
+    return dd_multiplication_double(integrale, pas / 3.0).haut;
+}
+
+/**
+ * Version double-double de la methode de Newton-Cotes a 10 points.
+ *
+ * nTermes : Nombre de termes a calculer pour la sommation, doit etre un
+ * multiple de 9.
+ * borneInf : Borne inferieure d'integration
+ * borneSup : Borne superieure d'integration
+ * fonction : Fonction a integrer
+ *
+ * return : Valeur de l'integrale approximee, arrondie en double.
+ */
+double Newton_Cotes10_dd(const int nTermes, const double borneInf,
+                         const double borneSup, double (*fonction)(double)) {
+    /* Poids des noeuds selon leur position dans un panneau de 9 intervalles */
+    const double poids[9] = {5714,  15741, 1080,  19344, 5778,
+                             5778,  19344, 1080,  15741};
+
+    /* Pas d'integration (largeur dx) */
+    const double pas = (borneSup - borneInf) / nTermes;
+
+    struct double_double integrale = dd_produit_exact(2857, fonction(borneInf));
+    integrale = dd_accumuler(integrale, 2857, fonction(borneSup));
+    for (int i = 1; i < nTermes; i++)
+        integrale = dd_accumuler(integrale, poids[i % 9],
+                                 fonction(borneInf + pas * i));
+
+    return dd_multiplication_double(
+               dd_multiplication_double(integrale, 9 * pas), 1 / 89600.0)
+        .haut;
+}
+
+/**
+ * Cette fonction mesure le temps moyen (en secondes) d'un appel a une methode
+ * d'integration avec une horloge monotone. On repete la methode jusqu'a ce que
+ * TEMPS_MESURE secondes soient ecoulees.
+ *
+ * nTermes: Nombre de termes a calculer pour l'approximation.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * methode : Fonction pour approximer l'integrale.
+ * fonction : Fonction a integrer.
+ *
+ * return : Temps moyen d'un appel en secondes.
+ */
+double temps_methode(const int nTermes, const double borneInf,
+                     const double borneSup,
+                     double (*methode)(int, double, double, double (*)(double)),
+                     double (*fonction)(double)) {
+    /* Resultat volatile pour que le compilateur ne retire pas les appels */
+    volatile double puits;
+    /* Nombre d'appels et temps ecoule */
+    long nAppels = 0;
+    double ecoule;
+    struct timespec debut, fin;
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    do {
+        puits = methode(nTermes, borneInf, borneSup, fonction);
+        nAppels++;
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+        ecoule = (fin.tv_sec - debut.tv_sec) +
+                 (fin.tv_nsec - debut.tv_nsec) * 1e-9;
+    } while (ecoule < TEMPS_MESURE);
+    (void)puits;
+
+    return ecoule / nAppels;
+}
+
+/**
+ * Cette fonction compare une methode d'integration a sa version en
+ * double-double: ecart entre les deux resultats (l'erreur d'arrondi de la
+ * version en double) et cout relatif de la version en double-double.
+ *
+ * nTermes: Nombre de termes a calculer pour l'approximation.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * methode : Methode d'integration en double.
+ * methodeDD : Methode d'integration en double-double.
+ * fonction : Fonction a integrer.
+ * nom : Nom de la methode utilisee pour integrer.
+ */
+void comparer_double_double(const int nTermes, const double borneInf,
+                            const double borneSup,
+                            double (*methode)(int, double, double,
+                                              double (*)(double)),
+                            double (*methodeDD)(int, double, double,
+                                                double (*)(double)),
+                            double (*fonction)(double), const char nom[]) {
+    const double ecart = fabs(methode(nTermes, borneInf, borneSup, fonction) -
+                              methodeDD(nTermes, borneInf, borneSup, fonction));
+
+    printf("%-12s %8d %19.3e  %10.1fx\n", nom, nTermes, ecart,
+           temps_methode(nTermes, borneInf, borneSup, methodeDD, fonction) /
+               temps_methode(nTermes, borneInf, borneSup, methode, fonction));
+}
+
+/**
+ * Cette fonction mesure le temps moyen (en secondes) d'un appel a une methode
+ * d'integration par lots, comme temps_methode.
+ *
+ * nTermes: Nombre de termes a calculer pour l'approximation.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * methode : Methode d'integration par lots.
+ * integrande : Fonction a integrer.
+ *
+ * return : Temps moyen d'un appel en secondes.
+ */
+double temps_lot(const int nTermes, const double borneInf,
+                 const double borneSup,
+                 double (*methode)(int, double, double,
+                                   const struct integrande*),
+                 const struct integrande* integrande) {
+    /* Resultat volatile pour que le compilateur ne retire pas les appels */
+    volatile double puits;
+    /* Nombre d'appels et temps ecoule */
+    long nAppels = 0;
+    double ecoule;
+    struct timespec debut, fin;
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    do {
+        puits = methode(nTermes, borneInf, borneSup, integrande);
+        nAppels++;
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+        ecoule = (fin.tv_sec - debut.tv_sec) +
+                 (fin.tv_nsec - debut.tv_nsec) * 1e-9;
+    } while (ecoule < TEMPS_MESURE);
+    (void)puits;
+
+    return ecoule / nAppels;
+}
+
+/**
+ * Cette fonction compare une methode par lots appliquee aux noyaux
+ * vectorisables et a la fonction de math.h passee par l'adaptateur: ecart
+ * entre les deux resultats et acceleration due aux lots.
+ *
+ * nTermes: Nombre de termes a calculer pour l'approximation.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * methode : Methode d'integration par lots.
+ * vectorielle : Fonction a integrer, donnee par lots.
+ * nom : Nom de la methode utilisee pour integrer.
+ */
+void comparer_lot(const int nTermes, const double borneInf,
+                  const double borneSup,
+                  double (*methode)(int, double, double,
+                                    const struct integrande*),
+                  const struct integrande* vectorielle, const char nom[]) {
+    /* Meme fonction, mais evaluee noeud par noeud avec math.h */
+    const struct integrande scalaire = {NULL, vectorielle->scalaire, NULL};
+
+    const double ecart =
+        fabs(methode(nTermes, borneInf, borneSup, vectorielle) -
+             methode(nTermes, borneInf, borneSup, &scalaire));
+
+    printf("%-12s %8d %19.3e  %10.1fx\n", nom, nTermes, ecart,
+           temps_lot(nTermes, borneInf, borneSup, methode, &scalaire) /
+               temps_lot(nTermes, borneInf, borneSup, methode, vectorielle));
+}
+
+/**
+ * Cette fonction mesure le temps moyen (en secondes) d'un appel a une methode
+ * parallele, comme temps_methode.
+ *
+ * nTermes: Nombre de termes a calculer pour l'approximation.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * methode : Methode d'integration parallele.
+ * integrande : Fonction a integrer.
+ * nFils : Nombre de fils d'execution a utiliser.
+ * valeur : Variable ou on ecrit le resultat de la methode.
+ *
+ * return : Temps moyen d'un appel en secondes.
+ */
+double temps_parallele(const int nTermes, const double borneInf,
+                       const double borneSup,
+                       double (*methode)(int, double, double,
+                                         const struct integrande*, int),
+                       const struct integrande* integrande, const int nFils,
+                       double* valeur) {
+    /* Nombre d'appels et temps ecoule */
+    long nAppels = 0;
+    double ecoule;
+    struct timespec debut, fin;
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    do {
+        *valeur = methode(nTermes, borneInf, borneSup, integrande, nFils);
+        nAppels++;
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+        ecoule = (fin.tv_sec - debut.tv_sec) +
+                 (fin.tv_nsec - debut.tv_nsec) * 1e-9;
+    } while (ecoule < TEMPS_MESURE);
+
+    return ecoule / nAppels;
+}
+
+/**
+ * Cette fonction mesure l'acceleration d'une methode parallele avec 1 a
+ * nFilsMax fils d'execution. La valeur est affichee avec tous ses chiffres
+ * pour montrer qu'elle ne depend pas du nombre de fils.
+ *
+ * methode : Methode d'integration parallele.
+ * integrande : Fonction a integrer.
+ * nFilsMax : Nombre maximal de fils d'execution.
+ * nom : Nom de la methode.
+ */
+void mesurer_parallele(double (*methode)(int, double, double,
+                                         const struct integrande*, int),
+                       const struct integrande* integrande, const int nFilsMax,
+                       const char nom[]) {
+    /* Temps avec un seul fil, la reference de l'acceleration */
+    double tempsUnFil = 0;
+
+    for (int nFils = 1; nFils <= nFilsMax; nFils++) {
+        double valeur;
+        const double temps = temps_parallele(N_TERMES_PARALLELE, 0, 1, methode,
+                                             integrande, nFils, &valeur);
+        if (nFils == 1) tempsUnFil = temps;
+        printf("%-12s %4d %23.17f %10.2f %8.2fx\n", nom, nFils, valeur,
+               temps * 1e3, tempsUnFil / temps);
+    }
+}
+
+/**
+ * Cette fonction execute le mode --parallele: acceleration des trois methodes
+ * paralleles pour l'integrale de exp entre 0 et 1.
+ *
+ * nFilsMax : Nombre maximal de fils d'execution.
+ *
+ * return : Code de sortie du programme.
+ */
+int Parallele(int nFilsMax) {
+    const struct integrande integrande = {exp_lot, exp, NULL};
+
+    if (nFilsMax > N_FILS_MAX) nFilsMax = N_FILS_MAX;
+    if (nFilsMax < 1) nFilsMax = 1;
+
+    printf("Integrale de exp entre 0 et 1, %d intervalles\n",
+           N_TERMES_PARALLELE);
+    printf("Methode      Fils       Valeur approximee  Temps (ms)  "
+           "Accel.\n");
+    mesurer_parallele(point_milieu_parallele, &integrande, nFilsMax,
+                      "Point milieu");
+    mesurer_parallele(Simpson_parallele, &integrande, nFilsMax, "Simpson");
+    mesurer_parallele(Newton_Cotes10_parallele, &integrande, nFilsMax,
+                      "Secrete");
+
+    return 0;
+}
+
+/**
+ * Regle de Gauss-Legendre d'un certain ordre sur [-1, 1]: ses (ordre + 1) / 2
+ * noeuds positifs ou nuls, en ordre decroissant, et leurs poids. Les noeuds
+ * negatifs sont les symetriques des noeuds positifs, avec les memes poids, et
+ * le noeud 0 des ordres impairs est le dernier.
+ */
+struct regle_gauss {
+    const double* noeuds;
+    const double* poids;
+};
+
+/* Regles deja connues, selon leur ordre, et espace pour celles calculees a
+ * la premiere utilisation */
+struct regle_gauss reglesGauss[ORDRE_GAUSS_MAX + 1] = {
+    [2] = {noeudsLegendre2, poidsLegendre2},
+    [4] = {noeudsLegendre4, poidsLegendre4},
+    [8] = {noeudsLegendre8, poidsLegendre8},
+    [16] = {noeudsLegendre16, poidsLegendre16},
+    [32] = {noeudsLegendre32, poidsLegendre32}};
+double noeudsCalcules[ORDRE_GAUSS_MAX + 1][(ORDRE_GAUSS_MAX + 1) / 2];
+double poidsCalcules[ORDRE_GAUSS_MAX + 1][(ORDRE_GAUSS_MAX + 1) / 2];
+
+/**
+ * Cette fonction trouve la valeur d'un polynome de Legendre et de sa derivee
+ * par la relation de recurrence de Bonnet, en long double pour que les
+ * noeuds et les poids qu'on en tire soient justes au dernier bit d'un double
+ * pres.
+ *
+ * ordre : Degre du polynome.
+ * x : Point ou evaluer le polynome, entre -1 et 1 exclusivement.
+ * derivee : Variable ou on ecrit la derivee du polynome en x.
+ *
+ * return : Valeur du polynome en x.
+ */
+long double Legendre(const int ordre, const long double x,
+                     long double* derivee) {
+    /* Polynomes de degres k - 1 et k */
+    long double precedent = 1, courant = x;
+
+    for (int k = 2; k <= ordre; k++) {
+        const long double suivant =
+            ((2 * k - 1) * x * courant - (k - 1) * precedent) / k;
+        precedent = courant;
+        courant = suivant;
+    }
+    *derivee = ordre * (x * courant - precedent) / (x * x - 1);
+
+    return courant;
+}
+
+/**
+ * Cette fonction trouve la regle de Gauss-Legendre d'un certain ordre. Si
+ * elle n'est pas dans les tables, on trouve chaque noeud (une racine du
+ * polynome de Legendre) par la methode de Newton, a partir d'une
+ * approximation asymptotique, et on garde le resultat pour les appels
+ * suivants.
+ *
+ * ordre : Nombre de noeuds de la regle, entre 2 et ORDRE_GAUSS_MAX.
+ *
+ * return : La regle, avec des pointeurs nuls si l'ordre n'est pas permis.
+ */
+struct regle_gauss regle_Gauss_Legendre(const int ordre) {
+    if (ordre < 2 || ordre > ORDRE_GAUSS_MAX)
+        return (struct regle_gauss){NULL, NULL};
+    if (reglesGauss[ordre].noeuds) return reglesGauss[ordre];
+
+    for (int i = 0; i < (ordre + 1) / 2; i++) {
+        long double x = cos(M_PI * (i + 0.75) / (ordre + 0.5)), derivee;
+
+        for (int iteration = 0; iteration < N_ITERATIONS_NEWTON; iteration++) {
+            const long double correction =
+                Legendre(ordre, x, &derivee) / derivee;
+            x -= correction;
+            if (fabsl(correction) < 1e-19L) break;
+        }
+        Legendre(ordre, x, &derivee);
+
+        noeudsCalcules[ordre][i] = x;
+        poidsCalcules[ordre][i] = 2 / ((1 - x * x) * derivee * derivee);
+    }
+    /* Le noeud central des ordres impairs est exactement 0 */
+    if (ordre % 2) noeudsCalcules[ordre][ordre / 2] = 0;
+
+    reglesGauss[ordre] =
+        (struct regle_gauss){noeudsCalcules[ordre], poidsCalcules[ordre]};
+    return reglesGauss[ordre];
+}
+
+/**
+ * On trouve la valeur de l'integrale de plusieurs fonctions entre borneInf et
+ * borneSup par la regle de Gauss-Legendre composee: l'intervalle est coupe
+ * en nPanneaux panneaux egaux et on applique la regle a chacun (un seul
+ * panneau donne la regle simple). Les noeuds et les poids de chaque panneau
+ * sont calcules une seule fois par blocs, puis chaque fonction evalue le bloc.
+ *
+ * nPanneaux : Nombre de panneaux.
+ * ordre : Nombre de noeuds par panneau, entre 2 et ORDRE_GAUSS_MAX.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * integrandes : Fonctions a integrer.
+ * nIntegrandes : Nombre de fonctions.
+ * resultats : Tableau ou on ecrit l'integrale approximee de chaque fonction,
+ * NAN si l'ordre n'est pas permis.
+ */
+void Gauss_Legendre_vectorielle(const int nPanneaux, const int ordre,
+                                const double borneInf, const double borneSup,
+                                const struct integrande integrandes[],
+                                const int nIntegrandes, double resultats[]) {
+    const struct regle_gauss regle = regle_Gauss_Legendre(ordre);
+    const double demiLargeur = (borneSup - borneInf) / nPanneaux / 2;
+    double x[TAILLE_BLOC], y[TAILLE_BLOC], w[TAILLE_BLOC];
+    /* Nombre de noeuds dans le bloc courant */
+    int n = 0;
+
+    for (int k = 0; k < nIntegrandes; k++)
+        resultats[k] = regle.noeuds ? 0 : NAN;
+    if (!regle.noeuds) return;
+
+    for (int p = 0; p < nPanneaux; p++) {
+        const double centre = borneInf + (2 * p + 1) * demiLargeur;
+        for (int i = 0; i < ordre; i++) {
+            /* Les noeuds i et ordre - 1 - i sont symetriques */
+            const int j = i < ordre / 2 ? i : ordre - 1 - i;
+            x[n] = i < ordre / 2 ? centre - demiLargeur * regle.noeuds[j]
+                                 : centre + demiLargeur * regle.noeuds[j];
+            w[n] = regle.poids[j];
+            if (++n == TAILLE_BLOC) {
+                for (int k = 0; k < nIntegrandes; k++) {
+                    evaluer_lot(&integrandes[k], x, y, n);
+                    resultats[k] += somme_ponderee(w, y, n);
+                }
+                n = 0;
+            }
+        }
+    }
+    for (int k = 0; k < nIntegrandes; k++) {
+        evaluer_lot(&integrandes[k], x, y, n);
+        resultats[k] = demiLargeur * (resultats[k] + somme_ponderee(w, y, n));
+    }
+}
+
+/**
+ * On trouve la valeur de l'integrale d'une fonction par la regle de
+ * Gauss-Legendre composee, comme Gauss_Legendre_vectorielle.
+ *
+ * integrande : Fonction a integrer.
+ * Les autres parametres sont ceux de Gauss_Legendre_vectorielle.
+ *
+ * return : Valeur de l'integrale approximee, NAN si l'ordre n'est pas permis.
+ */
+double Gauss_Legendre(const int nPanneaux, const int ordre,
+                      const double borneInf, const double borneSup,
+                      const struct integrande* integrande) {
+    double resultat;
+
+    Gauss_Legendre_vectorielle(nPanneaux, ordre, borneInf, borneSup,
+                               integrande, 1, &resultat);
+    return resultat;
+}
+
+/**
+ * Cette fonction montre le resultat d'une regle a nEvaluations noeuds a
+ * l'utilisateur.
+ *
+ * nom : Nom de la methode.
+ * ordre : Nombre de noeuds par panneau.
+ * nPanneaux : Nombre de panneaux.
+ * nEvaluations : Nombre d'evaluations de la fonction.
+ * integraleApprox : Valeur approximee de l'integrale.
+ * integraleExacte : Valeur exacte de l'integrale.
+ */
+void afficher_Gauss(const char nom[], const int ordre, const int nPanneaux,
+                    const int nEvaluations, const double integraleApprox,
+                    const double integraleExacte) {
+    printf("%-15s %5d %9d %11d %19.14f %13.3e\n", nom, ordre, nPanneaux,
+           nEvaluations, integraleApprox,
+           fabs(integraleApprox - integraleExacte));
+}
+
+/**
+ * Cette fonction compare une methode basee sur la regle de Newton-Cotes
+ * generale a sa version d'origine avec des if: ecart entre les deux resultats
+ * et acceleration de la version generale. Les deux evaluent la meme fonction
+ * de math.h noeud par noeud, donc seul le choix des poids et la sommation
+ * changent.
+ *
+ * nTermes: Nombre de termes a calculer pour l'approximation.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * methode : Methode basee sur la regle generale.
+ * reference : Version d'origine de la methode.
+ * fonction : Fonction a integrer.
+ * nom : Nom de la methode utilisee pour integrer.
+ */
+void comparer_branches(const int nTermes, const double borneInf,
+                       const double borneSup,
+                       double (*methode)(int, double, double,
+                                         double (*)(double)),
+                       double (*reference)(int, double, double,
+                                           double (*)(double)),
+                       double (*fonction)(double), const char nom[]) {
+    const double ecart = fabs(methode(nTermes, borneInf, borneSup, fonction) -
+                              reference(nTermes, borneInf, borneSup, fonction));
+
+    printf("%-12s %8d %19.3e  %10.1fx\n", nom, nTermes, ecart,
+           temps_methode(nTermes, borneInf, borneSup, reference, fonction) /
+               temps_methode(nTermes, borneInf, borneSup, methode, fonction));
+}
+
+/**
+ * Panneau de la methode de Gauss-Kronrod adaptative: un sous-intervalle, son
+ * integrale approximee et l'erreur estimee sur celle-ci.
+ */
+struct panneau {
+    double borneInf, borneSup, integrale, erreur;
+};
+
+/**
+ * On trouve la valeur de l'integrale d'une fonction entre borneInf et
+ * borneSup par la regle de Kronrod a 15 points, et on estime son erreur par
+ * l'ecart avec la regle de Gauss a 7 points qui utilise les memes noeuds.
+ *
+ * panneau : Panneau dont on connait les bornes, on y ecrit l'integrale et
+ * l'erreur estimee.
+ * fonction : Fonction a integrer.
+ */
+void Gauss_Kronrod15(struct panneau* panneau, double (*fonction)(double)) {
+    /* Centre et demi-largeur du panneau */
+    const double centre = (panneau->borneInf + panneau->borneSup) / 2;
+    const double demiLargeur = (panneau->borneSup - panneau->borneInf) / 2;
+
+    /* Valeur au centre, commune aux deux regles */
+    const double valeurCentre = fonction(centre);
+    double kronrod = poidsKronrod[7] * valeurCentre;
+    double gauss = poidsGauss[3] * valeurCentre;
+
+    for (int i = 0; i < 7; i++) {
+        const double ecart = demiLargeur * noeudsKronrod[i];
+        const double somme =
+            fonction(centre - ecart) + fonction(centre + ecart);
+        kronrod += poidsKronrod[i] * somme;
+        if (i % 2) gauss += poidsGauss[i / 2] * somme;
+    }
+
+    panneau->integrale = kronrod * demiLargeur;
+    panneau->erreur = fabs((kronrod - gauss) * demiLargeur);
+}
+
+/**
+ * Cette fonction ajoute un panneau a une file de priorite (un tas binaire)
+ * ordonnee selon l'erreur estimee, la plus grande erreur etant a la racine.
+ *
+ * tas : Tableau qui contient le tas.
+ * nPanneaux : Nombre de panneaux dans le tas, sera incremente.
+ * panneau : Panneau a ajouter.
+ */
+void tas_ajouter(struct panneau tas[], int* nPanneaux,
+                 const struct panneau panneau) {
+    /* Position du nouveau panneau, qu'on remonte tant que son parent a une
+     * erreur plus petite */
+    int i = (*nPanneaux)++;
+    while (i && tas[(i - 1) / 2].erreur < panneau.erreur) {
+        tas[i] = tas[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    tas[i] = panneau;
+}
+
+/**
+ * Cette fonction retire le panneau dont l'erreur estimee est la plus grande
+ * d'une file de priorite.
+ *
+ * tas : Tableau qui contient le tas.
+ * nPanneaux : Nombre de panneaux dans le tas, sera decremente.
+ *
+ * return : Le panneau retire.
+ */
+struct panneau tas_retirer(struct panneau tas[], int* nPanneaux) {
+    const struct panneau racine = tas[0];
+    /* Dernier panneau, qu'on descend a partir de la racine */
+    const struct panneau dernier = tas[--*nPanneaux];
+
+    int i = 0;
+    for (;;) {
+        int enfant = 2 * i + 1;
+        if (enfant >= *nPanneaux) break;
+        if (enfant + 1 < *nPanneaux &&
+            tas[enfant + 1].erreur > tas[enfant].erreur)
+            enfant++;
+        if (tas[enfant].erreur <= dernier.erreur) break;
+        tas[i] = tas[enfant];
+        i = enfant;
+    }
+    tas[i] = dernier;
+
+    return racine;
+}
+
+/**
+ * On trouve la valeur de l'integrale d'une fonction entre borneInf et
+ * borneSup par la methode de Gauss-Kronrod adaptative: on garde les panneaux
+ * dans une file de priorite selon leur erreur estimee et on coupe en deux
+ * seulement le pire panneau, jusqu'a ce que la somme des erreurs estimees
+ * soit sous la tolerance. Les efforts se concentrent donc la ou la fonction
+ * est difficile a integrer.
+ *
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * fonction : Fonction a integrer.
+ * tolerance : Erreur absolue visee.
+ * nEvaluations : Pointeur ou on ecrit le nombre d'appels a fonction.
+ * erreur : Pointeur ou on ecrit l'erreur estimee.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double Gauss_Kronrod_adaptative(const double borneInf, const double borneSup,
+                                double (*fonction)(double),
+                                const double tolerance, int* nEvaluations,
+                                double* erreur) {
+    /* File de priorite des panneaux et son nombre de panneaux (locale pour
+     * que plusieurs fils puissent integrer en meme temps) */
+    struct panneau tas[N_PANNEAUX_MAX];
+    int nPanneaux = 0;
+
+    struct panneau panneau = {borneInf, borneSup, 0, 0};
+    Gauss_Kronrod15(&panneau, fonction);
+    tas_ajouter(tas, &nPanneaux, panneau);
+    *nEvaluations = 15;
+
+    /* Somme des erreurs estimees de tous les panneaux */
+    double erreurTotale = panneau.erreur;
+    while (erreurTotale > tolerance && nPanneaux < N_PANNEAUX_MAX) {
+        const struct panneau pire = tas_retirer(tas, &nPanneaux);
+        const double milieu = (pire.borneInf + pire.borneSup) / 2;
+        struct panneau gauche = {pire.borneInf, milieu, 0, 0};
+        struct panneau droite = {milieu, pire.borneSup, 0, 0};
+
+        Gauss_Kronrod15(&gauche, fonction);
+        Gauss_Kronrod15(&droite, fonction);
+        *nEvaluations += 30;
+        tas_ajouter(tas, &nPanneaux, gauche);
+        tas_ajouter(tas, &nPanneaux, droite);
+
+        erreurTotale += gauche.erreur + droite.erreur - pire.erreur;
+    }
+
+    /* On refait les sommes a la fin pour ne pas accumuler d'arrondis */
+    double integrale = 0;
+    *erreur = 0;
+    for (int i = 0; i < nPanneaux; i++) {
+        integrale += tas[i].integrale;
+        *erreur += tas[i].erreur;
+    }
+
+    return integrale;
+}
+
+/**
+ * On trouve la valeur de l'integrale d'une fonction entre borneInf et
+ * borneSup par un raffinement uniforme: on double le nombre d'intervalles de
+ * la methode de Simpson jusqu'a ce que l'estimation de Richardson de l'erreur,
+ * |S(2n) - S(n)| / 15, soit sous la tolerance. Sert de reference pour la
+ * methode adaptative.
+ *
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * fonction : Fonction a integrer.
+ * tolerance : Erreur absolue visee.
+ * nEvaluations : Pointeur ou on ecrit le nombre de noeuds de la derniere
+ * methode de Simpson (le cout si on reutilisait les noeuds d'un raffinement a
+ * l'autre).
+ * erreur : Pointeur ou on ecrit l'erreur estimee.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double Simpson_uniforme(const double borneInf, const double borneSup,
+                        double (*fonction)(double), const double tolerance,
+                        int* nEvaluations, double* erreur) {
+    int nTermes = 2;
+    double precedente = Simpson(nTermes, borneInf, borneSup, fonction);
+    double courante;
+
+    do {
+        nTermes *= 2;
+        courante = Simpson(nTermes, borneInf, borneSup, fonction);
+        *erreur = fabs(courante - precedente) / 15;
+        if (*erreur <= tolerance) break;
+        precedente = courante;
+    } while (nTermes < N_INTERVALLES_MAX);
+
+    *nEvaluations = nTermes + 1;
+    return courante;
+}
+
+/* Noeuds t > 0 de la methode tanh-sinh, niveau par niveau: le niveau 0
+ * contient t = 1, ..., T_MAX_TANH_SINH et le niveau k > 0 contient les
+ * multiples impairs de 2^-k, a partir de l'indice T_MAX_TANH_SINH << (k - 1).
+ * Pour chaque noeud, on garde 1 - tanh(pi / 2 sinh(t)), la distance a la
+ * borne la plus proche sur [-1, 1] (calculee sans soustraction pour ne pas
+ * perdre de chiffres pres des bornes), et le poids de la regle. */
+double complementsTanhSinh[N_NOEUDS_TANH_SINH];
+double poidsTanhSinh[N_NOEUDS_TANH_SINH];
+int tanhSinhInitialise = 0;
+
+/**
+ * Cette fonction calcule une seule fois les noeuds et les poids de tous les
+ * niveaux de la methode tanh-sinh.
+ */
+void initialiser_tanh_sinh() {
+    if (tanhSinhInitialise) return;
+
+    for (int k = 0; k <= NIVEAUX_TANH_SINH; k++) {
+        /* Pas du niveau et premier indice du niveau dans les tables */
+        const double pas = ldexp(1, -k);
+        const int debut = k ? T_MAX_TANH_SINH << (k - 1) : 0;
+        const int fin = T_MAX_TANH_SINH << k;
+
+        for (int i = debut; i < fin; i++) {
+            const double t = k ? (2 * (i - debut) + 1) * pas : i + 1;
+            const double u = M_PI / 2 * sinh(t);
+            complementsTanhSinh[i] = 1 / (exp(u) * cosh(u));
+            poidsTanhSinh[i] = M_PI / 2 * cosh(t) / (cosh(u) * cosh(u));
+        }
+    }
+    tanhSinhInitialise = 1;
+}
+
+/**
+ * Cette fonction trouve la somme ponderee des valeurs d'une fonction aux
+ * noeuds tanh-sinh d'indices debut a fin - 1 et a leurs symetriques. Un
+ * noeud trop proche de sa borne pour en etre distinct en double est ignore,
+ * ce qui permet d'integrer des fonctions infinies a l'une ou l'autre des
+ * bornes; son symetrique est garde s'il est distinct de l'autre borne (pres
+ * d'une borne nulle, les noeuds descendent jusqu'a 1e-300 environ).
+ *
+ * integrande : Fonction a integrer.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * debut : Indice du premier noeud dans les tables.
+ * fin : Indice qui suit le dernier noeud.
+ * nEvaluations : Compteur d'appels a la fonction, qu'on augmente.
+ *
+ * return : La somme ponderee.
+ */
+double somme_tanh_sinh(const struct integrande* integrande,
+                       const double borneInf, const double borneSup,
+                       const int debut, const int fin, int* nEvaluations) {
+    const double demiLargeur = (borneSup - borneInf) / 2;
+    double x[TAILLE_BLOC], y[TAILLE_BLOC], w[TAILLE_BLOC];
+    double somme = 0;
+    /* Nombre de noeuds dans le bloc courant */
+    int n = 0;
+
+    for (int i = debut; i < fin; i++) {
+        const double ecart = demiLargeur * complementsTanhSinh[i];
+        /* Chaque noeud confondu avec sa borne est ignore, sinon on evaluerait
+         * une singularite a cette borne */
+        if (borneInf + ecart != borneInf) {
+            x[n] = borneInf + ecart;
+            w[n++] = poidsTanhSinh[i];
+        }
+        if (borneSup - ecart != borneSup) {
+            x[n] = borneSup - ecart;
+            w[n++] = poidsTanhSinh[i];
+        }
+        /* Il doit rester de la place pour la paire suivante */
+        if (n > TAILLE_BLOC - 2) {
+            evaluer_lot(integrande, x, y, n);
+            somme += somme_ponderee(w, y, n);
+            *nEvaluations += n;
+            n = 0;
+        }
+    }
+    evaluer_lot(integrande, x, y, n);
+    somme += somme_ponderee(w, y, n);
+    *nEvaluations += n;
+
+    return somme;
+}
+
+/**
+ * On trouve la valeur de l'integrale d'une fonction entre borneInf et
+ * borneSup par la methode tanh-sinh (double exponentielle): le changement de
+ * variable x = tanh(pi / 2 sinh(t)) envoie les bornes a l'infini et rend
+ * l'integrande doublement exponentiellement petit aux extremites, ou la
+ * methode des trapezes en t converge alors tres vite, meme si les derivees de
+ * la fonction sont infinies aux bornes. On divise le pas par 2 a chaque
+ * niveau en reutilisant la somme des niveaux precedents, donc chaque noeud
+ * n'est evalue qu'une fois, jusqu'a ce que l'ecart entre deux niveaux soit
+ * sous la tolerance.
+ *
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * integrande : Fonction a integrer.
+ * tolerance : Erreur absolue visee.
+ * nEvaluations : Pointeur ou on ecrit le nombre d'appels a la fonction.
+ * erreur : Pointeur ou on ecrit l'ecart entre les deux derniers niveaux.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double tanh_sinh(const double borneInf, const double borneSup,
+                 const struct integrande* integrande, const double tolerance,
+                 int* nEvaluations, double* erreur) {
+    const double demiLargeur = (borneSup - borneInf) / 2;
+    const double centre[1] = {borneInf + demiLargeur};
+    double valeurCentre[1];
+
+    initialiser_tanh_sinh();
+
+    /* Niveau 0: le noeud t = 0, de poids pi / 2, et les t entiers */
+    evaluer_lot(integrande, centre, valeurCentre, 1);
+    *nEvaluations = 1;
+    double somme = M_PI / 2 * valeurCentre[0] +
+                   somme_tanh_sinh(integrande, borneInf, borneSup, 0,
+                                   T_MAX_TANH_SINH, nEvaluations);
+    double precedente = demiLargeur * somme, courante = precedente;
+
+    for (int k = 1; k <= NIVEAUX_TANH_SINH; k++) {
+        somme += somme_tanh_sinh(integrande, borneInf, borneSup,
+                                 T_MAX_TANH_SINH << (k - 1),
+                                 T_MAX_TANH_SINH << k, nEvaluations);
+        courante = demiLargeur * ldexp(somme, -k);
+        *erreur = fabs(courante - precedente);
+        if (*erreur <= tolerance) break;
+        precedente = courante;
+    }
+
+    return courante;
+}
+
+/**
+ * Cette fonction montre le resultat d'une methode adaptative, son erreur
+ * absolue et le nombre d'appels a la fonction a integrer.
+ *
+ * nom : Nom de la methode utilisee pour integrer.
+ * integraleApprox : Valeur de l'integrale approximee.
+ * integraleExacte : Valeur de l'integrale exacte.
+ * nEvaluations : Nombre d'appels a la fonction a integrer.
+ */
+void afficher_adaptative(const char nom[], const double integraleApprox,
+                         const double integraleExacte, const int nEvaluations) {
+    printf("%-17s %11d %19.14f %13.3e\n", nom, nEvaluations,
+           integraleApprox, fabs(integraleApprox - integraleExacte));
+}
+
+/**
+ * Cette fonction multiplie les valeurs y[i] d'une amplitude aux noeuds x[i]
+ * par sin(k x[i] + decalage * pi / 2), en choisissant entre sin_noyau et
+ * sin_general comme sin_decale_lot.
+ *
+ * x : Noeuds.
+ * y : Valeurs de l'amplitude aux noeuds, qu'on multiplie par le sinus.
+ * n : Nombre de noeuds.
+ * k : Frequence.
+ * decalage : Nombre de quarts de tour a ajouter, positif.
+ */
+void multiplier_sin_lot(const double x[], double y[], const int n,
+                        const double k, const int decalage) {
+    int horsDomaine = 0;
+    for (int i = 0; i < n; i++) horsDomaine |= fabs(k * x[i]) > SIN_NOYAU_MAX;
+
+    if (horsDomaine)
+        for (int i = 0; i < n; i++) y[i] *= sin_general(k * x[i], decalage);
+    else
+        for (int i = 0; i < n; i++) y[i] *= sin_noyau(k * x[i], decalage);
+}
+
+/**
+ * Integrande oscillante f(x) sin(kx + decalage * pi / 2), ou l'amplitude f
+ * varie lentement: c'est le contexte de la fonction par lots oscillante_lot.
+ */
+struct oscillante {
+    const struct integrande* amplitude;
+    double k;
+    int decalage;
+};
+
+/**
+ * Cette fonction evalue une integrande oscillante par lots, avec la signature
+ * des fonctions par lots, pour l'integrer par les methodes ordinaires.
+ *
+ * x : Noeuds ou evaluer la fonction.
+ * y : Tableau ou on ecrit les valeurs.
+ * n : Nombre de noeuds.
+ * contexte : Pointeur vers le struct oscillante a evaluer.
+ */
+void oscillante_lot(const double x[], double y[], const int n,
+                    const void* contexte) {
+    const struct oscillante* oscillante = contexte;
+
+    evaluer_lot(oscillante->amplitude, x, y, n);
+    multiplier_sin_lot(x, y, n, oscillante->k, oscillante->decalage);
+}
+
+/**
+ * Cette fonction trouve les coefficients alpha, beta et gamma de la methode
+ * de Filon pour theta = k * pas. Pres de 0, les formules perdent tous leurs
+ * chiffres par soustraction, donc on y utilise plutot leurs series de Taylor.
+ *
+ * theta : Produit de la frequence et de l'ecart entre deux noeuds.
+ * coefficients : Tableau ou on ecrit alpha, beta et gamma.
+ */
+void coefficients_Filon(const double theta, double coefficients[3]) {
+    const double t2 = theta * theta;
+
+    if (fabs(theta) < 1.0 / 6) {
+        coefficients[0] =
+            theta * t2 * (2.0 / 45 + t2 * (-2.0 / 315 + t2 * 2.0 / 4725));
+        coefficients[1] =
+            2.0 / 3 + t2 * (2.0 / 15 + t2 * (-4.0 / 105 + t2 * 2.0 / 567));
+        coefficients[2] =
+            4.0 / 3 + t2 * (-2.0 / 15 + t2 * (1.0 / 210 - t2 / 11340));
+        return;
+    }
+
+    const double s = sin(theta), c = cos(theta), t3 = theta * t2;
+    coefficients[0] = (t2 + theta * s * c - 2 * s * s) / t3;
+    coefficients[1] = 2 * (theta * (1 + c * c) - 2 * s * c) / t3;
+    coefficients[2] = 4 * (s - theta * c) / t3;
+}
+
+/**
+ * On trouve la valeur de l'integrale de f(x) sin(kx + decalage * pi / 2)
+ * entre borneInf et borneSup par la methode de Filon: f est remplacee par sa
+ * parabole d'interpolation sur chaque paire d'intervalles, comme pour
+ * Simpson, mais le produit de cette parabole et du sinus est integre
+ * exactement. Le nombre de noeuds n'a donc pas a suivre la frequence: il doit
+ * seulement suffire a representer f, et l'erreur diminue lorsque k augmente.
+ * L'amplitude est evaluee par blocs, comme dans les methodes par lots.
+ *
+ * nTermes : Nombre d'intervalles, un multiple de 2.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * k : Frequence angulaire.
+ * decalage : 0 pour sin(kx), 1 pour cos(kx).
+ * amplitude : Fonction f qui multiplie le sinus.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double Filon(const int nTermes, const double borneInf, const double borneSup,
+             const double k, const int decalage,
+             const struct integrande* amplitude) {
+    const double pas = (borneSup - borneInf) / nTermes;
+    const double bornes[2] = {borneInf, borneSup};
+    double x[TAILLE_BLOC], y[TAILLE_BLOC], extremites[2], coefficients[3];
+    /* Sommes des f(x) sin(kx + ...) aux noeuds pairs et impairs */
+    double pairs = 0, impairs = 0;
+
+    coefficients_Filon(k * pas, coefficients);
+
+    /* Les blocs ont une taille paire, donc chacun commence sur un noeud
+     * pair */
+    for (int debut = 0; debut <= nTermes; debut += TAILLE_BLOC) {
+        const int n = nTermes + 1 - debut < TAILLE_BLOC ? nTermes + 1 - debut
+                                                        : TAILLE_BLOC;
+        for (int j = 0; j < n; j++) x[j] = borneInf + (debut + j) * pas;
+        evaluer_lot(amplitude, x, y, n);
+        multiplier_sin_lot(x, y, n, k, decalage);
+        for (int j = 0; j < n; j++)
+            if (j % 2)
+                impairs += y[j];
+            else
+                pairs += y[j];
+    }
+
+    evaluer_lot(amplitude, bornes, extremites, 2);
+    pairs -= (extremites[0] * sin_general(k * borneInf, decalage) +
+              extremites[1] * sin_general(k * borneSup, decalage)) /
+             2;
+
+    const double bords =
+        extremites[0] * sin_general(k * borneInf, decalage + 1) -
+        extremites[1] * sin_general(k * borneSup, decalage + 1);
+    return pas * (coefficients[0] * bords + coefficients[1] * pairs +
+                  coefficients[2] * impairs);
+}
+
+/**
+ * Cette fonction resout un systeme lineaire par elimination de Gauss avec
+ * pivot partiel. La matrice et le second membre sont modifies.
+ *
+ * matrice : Matrice du systeme, n lignes de 2 * N_POINTS_LEVIN colonnes.
+ * secondMembre : Second membre, ou on ecrit la solution.
+ * n : Nombre d'inconnues.
+ *
+ * return : 0 si tout va bien, 1 si la matrice est singuliere.
+ */
+int resoudre(double matrice[][2 * N_POINTS_LEVIN], double secondMembre[],
+             const int n) {
+    for (int colonne = 0; colonne < n; colonne++) {
+        /* Ligne du pivot, le plus grand coefficient de la colonne */
+        int pivot = colonne;
+        for (int i = colonne + 1; i < n; i++)
+            if (fabs(matrice[i][colonne]) > fabs(matrice[pivot][colonne]))
+                pivot = i;
+        if (matrice[pivot][colonne] == 0) return 1;
+
+        for (int j = 0; j < n; j++) {
+            const double temporaire = matrice[colonne][j];
+            matrice[colonne][j] = matrice[pivot][j];
+            matrice[pivot][j] = temporaire;
+        }
+        const double temporaire = secondMembre[colonne];
+        secondMembre[colonne] = secondMembre[pivot];
+        secondMembre[pivot] = temporaire;
+
+        for (int i = colonne + 1; i < n; i++) {
+            const double facteur =
+                matrice[i][colonne] / matrice[colonne][colonne];
+            for (int j = colonne; j < n; j++)
+                matrice[i][j] -= facteur * matrice[colonne][j];
+            secondMembre[i] -= facteur * secondMembre[colonne];
+        }
+    }
+
+    for (int i = n - 1; i >= 0; i--) {
+        for (int j = i + 1; j < n; j++)
+            secondMembre[i] -= matrice[i][j] * secondMembre[j];
+        secondMembre[i] /= matrice[i][i];
+    }
+
+    return 0;
+}
+
+/**
+ * On trouve la valeur de l'integrale de f(x) sin(kx + decalage * pi / 2)
+ * entre borneInf et borneSup par la methode de Levin. Sur chaque panneau, on
+ * cherche une fonction p = u + iv qui ne varie pas plus que f et telle que
+ * (p e^(ikx))' = f e^(ikx), c'est-a-dire u' - kv = f et v' + ku = 0:
+ * l'integrale est alors la partie imaginaire de p e^(i(kx + decalage pi / 2))
+ * entre les bornes du panneau. u et v sont des sommes de polynomes de
+ * Tchebychev de degre au plus N_POINTS_LEVIN - 1, et les equations sont
+ * imposees aux points de Tchebychev-Lobatto. Le cout ne depend pas de k; la
+ * methode demande seulement k != 0.
+ *
+ * nPanneaux : Nombre de panneaux.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * k : Frequence angulaire, non nulle.
+ * decalage : 0 pour sin(kx), 1 pour cos(kx).
+ * amplitude : Fonction f qui multiplie le sinus.
+ *
+ * return : Valeur de l'integrale approximee, NAN si un systeme est singulier.
+ */
+double Levin(const int nPanneaux, const double borneInf, const double borneSup,
+             const double k, const int decalage,
+             const struct integrande* amplitude) {
+    const int n = N_POINTS_LEVIN;
+    const double demiLargeur = (borneSup - borneInf) / nPanneaux / 2;
+    /* Polynomes de Tchebychev et leurs derivees aux points de collocation */
+    double tchebychev[N_POINTS_LEVIN][N_POINTS_LEVIN];
+    double derivees[N_POINTS_LEVIN][N_POINTS_LEVIN];
+    double t[N_POINTS_LEVIN], x[N_POINTS_LEVIN], f[N_POINTS_LEVIN];
+    double matrice[2 * N_POINTS_LEVIN][2 * N_POINTS_LEVIN];
+    double coefficients[2 * N_POINTS_LEVIN];
+    double somme = 0;
+
+    for (int m = 0; m < n; m++) {
+        t[m] = cos(M_PI * m / (n - 1));
+        tchebychev[m][0] = 1;
+        tchebychev[m][1] = t[m];
+        derivees[m][0] = 0;
+        derivees[m][1] = 1;
+        for (int j = 1; j + 1 < n; j++) {
+            tchebychev[m][j + 1] =
+                2 * t[m] * tchebychev[m][j] - tchebychev[m][j - 1];
+            derivees[m][j + 1] = 2 * tchebychev[m][j] +
+                                 2 * t[m] * derivees[m][j] -
+                                 derivees[m][j - 1];
+        }
+    }
+
+    for (int p = 0; p < nPanneaux; p++) {
+        const double centre = borneInf + (2 * p + 1) * demiLargeur;
+        /* Frequence pour la variable t de [-1, 1] */
+        const double kt = k * demiLargeur;
+
+        for (int m = 0; m < n; m++) x[m] = centre + demiLargeur * t[m];
+        evaluer_lot(amplitude, x, f, n);
+
+        /* Lignes 0 a n - 1: u' - kt v = demiLargeur f; lignes n a 2n - 1:
+         * v' + kt u = 0. Colonnes 0 a n - 1 pour u, n a 2n - 1 pour v. */
+        for (int m = 0; m < n; m++) {
+            for (int j = 0; j < n; j++) {
+                matrice[m][j] = derivees[m][j];
+                matrice[m][n + j] = -kt * tchebychev[m][j];
+                matrice[n + m][j] = kt * tchebychev[m][j];
+                matrice[n + m][n + j] = derivees[m][j];
+            }
+            coefficients[m] = demiLargeur * f[m];
+            coefficients[n + m] = 0;
+        }
+        if (resoudre(matrice, coefficients, 2 * n)) return NAN;
+
+        /* u et v aux bornes du panneau, t = 1 et t = -1 */
+        double u[2] = {0, 0}, v[2] = {0, 0};
+        for (int j = 0; j < n; j++) {
+            u[0] += coefficients[j];
+            v[0] += coefficients[n + j];
+            u[1] += j % 2 ? -coefficients[j] : coefficients[j];
+            v[1] += j % 2 ? -coefficients[n + j] : coefficients[n + j];
+        }
+        const double droite = centre + demiLargeur,
+                     gauche = centre - demiLargeur;
+        somme += u[0] * sin_general(k * droite, decalage) +
+                 v[0] * sin_general(k * droite, decalage + 1) -
+                 u[1] * sin_general(k * gauche, decalage) -
+                 v[1] * sin_general(k * gauche, decalage + 1);
+    }
+
+    return somme;
+}
+
+/**
+ * Cette fonction montre le resultat d'une integrale numerique approximee selon
+ * une certaine methode.
+ *
+ * nTermes: Nombre de termes a calculer pour l'approximation.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * methode : Fonction pour approximer l'integrale.
+ * fonction : Fonction a integrer.
+ * integraleExacte : Valeur de l'integrale exacte.
+ * nom : Nom de la methode utilisee pour integrer.
+ */
+void approximer_integrale(const int nTermes, const double borneInf,
+                          const double borneSup,
+                          double (*methode)(int, double, double,
+                                            double (*)(double)),
+                          double (*fonction)(double),
+                          const double integraleExacte, const char nom[]) {
+    /* Integrale approximee et son erreur */
+    double integraleApprox, erreur;
+
+    integraleApprox = methode(nTermes, borneInf, borneSup, fonction);
+    erreur = fabs(integraleApprox - integraleExacte) / integraleExacte * 100;
+    printf("%-12s %8d %19.14f  %10.6lf%%\n", nom, nTermes, integraleApprox,
+           erreur);
+}
+
+/**
+ * Grille commune d'echantillons d'une fonction: les noeuds sont
+ * borneInf + i * (borneSup - borneInf) / nIntervalles, et la valeur de la
+ * fonction a un noeud n'est calculee que la premiere fois qu'une methode en a
+ * besoin. Chaque methode d'integration devient alors une somme ponderee sur
+ * un sous-ensemble des noeuds, et comparer plusieurs methodes qui partagent
+ * des noeuds ne coute que les noeuds distincts.
+ */
+struct grille {
+    double borneInf, borneSup;
+    int nIntervalles;
+    double (*fonction)(double);
+    /* Valeurs de la fonction aux noeuds et indicateurs de calcul */
+    double* valeurs;
+    char* calcule;
+    /* Nombre d'appels a la fonction faits jusqu'a present */
+    int nEvaluations;
+};
+
+/**
+ * Cette fonction prepare une grille commune d'echantillons, sans evaluer la
+ * fonction.
+ *
+ * grille : Grille a initialiser.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * nIntervalles : Nombre d'intervalles de la grille, doit etre un multiple du
+ * nombre d'intervalles (ou du double, pour le point milieu) de chaque methode
+ * qui l'utilise.
+ * fonction : Fonction a integrer.
+ *
+ * return : 0 si tout s'est bien passe, 1 si la memoire est insuffisante.
+ */
+int grille_initialiser(struct grille* grille, const double borneInf,
+                       const double borneSup, const int nIntervalles,
+                       double (*fonction)(double)) {
+    grille->borneInf = borneInf;
+    grille->borneSup = borneSup;
+    grille->nIntervalles = nIntervalles;
+    grille->fonction = fonction;
+    grille->nEvaluations = 0;
+    grille->valeurs = malloc((nIntervalles + 1) * sizeof(double));
+    grille->calcule = calloc(nIntervalles + 1, sizeof(char));
+
+    if (!grille->valeurs || !grille->calcule) {
+        free(grille->valeurs);
+        free(grille->calcule);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Cette fonction libere la memoire d'une grille commune d'echantillons.
+ *
+ * grille : Grille a liberer.
+ */
+void grille_liberer(struct grille* grille) {
+    free(grille->valeurs);
+    free(grille->calcule);
+}
+
+/**
+ * Cette fonction donne la valeur de la fonction a un noeud de la grille, en
+ * l'evaluant seulement si elle n'a pas deja ete calculee.
+ *
+ * grille : Grille d'echantillons.
+ * indice : Indice du noeud, entre 0 et nIntervalles.
+ *
+ * return : Valeur de la fonction au noeud.
+ */
+double grille_valeur(struct grille* grille, const int indice) {
+    if (!grille->calcule[indice]) {
+        grille->valeurs[indice] = grille->fonction(
+            grille->borneInf + indice * (grille->borneSup - grille->borneInf) /
+                                   grille->nIntervalles);
+        grille->calcule[indice] = 1;
+        grille->nEvaluations++;
+    }
+    return grille->valeurs[indice];
+}
+
+/**
+ * Versions des methodes du point milieu, de Newton-Cotes fermees d'un certain
+ * ordre, de Simpson et de Newton-Cotes a 10 points qui lisent les valeurs de
+ * la fonction dans une grille commune. Les poids sont les memes que dans les
+ * versions qui evaluent la fonction directement.
+ *
+ * grille : Grille d'echantillons, son nombre d'intervalles doit etre un
+ * multiple de 2 * nTermes pour le point milieu et de nTermes pour les autres.
+ * ordre : Nombre d'intervalles par panneau (Newton_Cotes_grille).
+ * nTermes : Nombre de termes a calculer.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double point_milieu_grille(struct grille* grille, const int nTermes) {
+    /* Ecart entre deux noeuds utilises, en indices de la grille */
+    const int saut = grille->nIntervalles / nTermes;
+
+    double somme = 0;
+    for (int i = 0; i < nTermes; i++) {
+        /* 2 affectations pour += et i++, 3 additions pour +=, + et i++, 2
+         * multiplications pour i * saut et saut / 2, 1 comparaison pour < */
+        COMPTER(AFFECTATIONS, 2);
+        COMPTER(ADDITIONS, 3);
+        COMPTER(MULTIPLICATIONS, 2);
+        COMPTER(COMPARAISONS, 1);
+        somme += grille_valeur(grille, i * saut + saut / 2);
+    }
+
+    return somme * (grille->borneSup - grille->borneInf) / nTermes;
+}
+
+double Newton_Cotes_grille(struct grille* grille, const int ordre,
+                          const int nTermes) {
+    const struct regle_newton_cotes* regle = regle_Newton_Cotes(ordre);
+    /* Ecart entre deux noeuds utilises, en indices de la grille */
+    const int saut = grille->nIntervalles / nTermes;
+
+    double integrale =
+        regle->extremite * (grille_valeur(grille, 0) +
+                            grille_valeur(grille, grille->nIntervalles));
+    for (int i = 1; i < nTermes; i++) {
+        /* 2 affectations pour += et i++, 2 additions pour += et i++, 3
+         * multiplications pour i % ordre, le poids et i * saut, 1 comparaison
+         * pour < */
+        COMPTER(AFFECTATIONS, 2);
+        COMPTER(ADDITIONS, 2);
+        COMPTER(MULTIPLICATIONS, 3);
+        COMPTER(COMPARAISONS, 1);
+        integrale += regle->poids[i % ordre] * grille_valeur(grille, i * saut);
+    }
+
+    return (grille->borneSup - grille->borneInf) / nTermes *
+           regle->numerateur / regle->denominateur * integrale;
+}
+
+double Simpson_grille(struct grille* grille, const int nTermes) {
+    return Newton_Cotes_grille(grille, 2, nTermes);
+}
+
+double Newton_Cotes10_grille(struct grille* grille, const int nTermes) {
+    return Newton_Cotes_grille(grille, 9, nTermes);
+}
+
+/**
+ * Cette fonction montre le resultat d'une integrale numerique approximee selon
+ * une certaine methode qui lit ses valeurs dans une grille commune.
+ *
+ * nTermes: Nombre de termes a calculer pour l'approximation.
+ * grille : Grille d'echantillons de la fonction a integrer.
+ * methode : Fonction pour approximer l'integrale a partir de la grille.
+ * integraleExacte : Valeur de l'integrale exacte.
+ * nom : Nom de la methode utilisee pour integrer.
+ */
+void approximer_integrale_grille(const int nTermes, struct grille* grille,
+                                 double (*methode)(struct grille*, int),
+                                 const double integraleExacte,
+                                 const char nom[]) {
+    /* Integrale approximee et son erreur */
+    double integraleApprox, erreur;
+
+    integraleApprox = methode(grille, nTermes);
+    erreur = fabs(integraleApprox - integraleExacte) / integraleExacte * 100;
+    printf("%-12s %8d %19.14f  %10.6lf%%\n", nom, nTermes, integraleApprox,
+           erreur);
+}
+
+/**
+ * Fonction a integrer du tableau des fonctions: nom, fonction de math.h,
+ * meme fonction evaluee par lots et fonction pour calculer son integrale
+ * exacte. Le numero d'une fonction, pour l'utilisateur, est son indice dans
+ * le tableau plus 1.
+ */
+struct fonction_test {
+    const char* nom;
+    double (*scalaire)(double);
+    void (*lot)(const double[], double[], int, const void*);
+    double (*integrale_exacte)(double, double);
+};
+
+const struct fonction_test fonctionsTest[N_FONCTIONS_TEST] = {
+    {"exp", exp, exp_lot, integrale_exp},
+    {"sin", sin, sin_lot, integrale_sin},
+    {"cos", cos, cos_lot, integrale_cos},
+    {"tan", tan, tan_lot, integrale_tan},
+    {"asin", asin, asin_lot, integrale_asin},
+    {"acos", acos, acos_lot, integrale_acos},
+    {"atan", atan, atan_lot, integrale_atan},
+    {"sinh", sinh, sinh_lot, integrale_sinh},
+    {"cosh", cosh, cosh_lot, integrale_cosh},
+    {"tanh", tanh, tanh_lot, integrale_tanh}};
+
+/**
+ * Cette fonction montre le resultat d'une integration numerique a
+ * l'utilisateur et divers parametres importants de cette integration.
+ *
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * test : Fonction a integrer, avec son integrale exacte.
+ */
+void integration(const double borneInf, const double borneSup,
+                 const struct fonction_test* test) {
+    /* Fonction a integrer */
+    double (*fonction)(double) = test->scalaire;
+
+    /* Valeur exacte de l'integrale */
+    double integraleExacte = test->integrale_exacte(borneInf, borneSup);
+    printf("Valeur exacte pour %s: %19.14lf\n", test->nom, integraleExacte);
+
+    printf("Methode   Intervalles   Valeur approximee       Erreur\n\n");
+
+    /* Grille commune a toutes les methodes du tableau, pour ne jamais
+     * evaluer la fonction deux fois au meme noeud */
+    struct grille grille;
+    if (grille_initialiser(&grille, borneInf, borneSup, N_INTERVALLES_GRILLE,
+                           fonction)) {
+        printf("Memoire insuffisante\n");
+        return;
+    }
+
+    /* Nombre d'appels qu'auraient faits les methodes sans la grille */
+    int nEvaluationsSansGrille = 10;
+    MESURE_DEBUTER(mesure);
+    for (int i = 10; i <= 30; i += 10) {
+        approximer_integrale_grille(i, &grille, point_milieu_grille,
+                                    integraleExacte, "Point milieu");
+        approximer_integrale_grille(i, &grille, Simpson_grille,
+                                    integraleExacte, "Simpson");
+        nEvaluationsSansGrille += 2 * i + 1;
+    }
+    approximer_integrale_grille(9, &grille, Newton_Cotes10_grille,
+                                integraleExacte, "Secrete");
+    MESURE_TERMINER(mesure, "methodes sur la grille");
+    printf("Evaluations de la fonction: %d avec la grille commune, %d sans\n",
+           grille.nEvaluations, nEvaluationsSansGrille);
+    grille_liberer(&grille);
+
+    const struct integrande vectorielle = {test->lot, fonction, NULL};
+
+    printf("\nMethode         Ordre  Panneaux  Evaluations   Valeur approximee"
+           "   Erreur abs.\n\n");
+    afficher_Gauss("Secrete", 10, 2, 19,
+                   Newton_Cotes10_lot(18, borneInf, borneSup, &vectorielle),
+                   integraleExacte);
+    afficher_Gauss("Gauss-Legendre", 5, 2, 10,
+                   Gauss_Legendre(2, 5, borneInf, borneSup, &vectorielle),
+                   integraleExacte);
+    afficher_Gauss("Gauss-Legendre", 10, 1, 10,
+                   Gauss_Legendre(1, 10, borneInf, borneSup, &vectorielle),
+                   integraleExacte);
+    afficher_Gauss("Gauss-Legendre", 8, 4, 32,
+                   Gauss_Legendre(4, 8, borneInf, borneSup, &vectorielle),
+                   integraleExacte);
+    afficher_Gauss("Gauss-Legendre", 64, 1, 64,
+                   Gauss_Legendre(1, 64, borneInf, borneSup, &vectorielle),
+                   integraleExacte);
+
+    /* Nombre d'appels a la fonction et erreur estimee */
+    int nEvaluations;
+    double erreurEstimee;
+
+    printf("\nTolerance %.0e   Evaluations   Valeur approximee   "
+           "Erreur abs.\n\n",
+           TOLERANCE_ADAPTATIVE);
+    double integraleApprox = Gauss_Kronrod_adaptative(
+        borneInf, borneSup, fonction, TOLERANCE_ADAPTATIVE, &nEvaluations,
+        &erreurEstimee);
+    afficher_adaptative("Gauss-Kronrod", integraleApprox, integraleExacte,
+                        nEvaluations);
+    integraleApprox =
+        Simpson_uniforme(borneInf, borneSup, fonction, TOLERANCE_ADAPTATIVE,
+                         &nEvaluations, &erreurEstimee);
+    afficher_adaptative("Simpson uniforme", integraleApprox, integraleExacte,
+                        nEvaluations);
+    integraleApprox =
+        tanh_sinh(borneInf, borneSup, &vectorielle, TOLERANCE_ADAPTATIVE,
+                  &nEvaluations, &erreurEstimee);
+    afficher_adaptative("Tanh-sinh", integraleApprox, integraleExacte,
+                        nEvaluations);
+    printf("\n");
+}
+
+/**
+ * Toutes les fonctions commencant par le prefixe "integrer_" ci-apres donnent
+ * aux methodes a tolerance une meme signature pour le mode --lot.
+ *
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * test : Fonction a integrer.
+ * tolerance : Erreur absolue visee.
+ * nEvaluations : Pointeur ou on ecrit le nombre d'appels a la fonction.
+ * erreur : Pointeur ou on ecrit l'erreur estimee.
+ *
+ * return : Valeur de l'integrale approximee.
+ */
+double integrer_Gauss_Kronrod(const double borneInf, const double borneSup,
+                              const struct fonction_test* test,
+                              const double tolerance, int* nEvaluations,
+                              double* erreur) {
+    return Gauss_Kronrod_adaptative(borneInf, borneSup, test->scalaire,
+                                    tolerance, nEvaluations, erreur);
+}
+
+double integrer_Simpson(const double borneInf, const double borneSup,
+                        const struct fonction_test* test,
+                        const double tolerance, int* nEvaluations,
+                        double* erreur) {
+    return Simpson_uniforme(borneInf, borneSup, test->scalaire, tolerance,
+                            nEvaluations, erreur);
+}
+
+double integrer_tanh_sinh(const double borneInf, const double borneSup,
+                          const struct fonction_test* test,
+                          const double tolerance, int* nEvaluations,
+                          double* erreur) {
+    const struct integrande integrande = {test->lot, test->scalaire, NULL};
+    return tanh_sinh(borneInf, borneSup, &integrande, tolerance, nEvaluations,
+                     erreur);
+}
+
+/**
+ * Methode du mode --lot: nom dans le fichier de travaux et fonction qui
+ * l'applique.
+ */
+struct methode_lot {
+    const char* nom;
+    double (*integrer)(double, double, const struct fonction_test*, double,
+                       int*, double*);
+};
+
+const struct methode_lot methodesLot[N_METHODES_LOT] = {
+    {"gauss-kronrod", integrer_Gauss_Kronrod},
+    {"simpson", integrer_Simpson},
+    {"tanh-sinh", integrer_tanh_sinh}};
+
+/**
+ * Travail du mode --lot: integrale demandee par une ligne du fichier, puis
+ * son resultat (valeur, erreur estimee, nombre d'appels a la fonction et
+ * temps de calcul en secondes).
+ */
+struct tache {
+    const struct fonction_test* test;
+    const struct methode_lot* methode;
+    double borneInf, borneSup, tolerance;
+    double valeur, erreur, temps;
+    int nEvaluations;
+};
+
+/**
+ * File des travaux partagee par les fils d'execution: chaque fil prend le
+ * prochain travail qui n'est pas commence, donc un travail long n'en retarde
+ * pas d'autres qui attendraient derriere lui.
+ */
+struct file_taches {
+    struct tache* taches;
+    int nTaches, prochaine;
+    pthread_mutex_t verrou;
+};
+
+/**
+ * Cette fonction est executee par chaque fil d'execution du mode --lot: elle
+ * prend des travaux dans la file jusqu'a ce qu'elle soit vide.
+ *
+ * argument : Pointeur vers la struct file_taches
+ *
+ * return : NULL
+ */
+void* executer_taches(void* argument) {
+    struct file_taches* file = argument;
+
+    for (;;) {
+        pthread_mutex_lock(&file->verrou);
+        const int i = file->prochaine++;
+        pthread_mutex_unlock(&file->verrou);
+        if (i >= file->nTaches) break;
+
+        struct tache* tache = &file->taches[i];
+        struct timespec debut, fin;
+        clock_gettime(CLOCK_MONOTONIC, &debut);
+        tache->valeur = tache->methode->integrer(
+            tache->borneInf, tache->borneSup, tache->test, tache->tolerance,
+            &tache->nEvaluations, &tache->erreur);
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+        tache->temps = (fin.tv_sec - debut.tv_sec) +
+                       (fin.tv_nsec - debut.tv_nsec) * 1e-9;
+    }
+
+    return NULL;
+}
+
+/**
+ * Cette fonction lit le fichier de travaux du mode --lot. Chaque ligne
+ * contient un numero de fonction, les bornes, le nom d'une methode et la
+ * tolerance, et rien d'autre; les lignes vides et celles qui commencent par #
+ * sont ignorees. Un fichier sans aucun travail est une erreur.
+ *
+ * nomFichier : Nom du fichier de travaux.
+ * nTaches : Pointeur ou on ecrit le nombre de travaux lus.
+ *
+ * return : Tableau des travaux, a liberer, ou NULL en cas d'erreur.
+ */
+struct tache* lire_taches(const char nomFichier[], int* nTaches) {
+    FILE* fichier = fopen(nomFichier, "r");
+    if (!fichier) {
+        printf("Impossible d'ouvrir %s\n", nomFichier);
+        return NULL;
+    }
+
+    struct tache* taches = NULL;
+    int capacite = 0, nLigne = 0;
+    char ligne[LONGUEUR_LIGNE];
+    *nTaches = 0;
+
+    while (fgets(ligne, sizeof ligne, fichier)) {
+        nLigne++;
+        /* Numero de fonction, bornes, methode et tolerance de la ligne */
+        int nf, fin = 0;
+        double borneInf, borneSup, tolerance;
+        char nomMethode[32], premier[2];
+        if (sscanf(ligne, " %1s", premier) != 1 || premier[0] == '#') continue;
+
+        const struct methode_lot* methode = NULL;
+        /* fin est la position apres la tolerance et les blancs qui suivent,
+         * la ligne doit s'arreter la */
+        if (sscanf(ligne, "%d %lf %lf %31s %lf %n", &nf, &borneInf, &borneSup,
+                   nomMethode, &tolerance, &fin) == 5 &&
+            ligne[fin] == '\0')
+            for (int i = 0; i < N_METHODES_LOT; i++)
+                if (!strcmp(nomMethode, methodesLot[i].nom))
+                    methode = &methodesLot[i];
+        if (!methode || nf < 1 || nf > N_FONCTIONS_TEST || tolerance <= 0) {
+            printf("%s, ligne %d: travail invalide\n", nomFichier, nLigne);
+            free(taches);
+            fclose(fichier);
+            return NULL;
+        }
+
+        if (*nTaches == capacite) {
+            capacite = capacite ? 2 * capacite : 64;
+            struct tache* agrandi = realloc(taches, capacite * sizeof *taches);
+            if (!agrandi) {
+                printf("Memoire insuffisante\n");
+                free(taches);
+                fclose(fichier);
+                return NULL;
+            }
+            taches = agrandi;
+        }
+        taches[(*nTaches)++] = (struct tache){.test = &fonctionsTest[nf - 1],
+                                              .methode = methode,
+                                              .borneInf = borneInf,
+                                              .borneSup = borneSup,
+                                              .tolerance = tolerance};
+    }
+
+    fclose(fichier);
+    if (!*nTaches) printf("%s: aucun travail\n", nomFichier);
+    return taches;
+}
+
+/**
+ * Cette fonction execute le mode --lot: elle lit les travaux, les repartit
+ * entre les fils d'execution et ecrit les resultats en CSV, dans l'ordre du
+ * fichier de travaux.
+ *
+ * nomTravaux : Nom du fichier de travaux.
+ * nomResultats : Nom du fichier CSV, NULL pour la sortie standard.
+ * nFils : Nombre de fils d'execution.
+ *
+ * return : Code de sortie du programme.
+ */
+int Lot(const char nomTravaux[], const char nomResultats[], int nFils) {
+    pthread_t fils[N_FILS_MAX];
+    struct file_taches file = {NULL, 0, 0, PTHREAD_MUTEX_INITIALIZER};
+
+    file.taches = lire_taches(nomTravaux, &file.nTaches);
+    if (!file.taches) return 1;
+
+    FILE* resultats = nomResultats ? fopen(nomResultats, "w") : stdout;
+    if (!resultats) {
+        printf("Impossible d'ouvrir %s\n", nomResultats);
+        free(file.taches);
+        return 1;
+    }
+
+    /* Les tables partagees sont remplies avant de lancer les fils */
+    initialiser_tanh_sinh();
+    regle_Newton_Cotes(2);
+
+    if (nFils > N_FILS_MAX) nFils = N_FILS_MAX;
+    if (nFils < 1) nFils = 1;
+
+    struct timespec debut, fin;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    /* Si un fil ne peut pas etre cree, on continue avec ceux qui le sont: le
+     * fil principal vide la file de toute facon */
+    int lances = 1;
+    while (lances < nFils &&
+           !pthread_create(&fils[lances], NULL, executer_taches, &file))
+        lances++;
+    nFils = lances;
+    executer_taches(&file);
+    for (int i = 1; i < nFils; i++) pthread_join(fils[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+
+    fprintf(resultats, "fonction,borne_inf,borne_sup,methode,tolerance,"
+                       "valeur,erreur_estimee,erreur_reelle,evaluations,"
+                       "temps_s\n");
+    for (int i = 0; i < file.nTaches; i++) {
+        const struct tache* tache = &file.taches[i];
+        fprintf(resultats, "%s,%.17g,%.17g,%s,%.3g,%.17g,%.3e,%.3e,%d,%.6f\n",
+                tache->test->nom, tache->borneInf, tache->borneSup,
+                tache->methode->nom, tache->tolerance, tache->valeur,
+                tache->erreur,
+                fabs(tache->valeur - tache->test->integrale_exacte(
+                                         tache->borneInf, tache->borneSup)),
+                tache->nEvaluations, tache->temps);
+    }
+    if (nomResultats) {
+        fclose(resultats);
+        printf("%d travaux, %d fils, %.3f s\n", file.nTaches, nFils,
+               (fin.tv_sec - debut.tv_sec) +
+                   (fin.tv_nsec - debut.tv_nsec) * 1e-9);
+    }
+
+    free(file.taches);
+    return 0;
+}
+
+/**
+ * Cette fonction evalue un ruban noeud par noeud, avec un appel a ruban_lot
+ * par noeud, comme le ferait un interpreteur qui parcourt l'expression pour
+ * chaque valeur de x. Elle sert de reference pour mesurer le gain des blocs.
+ *
+ * x : Noeuds ou evaluer l'expression.
+ * y : Tableau ou on ecrit les valeurs.
+ * n : Nombre de noeuds.
+ * contexte : Pointeur vers le struct ruban a evaluer.
+ */
+void ruban_noeud_par_noeud(const double x[], double y[], const int n,
+                           const void* contexte) {
+    for (int i = 0; i < n; i++) ruban_lot(&x[i], &y[i], 1, contexte);
+}
+
+/**
+ * Cette fonction execute le mode --expression: elle compile une expression de
+ * x, affiche son ruban et l'integre entre deux bornes par plusieurs methodes.
+ * Comme l'integrale exacte n'est pas connue, on affiche l'erreur estimee par
+ * chaque methode: ecart avec la meme methode a moitie moins de noeuds pour
+ * Simpson (divise par 15) et Gauss-Legendre, estimation propre a tanh-sinh.
+ * On verifie aussi le ruban par blocs contre une evaluation avec math.h.
+ *
+ * texte : Expression a integrer.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ *
+ * return : Code de sortie du programme.
+ */
+int Expression(const char texte[], const double borneInf,
+               const double borneSup) {
+    static struct ruban ruban;
+    /* Position de l'erreur de compilation dans le texte */
+    int positionErreur;
+
+    const char* erreur = compiler_expression(texte, &ruban, &positionErreur);
+    if (erreur) {
+        printf("%s\n%*s^\nExpression invalide: %s\n", texte, positionErreur,
+               "", erreur);
+        return 1;
+    }
+
+    const struct integrande integrande = {ruban_lot, NULL, &ruban};
+    const struct integrande unitaire = {ruban_noeud_par_noeud, NULL, &ruban};
+
+    printf("Ruban de %s: %d instructions, %d registres\n", texte,
+           ruban.nInstructions, ruban.nRegistres);
+    afficher_ruban(&ruban);
+
+    printf("\nMethode         Ordre  Panneaux  Evaluations   Valeur approximee"
+           "   Erreur est.\n\n");
+    double valeur = Simpson_lot(30000, borneInf, borneSup, &integrande);
+    printf("%-15s %5d %9d %11d %19.14f %13.3e\n", "Simpson", 2, 15000, 30001,
+           valeur,
+           fabs(valeur - Simpson_lot(15000, borneInf, borneSup, &integrande)) /
+               15);
+    valeur = Gauss_Legendre(8, 20, borneInf, borneSup, &integrande);
+    printf("%-15s %5d %9d %11d %19.14f %13.3e\n", "Gauss-Legendre", 20, 8,
+           160, valeur,
+           fabs(valeur -
+                Gauss_Legendre(4, 20, borneInf, borneSup, &integrande)));
+    /* Nombre d'appels a la fonction et erreur estimee de tanh-sinh */
+    int nEvaluations;
+    double erreurEstimee;
+    valeur = tanh_sinh(borneInf, borneSup, &integrande, TOLERANCE_ADAPTATIVE,
+                       &nEvaluations, &erreurEstimee);
+    printf("%-15s %5s %9s %11d %19.14f %13.3e\n", "Tanh-sinh", "-", "-",
+           nEvaluations, valeur, erreurEstimee);
+
+    const double tempsBlocs =
+        temps_lot(30000, borneInf, borneSup, Simpson_lot, &integrande);
+    const double tempsNoeuds =
+        temps_lot(30000, borneInf, borneSup, Simpson_lot, &unitaire);
+    printf("\nCout par noeud: %.2f ns par blocs, %.2f ns noeud par noeud "
+           "(%.1fx)\n",
+           tempsBlocs / 30001 * 1e9, tempsNoeuds / 30001 * 1e9,
+           tempsNoeuds / tempsBlocs);
+    printf("Ecart maximal avec math.h sur les noeuds de Simpson: %.3e\n",
+           verifier_ruban(&ruban, borneInf, borneSup, 30001));
+
+    return 0;
+}
+
+/**
+ * Cette fonction mesure le temps moyen (en secondes) d'un appel a
+ * Newton_Cotes_vectorielle, comme temps_lot.
+ *
+ * ordre : Ordre de la regle de Newton-Cotes.
+ * nTermes: Nombre de termes a calculer pour l'approximation.
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * integrandes : Fonctions a integrer.
+ * nIntegrandes : Nombre de fonctions.
+ *
+ * return : Temps moyen d'un appel en secondes.
+ */
+double temps_vectorielle(const int ordre, const int nTermes,
+                         const double borneInf, const double borneSup,
+                         const struct integrande integrandes[],
+                         const int nIntegrandes) {
+    /* Resultats, qui ne servent qu'a garder les appels */
+    double resultats[N_FONCTIONS_TEST];
+    /* Nombre d'appels et temps ecoule */
+    long nAppels = 0;
+    double ecoule;
+    struct timespec debut, fin;
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    do {
+        Newton_Cotes_vectorielle(ordre, nTermes, borneInf, borneSup,
+                                 integrandes, nIntegrandes, resultats);
+        nAppels++;
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+        ecoule = (fin.tv_sec - debut.tv_sec) +
+                 (fin.tv_nsec - debut.tv_nsec) * 1e-9;
+    } while (ecoule < TEMPS_MESURE);
+
+    return ecoule / nAppels;
+}
+
+/**
+ * Cette fonction execute le mode --vectorielle: elle integre toutes les
+ * fonctions du tableau des fonctions entre deux bornes en une seule passe
+ * sur les noeuds, par Simpson et par Gauss-Legendre, puis compare le temps de
+ * cette passe a celui d'un appel de Simpson_lot par fonction.
+ *
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ *
+ * return : Code de sortie du programme.
+ */
+int Vectorielle(const double borneInf, const double borneSup) {
+    struct integrande integrandes[N_FONCTIONS_TEST];
+    /* Integrales approximees par Simpson et par Gauss-Legendre */
+    double simpson[N_FONCTIONS_TEST], gauss[N_FONCTIONS_TEST];
+
+    for (int k = 0; k < N_FONCTIONS_TEST; k++)
+        integrandes[k] = (struct integrande){fonctionsTest[k].lot,
+                                             fonctionsTest[k].scalaire, NULL};
 
-double integrale_asin(const double borneInf, const double borneSup) {
-    return borneSup * asin(borneSup) + sqrt(1 - borneSup * borneSup) -
-           (borneInf * asin(borneInf) + sqrt(1 - borneInf * borneInf));
-}
+    Newton_Cotes_vectorielle(2, 30000, borneInf, borneSup, integrandes,
+                             N_FONCTIONS_TEST, simpson);
+    Gauss_Legendre_vectorielle(8, 20, borneInf, borneSup, integrandes,
+                               N_FONCTIONS_TEST, gauss);
 
-double integrale_acos(const double borneInf, const double borneSup) {
-    return borneSup * acos(borneSup) - sqrt(1 - borneSup * borneSup) -
-           (borneInf * acos(borneInf) - sqrt(1 - borneInf * borneInf));
-}
+    printf("Integrales entre %g et %g en une passe: Simpson a 30000 "
+           "intervalles,\nGauss-Legendre d'ordre 20 a 8 panneaux\n\n",
+           borneInf, borneSup);
+    printf("Fonction   Simpson               Erreur abs.  Gauss-Legendre"
+           "        Erreur abs.\n\n");
+    for (int k = 0; k < N_FONCTIONS_TEST; k++) {
+        const double exacte =
+            fonctionsTest[k].integrale_exacte(borneInf, borneSup);
+        printf("%-8s %19.14f %13.3e %19.14f %13.3e\n", fonctionsTest[k].nom,
+               simpson[k], fabs(simpson[k] - exacte), gauss[k],
+               fabs(gauss[k] - exacte));
+    }
 
-double integrale_atan(const double borneInf, const double borneSup) {
-    return borneSup * atan(borneSup) - 0.5 * log(1 + borneSup * borneSup) -
-           (borneInf * atan(borneInf) - 0.5 * log(1 + borneInf * borneInf));
-}
+    /* Temps des appels separes et de la passe unique */
+    double tempsSepares = 0;
+    for (int k = 0; k < N_FONCTIONS_TEST; k++)
+        tempsSepares +=
+            temps_lot(30000, borneInf, borneSup, Simpson_lot, &integrandes[k]);
+    const double tempsPasse = temps_vectorielle(
+        2, 30000, borneInf, borneSup, integrandes, N_FONCTIONS_TEST);
+    printf("\nSimpson: %.3f ms en %d appels, %.3f ms en une passe (%.2fx)\n",
+           tempsSepares * 1e3, N_FONCTIONS_TEST, tempsPasse * 1e3,
+           tempsSepares / tempsPasse);
 
-double integrale_sinh(const double borneInf, const double borneSup) {
-    return cosh(borneSup) - cosh(borneInf);
-}
+    /* Moments x^k, k = 0, ..., N_FONCTIONS_TEST - 1, compiles en rubans: des
+     * fonctions peu couteuses, pour lesquelles les noeuds comptent plus */
+    static struct ruban moments[N_FONCTIONS_TEST];
+    for (int k = 0; k < N_FONCTIONS_TEST; k++) {
+        char texte[16];
+        int positionErreur;
+        sprintf(texte, "x^%d", k);
+        compiler_expression(texte, &moments[k], &positionErreur);
+        integrandes[k] = (struct integrande){ruban_lot, NULL, &moments[k]};
+    }
+    tempsSepares = 0;
+    for (int k = 0; k < N_FONCTIONS_TEST; k++)
+        tempsSepares +=
+            temps_lot(30000, borneInf, borneSup, Simpson_lot, &integrandes[k]);
+    const double tempsMoments = temps_vectorielle(
+        2, 30000, borneInf, borneSup, integrandes, N_FONCTIONS_TEST);
+    printf("Moments: %.3f ms en %d appels, %.3f ms en une passe (%.2fx)\n",
+           tempsSepares * 1e3, N_FONCTIONS_TEST, tempsMoments * 1e3,
+           tempsSepares / tempsMoments);
 
-double integrale_cosh(const double borneInf, const double borneSup) {
-    return sinh(borneSup) - sinh(borneInf);
+    return 0;
 }
 
-double integrale_tanh(const double borneInf, const double borneSup) {
-    return log(cosh(borneSup)) - log(cosh(borneInf));
+/**
+ * Cette fonction trouve la valeur exacte de l'integrale de e^x sin(kx).
+ *
+ * borneInf : Borne inferieure d'integration.
+ * borneSup : Borne superieure d'integration.
+ * k : Frequence angulaire.
+ *
+ * return : Valeur exacte de l'integrale.
+ */
+double integrale_exp_sin(const double borneInf, const double borneSup,
+                         const double k) {
+    return (exp(borneSup) * (sin(k * borneSup) - k * cos(k * borneSup)) -
+            exp(borneInf) * (sin(k * borneInf) - k * cos(k * borneInf))) /
+           (1 + k * k);
 }
 
 /**
- * On trouve la valeur de l'integrale par la methode du point milieu d'une
- * fonction entre borneInf et borneSup.
+ * Toutes les fonctions se terminant par le suffixe "_oscillante" ci-apres
+ * donnent une meme signature aux methodes comparees par le mode --oscillante.
+ * Simpson double le nombre d'intervalles jusqu'a ce que l'ecart entre deux
+ * niveaux, divise par 15, soit sous TOLERANCE_OSCILLANTE; Filon et Levin
+ * utilisent un nombre fixe de noeuds.
  *
- * nTermes : Nombre de termes a calculer.
  * borneInf : Borne inferieure d'integration.
  * borneSup : Borne superieure d'integration.
- * fonction : Fonction a integrer.
+ * oscillante : Fonction a integrer.
+ * nEvaluations : Pointeur ou on ecrit le nombre d'evaluations de l'amplitude.
  *
  * return : Valeur de l'integrale approximee.
  */
-double point_milieu(const int nTermes, const double borneInf,
-                    const double borneSup, double (*fonction)(double)) {
-    /* Pas d'integration (largeur dx) */
-    const double pas = (borneSup - borneInf) / nTermes;
+double Simpson_oscillante(const double borneInf, const double borneSup,
+                          const struct oscillante* oscillante,
+                          int* nEvaluations) {
+    const struct integrande integrande = {oscillante_lot, NULL, oscillante};
+    /* On part d'environ un intervalle par radian: avec moins, deux niveaux
+     * sous-echantillonnes peuvent s'accorder par hasard */
+    int nTermes = 2;
+    while (nTermes < oscillante->k * (borneSup - borneInf)) nTermes *= 2;
+    double precedente = Simpson_lot(nTermes, borneInf, borneSup, &integrande);
+    double courante = precedente;
 
-    /* Terme sous la forme d'une somme dans la formule du point milieu */
-    double somme = 0;
-    for (int i = 0; i <= nTermes - 1; i++) {
-        somme += fonction(borneInf + pas * (i + 0.5));
+    *nEvaluations = nTermes + 1;
+    for (nTermes *= 2; nTermes <= N_INTERVALLES_OSCILLANTE_MAX;
+         nTermes *= 2) {
+        courante = Simpson_lot(nTermes, borneInf, borneSup, &integrande);
+        *nEvaluations += nTermes + 1;
+        if (fabs(courante - precedente) / 15 < TOLERANCE_OSCILLANTE) break;
+        precedente = courante;
     }
-    return somme * pas;
+
+    return courante;
+}
+
+double Filon_oscillante(const double borneInf, const double borneSup,
+                        const struct oscillante* oscillante,
+                        int* nEvaluations) {
+    *nEvaluations = N_TERMES_FILON + 3;
+    return Filon(N_TERMES_FILON, borneInf, borneSup, oscillante->k,
+                 oscillante->decalage, oscillante->amplitude);
+}
+
+double Levin_oscillante(const double borneInf, const double borneSup,
+                        const struct oscillante* oscillante,
+                        int* nEvaluations) {
+    *nEvaluations = N_PANNEAUX_LEVIN * N_POINTS_LEVIN;
+    return Levin(N_PANNEAUX_LEVIN, borneInf, borneSup, oscillante->k,
+                 oscillante->decalage, oscillante->amplitude);
 }
 
 /**
- * On trouve la valeur de l'integrale par la methode de Simpson d'une fonction
- * entre borneInf et borneSup. On prend des doubles pour les bornes parce que
- * sinon les resultats dependent de l'ordinateur (mon portable produit des
- * resultats differents de mon ordinateur de bureau avec des floats).
+ * Cette fonction montre le resultat d'une methode pour une integrale
+ * oscillante et son temps moyen, mesure comme dans temps_lot.
  *
- * nTermes : Nombre de termes a calculer pour la sommation, doit etre un
- * multiple de 2.
+ * methode : Methode d'integration.
+ * oscillante : Fonction a integrer entre 0 et 1.
+ * integraleExacte : Valeur exacte de l'integrale.
+ * nom : Nom de la methode.
+ */
+void mesurer_oscillante(double (*methode)(double, double,
+                                          const struct oscillante*, int*),
+                        const struct oscillante* oscillante,
+                        const double integraleExacte, const char nom[]) {
+    /* Nombre d'evaluations, nombre d'appels et temps ecoule */
+    int nEvaluations;
+    long nAppels = 0;
+    double valeur, ecoule;
+    struct timespec debut, fin;
+
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    do {
+        valeur = methode(0, 1, oscillante, &nEvaluations);
+        nAppels++;
+        clock_gettime(CLOCK_MONOTONIC, &fin);
+        ecoule = (fin.tv_sec - debut.tv_sec) +
+                 (fin.tv_nsec - debut.tv_nsec) * 1e-9;
+    } while (ecoule < TEMPS_MESURE);
+
+    printf("%-9s %11d %19.14f %13.3e %11.4f\n", nom, nEvaluations, valeur,
+           fabs(valeur - integraleExacte), ecoule / nAppels * 1e3);
+}
+
+/**
+ * Cette fonction execute le mode --couts: pour une fonction du tableau entre
+ * deux bornes, elle mesure l'ecart et le cout des variantes des methodes de
+ * Simpson et de Newton-Cotes a 10 points (double-double, noeuds sans
+ * branches et evaluation par lots). Ces mesures prennent du temps, donc le
+ * mode interactif ne les fait pas.
+ *
+ * test : Fonction a integrer.
  * borneInf : Borne inferieure d'integration.
  * borneSup : Borne superieure d'integration.
- * fonction : Fonction a integrer.
  *
- * return : Valeur de l'integrale approximee
+ * return : Code de sortie du programme.
  */
-double Simpson(const int nTermes, const double borneInf, const double borneSup,
-               double (*fonction)(double)) {
-    /* Pas d'integration (largeur dx) */
-    const double pas = (borneSup - borneInf) / nTermes;
+int Couts(const struct fonction_test* test, const double borneInf,
+          const double borneSup) {
+    double (*fonction)(double) = test->scalaire;
+    const struct integrande vectorielle = {test->lot, fonction, NULL};
 
-    /* Terme par lequel on va multiplier le pas / 3 pour obtenir l'integrale
-     * finale */
-    double integrale = fonction(borneInf) + fonction(borneSup);
-    for (int i = 1; i < nTermes; i++) {
-        if (i % 2)
-            integrale += 4.0 * fonction(borneInf + i * pas);
-        else
-            integrale += 2.0 * fonction(borneInf + i * pas);
-    }
+    printf("Couts pour %s entre %g et %g\n", test->nom, borneInf, borneSup);
 
-    return pas / 3.0 * integrale;
+    printf("\nDouble-double  Intervalles  Ecart double/dd   Cout dd\n\n");
+    comparer_double_double(3000, borneInf, borneSup, Simpson, Simpson_dd,
+                           fonction, "Simpson");
+    comparer_double_double(900, borneInf, borneSup, Newton_Cotes10,
+                           Newton_Cotes10_dd, fonction, "Secrete");
+
+    printf("\nNewton-Cotes  Intervalles  Ecart if/general  Acceleration\n\n");
+    comparer_branches(30006, borneInf, borneSup, Simpson, Simpson_branches,
+                      fonction, "Simpson");
+    comparer_branches(30006, borneInf, borneSup, Newton_Cotes10,
+                      Newton_Cotes10_branches, fonction, "Secrete");
+
+    printf("\nPar lots      Intervalles  Ecart math.h/lots  Acceleration\n\n");
+    comparer_lot(30000, borneInf, borneSup, Simpson_lot, &vectorielle,
+                 "Simpson");
+    comparer_lot(29997, borneInf, borneSup, Newton_Cotes10_lot, &vectorielle,
+                 "Secrete");
+
+    return 0;
 }
 
 /**
- * On trouve la valeur de l'integrale par une methode de Newton-Cotes a 10
- * points d'une fonction entre borneInf et borneSup.
- *
- * nTermes : Nombre de termes a calculer pour la sommation, doit etre un
- * multiple de 9.
- * borneInf : Borne inferieure d'integration
- * borneSup : Borne superieure d'integration
- * fonction : Fonction a integrer
+ * Cette fonction execute le mode --oscillante: elle compare Simpson, Filon et
+ * Levin sur l'integrale de e^x sin(kx) entre 0 et 1, pour des frequences k
+ * allant de 1 a 10^6.
  *
- * return : Valeur de l'integrale approximee
+ * return : Code de sortie du programme.
  */
-double Newton_Cotes10(const int nTermes, const double borneInf,
-                      const double borneSup, double (*fonction)(double)) {
-    /* Pas d'integration (largeur dx) */
-    const double pas = (borneSup - borneInf) / nTermes;
+int Oscillante() {
+    const struct integrande amplitude = {exp_lot, exp, NULL};
 
-    double integrale = 2857 * (fonction(borneInf) + fonction(borneSup));
-    for (int i = 1; i < nTermes; i++) {
-        if (i % 9 == 1 || i % 9 == 8)
-            integrale += 15741 * fonction(borneInf + pas * i);
-        else if (i % 9 == 2 || i % 9 == 7)
-            integrale += 1080 * fonction(borneInf + pas * i);
-        else if (i % 9 == 3 || i % 9 == 6)
-            integrale += 19344 * fonction(borneInf + pas * i);
-        else if (i % 9 == 4 || i % 9 == 5)
-            integrale += 5778 * fonction(borneInf + pas * i);
-        else
-            integrale += 5714 * fonction(borneInf + pas * i);
+    initialiser_tanh_sinh();
+    printf("Integrale de e^x sin(kx) entre 0 et 1, tolerance de Simpson "
+           "%.0e\n",
+           TOLERANCE_OSCILLANTE);
+    for (double k = 1; k <= 1e6; k *= 10) {
+        const struct oscillante oscillante = {&amplitude, k, 0};
+        const double integraleExacte = integrale_exp_sin(0, 1, k);
+
+        printf("\nk = %-8.0f Evaluations   Valeur approximee   Erreur abs."
+               "  Temps (ms)\n",
+               k);
+        mesurer_oscillante(Simpson_oscillante, &oscillante, integraleExacte,
+                           "Simpson");
+        mesurer_oscillante(Filon_oscillante, &oscillante, integraleExacte,
+                           "Filon");
+        mesurer_oscillante(Levin_oscillante, &oscillante, integraleExacte,
+                           "Levin");
     }
 
-    return 9 * pas / 89600 * integrale;
+    return 0;
 }
 
 /**
- * Cette fonction montre le resultat d'une integrale numerique approximee selon
- * une certaine methode.
+ * Noyau du banc d'essai: une methode a nombre d'intervalles fixe
+ * (N_INTERVALLES_GRILLE) ou une methode a tolerance du mode --lot
+ * (TOLERANCE_ADAPTATIVE), appliquee a exp entre 0 et 1.
+ */
+struct banc_integration {
+    /* Methode a nombre d'intervalles fixe, NULL pour une methode a
+     * tolerance */
+    double (*fixe)(int, double, double, double (*)(double));
+    const struct methode_lot* adaptative;
+    /* Integrale obtenue, resultat du noyau */
+    double valeur;
+};
+
+/**
+ * Cette fonction calcule l'integrale d'un noyau du banc d'essai.
  *
- * nTermes: Nombre de termes a calculer pour l'approximation.
- * borneInf : Borne inferieure d'integration.
- * borneSup : Borne superieure d'integration.
- * methode : Fonction pour approximer l'integrale.
- * fonction : Fonction a integrer.
- * integraleExacte : Valeur de l'integrale exacte.
- * nom : Nom de la methode utilisee pour integrer.
+ * donnees : Pointeur vers une struct banc_integration.
  */
-void approximer_integrale(const int nTermes, const double borneInf,
-                          const double borneSup,
-                          double (*methode)(int, double, double,
-                                            double (*)(double)),
-                          double (*fonction)(double),
-                          const double integraleExacte, const char nom[]) {
-    /* Integrale approximee et son erreur */
-    double integraleApprox, erreur;
+void banc_integration(void* donnees) {
+    struct banc_integration* banc = donnees;
+    int nEvaluations;
+    double erreur;
 
-    integraleApprox = methode(nTermes, borneInf, borneSup, fonction);
-    erreur = fabs(integraleApprox - integraleExacte) / integraleExacte * 100;
-    printf("%-12s %8d %19.14f  %10.6lf%%\n", nom, nTermes, integraleApprox,
-           erreur);
+    if (banc->fixe)
+        banc->valeur = banc->fixe(N_INTERVALLES_GRILLE, 0, 1, exp);
+    else
+        banc->valeur = banc->adaptative->integrer(
+            0, 1, &fonctionsTest[0], TOLERANCE_ADAPTATIVE, &nEvaluations,
+            &erreur);
 }
 
 /**
- * Cette fonction montre le resultat d'une integration numerique a
- * l'utilisateur et divers parametres importants de cette integration.
+ * Cette fonction lit un nombre reel dans un argument de la ligne de commande,
+ * qui ne doit rien contenir d'autre.
  *
- * borneInf : Borne inferieure d'integration.
- * borneSup : Borne superieure d'integration.
- * integrale_exacte : Fonction pour calculer l'integrale exacte.
- * fonction : Fonction a integrer.
- * nom : Nom de la methode utilisee pour integrer.
+ * texte : Argument a lire.
+ * valeur : Pointeur ou on ecrit le nombre lu.
+ *
+ * return : 1 si l'argument est un nombre fini, 0 sinon.
  */
-void integration(const double borneInf, const double borneSup,
-                 double (*integrale_exacte)(double, double),
-                 double (*fonction)(double), const char nom[]) {
-    /* Valeur exacte de l'integrale */
-    double integraleExacte = integrale_exacte(borneInf, borneSup);
-    printf("Valeur exacte pour %s: %19.14lf\n", nom, integraleExacte);
+int lire_reel(const char texte[], double* valeur) {
+    char* fin;
+    *valeur = strtod(texte, &fin);
+    return fin != texte && *fin == '\0' && isfinite(*valeur);
+}
 
-    printf("Methode   Intervalles   Valeur approximee       Erreur\n\n");
+int main(int argc, char* argv[]) {
+    /* Noyaux du banc d'essai: point milieu et Simpson, puis les methodes a
+     * tolerance du mode --lot */
+    static struct banc_integration bancs[2 + N_METHODES_LOT] = {
+        {point_milieu, NULL, 0}, {Simpson, NULL, 0}};
+    banc_enregistrer("point milieu (360 intervalles)", banc_integration,
+                     &bancs[0]);
+    banc_enregistrer("simpson (360 intervalles)", banc_integration,
+                     &bancs[1]);
+    for (int i = 0; i < N_METHODES_LOT; i++) {
+        bancs[2 + i].adaptative = &methodesLot[i];
+        banc_enregistrer(methodesLot[i].nom, banc_integration, &bancs[2 + i]);
+    }
+    if (banc_lancer(argc, argv)) return 0;
 
-    for (int i = 10; i <= 30; i += 10) {
-        approximer_integrale(i, borneInf, borneSup, point_milieu, fonction,
-                             integraleExacte, "Point milieu");
-        approximer_integrale(i, borneInf, borneSup, Simpson, fonction,
-                             integraleExacte, "Simpson");
+    /* Bornes d'integrations */
+    double binf, bsup;
+
+    /* Mode qui mesure l'acceleration des methodes paralleles, avec autant de
+     * fils que de coeurs par defaut */
+    if (argc > 1 && !strcmp(argv[1], "--parallele"))
+        return Parallele(argc > 2 ? atoi(argv[2])
+                                  : (int)sysconf(_SC_NPROCESSORS_ONLN));
+    /* Mode qui execute un fichier de travaux */
+    if (argc > 2 && !strcmp(argv[1], "--lot"))
+        return Lot(argv[2], argc > 3 ? argv[3] : NULL,
+                   (int)sysconf(_SC_NPROCESSORS_ONLN));
+
+    /* Mode qui mesure le cout des variantes des methodes pour une fonction */
+    if (argc > 1 && !strcmp(argv[1], "--couts")) {
+        char* fin;
+        const long nf = argc > 2 ? strtol(argv[2], &fin, 10) : 0;
+        if (argc != 5 || *fin != '\0' || nf < 1 || nf > N_FONCTIONS_TEST ||
+            !lire_reel(argv[3], &binf) || !lire_reel(argv[4], &bsup)) {
+            printf("Utilisation : %s --couts numero borneInf borneSup, avec "
+                   "un numero de 1 a %d\n",
+                   argv[0], N_FONCTIONS_TEST);
+            return 1;
+        }
+        return Couts(&fonctionsTest[nf - 1], binf, bsup);
     }
-    approximer_integrale(9, borneInf, borneSup, Newton_Cotes10, fonction,
-                         integraleExacte, "Secrete");
-    printf("\n");
-}
+    /* Mode qui compare les methodes pour les integrandes oscillantes */
+    if (argc > 1 && !strcmp(argv[1], "--oscillante")) return Oscillante();
+    /* Mode qui integre toutes les fonctions du tableau en une passe */
+    if (argc > 1 && !strcmp(argv[1], "--vectorielle")) {
+        if (argc != 4 || !lire_reel(argv[2], &binf) ||
+            !lire_reel(argv[3], &bsup)) {
+            printf("Utilisation : %s --vectorielle borneInf borneSup\n",
+                   argv[0]);
+            return 1;
+        }
+        return Vectorielle(binf, bsup);
+    }
+    /* Mode qui integre une expression de x donnee en argument */
+    if (argc > 4 && !strcmp(argv[1], "--expression"))
+        return Expression(argv[2], atof(argv[3]), atof(argv[4]));
 
-int main() {
     /* Numero de fonction */
     int nf;
 
-    /* Bornes d'integrations */
-    double binf, bsup;
-
     /* Reponse de l'utilisateur */
     char rep;
 
@@ -230,38 +4111,8 @@ int main() {
         printf("Entrez le numero de fonction et les bornes: ");
         scanf("%d%lf%lf", &nf, &binf, &bsup);
 
-        switch (nf) {
-        case 1:
-            integration(binf, bsup, integrale_exp, exp, "exp");
-            break;
-        case 2:
-            integration(binf, bsup, integrale_sin, sin, "sin");
-            break;
-        case 3:
-            integration(binf, bsup, integrale_cos, cos, "cos");
-            break;
-        case 4:
-            integration(binf, bsup, integrale_tan, tan, "tan");
-            break;
-        case 5:
-            integration(binf, bsup, integrale_asin, asin, "asin");
-            break;
-        case 6:
-            integration(binf, bsup, integrale_acos, acos, "acos");
-            break;
-        case 7:
-            integration(binf, bsup, integrale_atan, atan, "atan");
-            break;
-        case 8:
-            integration(binf, bsup, integrale_sinh, sinh, "sinh");
-            break;
-        case 9:
-            integration(binf, bsup, integrale_cosh, cosh, "cosh");
-            break;
-        case 10:
-            integration(binf, bsup, integrale_tanh, tanh, "tanh");
-            break;
-        }
+        if (nf >= 1 && nf <= N_FONCTIONS_TEST)
+            integration(binf, bsup, &fonctionsTest[nf - 1]);
         printf(
             "Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre "
             "touche pour quitter.\n");
@@ -284,6 +4135,21 @@ Simpson            20    1.71828188810386    0.000003%
 Point milieu       30    1.71820228095233    0.004629%
 Simpson            30    1.71828184024268    0.000001%
 Secrete             9    1.71828182845967    0.000000%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    1.71828182845905     8.882e-16
+Gauss-Legendre      5         2          10    1.71828182845904     4.441e-16
+Gauss-Legendre     10         1          10    1.71828182845905     0.000e+00
+Gauss-Legendre      8         4          32    1.71828182845905     0.000e+00
+Gauss-Legendre     64         1          64    1.71828182845905     2.220e-16
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod              15    1.71828182845905     0.000e+00
+Simpson uniforme          513    1.71828182845918     1.399e-13
+Tanh-sinh                 115    1.71828182845905     0.000e+00
 
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
 quitter.
@@ -300,6 +4166,21 @@ Simpson            20    1.98999810848141    0.000282%
 Point milieu       30    1.99082190204383    0.041679%
 Simpson            30    1.98999360346935    0.000056%
 Secrete             9    1.98999243312620    0.000003%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    1.98999249655336     4.708e-11
+Gauss-Legendre      5         2          10    1.98999249664968     4.923e-11
+Gauss-Legendre     10         1          10    1.98999249660045     2.220e-16
+Gauss-Legendre      8         4          32    1.98999249660045     2.220e-16
+Gauss-Legendre     64         1          64    1.98999249660045     2.220e-16
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod              15    1.98999249660045     2.220e-16
+Simpson uniforme         1025    1.98999249660126     8.147e-13
+Tanh-sinh                 115    1.98999249660045     2.220e-16
 
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
 quitter.
@@ -316,6 +4197,21 @@ Simpson            20    0.14112040602553    0.000282%
 Point milieu       30    0.14117882521775    0.041679%
 Simpson            30    0.14112008655330    0.000056%
 Secrete             9    0.14112000355860    0.000003%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    0.14112000805653     3.339e-12
+Gauss-Legendre      5         2          10    0.14112000806336     3.491e-12
+Gauss-Legendre     10         1          10    0.14112000805987     8.327e-17
+Gauss-Legendre      8         4          32    0.14112000805987     2.776e-17
+Gauss-Legendre     64         1          64    0.14112000805987     8.327e-17
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod              15    0.14112000805987     2.776e-17
+Simpson uniforme          513    0.14112000806079     9.240e-13
+Tanh-sinh                 115    0.14112000805987     3.886e-16
 
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
 quitter.
@@ -332,6 +4228,21 @@ Simpson            20    0.13058424677436    0.000005%
 Point milieu       30    0.13058078647682    0.002645%
 Simpson            30    0.13058424169537    0.000001%
 Secrete             9    0.13058424047760    0.000000%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    0.13058424044377     5.182e-14
+Gauss-Legendre      5         2          10    0.13058424044367     5.390e-14
+Gauss-Legendre     10         1          10    0.13058424044372     5.551e-17
+Gauss-Legendre      8         4          32    0.13058424044372     8.327e-17
+Gauss-Legendre     64         1          64    0.13058424044372     2.776e-17
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod              15    0.13058424044372     5.551e-17
+Simpson uniforme          257    0.13058424044396     2.363e-13
+Tanh-sinh                  58    0.13058424044372     8.327e-17
 
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
 quitter.
@@ -348,6 +4259,21 @@ Simpson            20    0.12782479608051    0.000004%
 Point milieu       30    0.12782300126300    0.001401%
 Simpson            30    0.12782479247354    0.000001%
 Secrete             9    0.12782479175483    0.000000%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    0.12782479158401     4.179e-13
+Gauss-Legendre      5         2          10    0.12782479158315     4.339e-13
+Gauss-Legendre     10         1          10    0.12782479158359     1.110e-16
+Gauss-Legendre      8         4          32    0.12782479158359     1.388e-16
+Gauss-Legendre     64         1          64    0.12782479158359     1.388e-16
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod              15    0.12782479158359     1.110e-16
+Simpson uniforme          257    0.12782479158376     1.682e-13
+Tanh-sinh                  58    0.12782479158359     1.388e-16
 
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
 quitter.
@@ -364,6 +4290,21 @@ Simpson            20    0.65757336731694    0.000001%
 Point milieu       30    0.65757516213445    0.000272%
 Simpson            30    0.65757337092391    0.000000%
 Secrete             9    0.65757337164262    0.000000%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    0.65757337181344     4.179e-13
+Gauss-Legendre      5         2          10    0.65757337181429     4.340e-13
+Gauss-Legendre     10         1          10    0.65757337181386     1.110e-16
+Gauss-Legendre      8         4          32    0.65757337181386     1.110e-16
+Gauss-Legendre     64         1          64    0.65757337181386     1.110e-16
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod              15    0.65757337181386     2.220e-16
+Simpson uniforme          257    0.65757337181369     1.682e-13
+Tanh-sinh                  58    0.65757337181386     0.000e+00
 
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
 quitter.
@@ -380,6 +4321,21 @@ Simpson            20    0.43882466020391    0.000020%
 Point milieu       30    0.43884772501767    0.005276%
 Simpson            30    0.43882459028882    0.000004%
 Secrete             9    0.43882460336896    0.000007%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    0.43882457308711     3.036e-11
+Gauss-Legendre      5         2          10    0.43882457314936     3.188e-11
+Gauss-Legendre     10         1          10    0.43882457311747     3.164e-15
+Gauss-Legendre      8         4          32    0.43882457311748     0.000e+00
+Gauss-Legendre     64         1          64    0.43882457311748     0.000e+00
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod              45    0.43882457311748     5.551e-17
+Simpson uniforme          513    0.43882457311768     2.020e-13
+Tanh-sinh                 115    0.43882457311748     0.000e+00
 
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
 quitter.
@@ -394,8 +4350,23 @@ Simpson            10    9.06806570959703    0.004452%
 Point milieu       20    9.05916663808717    0.093689%
 Simpson            20    9.06768743042707    0.000280%
 Point milieu       30    9.06388490496193    0.041655%
-Simpson            30    9.06766702737693    0.000055%
+Simpson            30    9.06766702737692    0.000055%
 Secrete             9    9.06766214543104    0.000002%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    9.06766199596007     1.823e-10
+Gauss-Legendre      5         2          10    9.06766199558743     1.903e-10
+Gauss-Legendre     10         1          10    9.06766199577777     0.000e+00
+Gauss-Legendre      8         4          32    9.06766199577777     0.000e+00
+Gauss-Legendre     64         1          64    9.06766199577777     1.776e-15
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod              45    9.06766199577777     0.000e+00
+Simpson uniforme         2049    9.06766199577799     2.292e-13
+Tanh-sinh                 115    9.06766199577777     0.000e+00
 
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
 quitter.
@@ -406,12 +4377,27 @@ Valeur exacte pour cosh:   10.01787492740990
 Methode   Intervalles   Valeur approximee       Erreur
 
 Point milieu       10    9.98040627647094    0.374018%
-Simpson            10   10.01832094696265    0.004452%
+Simpson            10   10.01832094696266    0.004452%
 Point milieu       20   10.00848932935302    0.093689%
 Simpson            20   10.01790302739154    0.000280%
 Point milieu       30   10.01370202998605    0.041655%
 Simpson            30   10.01788048627734    0.000055%
 Secrete             9   10.01787509274555    0.000002%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19   10.01787492761131     2.014e-10
+Gauss-Legendre      5         2          10   10.01787492719962     2.103e-10
+Gauss-Legendre     10         1          10   10.01787492740990     0.000e+00
+Gauss-Legendre      8         4          32   10.01787492740990     0.000e+00
+Gauss-Legendre     64         1          64   10.01787492740990     0.000e+00
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod              45   10.01787492740990     0.000e+00
+Simpson uniforme         2049   10.01787492741016     2.576e-13
+Tanh-sinh                 115   10.01787492740990     3.553e-15
 
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
 quitter.
@@ -428,8 +4414,277 @@ Simpson            20    1.32500400922744    0.000095%
 Point milieu       30    1.32517490317650    0.012993%
 Simpson            30    1.32500299546578    0.000019%
 Secrete             9    1.32500544984948    0.000204%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    1.32500274777875     4.209e-10
+Gauss-Legendre      5         2          10    1.32500274681454     5.433e-10
+Gauss-Legendre     10         1          10    1.32500274736362     5.755e-12
+Gauss-Legendre      8         4          32    1.32500274735786     0.000e+00
+Gauss-Legendre     64         1          64    1.32500274735786     0.000e+00
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod              75    1.32500274735786     0.000e+00
+Simpson uniforme         1025    1.32500274735805     1.816e-13
+Tanh-sinh                 115    1.32500274735786     0.000e+00
+
+Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
+quitter.
+o
+
+Entrez le numero de fonction et les bornes: 4 0 1.5
+Valeur exacte pour tan:    2.64878365397843
+Methode   Intervalles   Valeur approximee       Erreur
+
+Point milieu       10    2.52286166289473    4.753955%
+Simpson            10    2.74051404975435    3.463114%
+Point milieu       20    2.60850815101946    1.520528%
+Simpson            20    2.66394860948209    0.572525%
+Point milieu       30    2.62955371865141    0.725991%
+Simpson            30    2.65321847421616    0.167429%
+Secrete             9    2.71998015367732    2.687894%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    2.65798288252999     9.199e-03
+Gauss-Legendre      5         2          10    2.64139648499169     7.387e-03
+Gauss-Legendre     10         1          10    2.64809215384913     6.915e-04
+Gauss-Legendre      8         4          32    2.64878010535133     3.549e-06
+Gauss-Legendre     64         1          64    2.64878365397843     0.000e+00
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod             225    2.64878365397843     0.000e+00
+Simpson uniforme        16385    2.64878365397853     9.326e-14
+Tanh-sinh                 115    2.64878365397843     1.776e-15
+
+Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
+quitter.
+o
+
+Entrez le numero de fonction et les bornes: 5 0 1
+Valeur exacte pour asin:    0.57079632679490
+Methode   Intervalles   Valeur approximee       Erreur
+
+Point milieu       10    0.56848377723111    0.405144%
+Simpson            10    0.57442139878796    0.635090%
+Point milieu       20    0.56993667456462    0.150606%
+Simpson            20    0.57207902213523    0.224720%
+Point milieu       30    0.57031818451325    0.083768%
+Simpson            30    0.57149471318301    0.122353%
+Secrete             9    0.57404038188784    0.568338%
+Evaluations de la fonction: 87 avec la grille commune, 133 sans
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur abs.
+
+Secrete            10         2          19    0.57194387171876     1.148e-03
+Gauss-Legendre      5         2          10    0.57048162786215     3.147e-04
+Gauss-Legendre     10         1          10    0.57067000684612     1.263e-04
+Gauss-Legendre      8         4          32    0.57076647386165     2.985e-05
+Gauss-Legendre     64         1          64    0.57079578412528     5.427e-07
+
+Tolerance 1e-12   Evaluations   Valeur approximee   Erreur abs.
+
+Gauss-Kronrod             615    0.57079632679488     1.743e-14
+Simpson uniforme      8388609    0.57079632679962     4.726e-12
+Tanh-sinh                  58    0.57079632679490     1.110e-16
 
 Voulez-vous continuer? Taper 'o' si oui, n'importe quelle autre touche pour
 quitter.
 n
+
+--parallele 4
+Integrale de exp entre 0 et 1, 9000000 intervalles
+Methode      Fils       Valeur approximee  Temps (ms)  Accel.
+Point milieu    1     1.71828182845904442      11.05     1.00x
+Point milieu    2     1.71828182845904442      11.72     0.94x
+Point milieu    3     1.71828182845904442      11.82     0.93x
+Point milieu    4     1.71828182845904442      11.76     0.94x
+Simpson         1     1.71828182845904509      11.25     1.00x
+Simpson         2     1.71828182845904509      11.47     0.98x
+Simpson         3     1.71828182845904509      11.03     1.02x
+Simpson         4     1.71828182845904509      10.91     1.03x
+Secrete         1     1.71828182845904553      10.97     1.00x
+Secrete         2     1.71828182845904553      11.23     0.98x
+Secrete         3     1.71828182845904553      11.84     0.93x
+Secrete         4     1.71828182845904553      12.81     0.86x
+
+--lot travaux.txt
+fonction,borne_inf,borne_sup,methode,tolerance,valeur,erreur_estimee,erreur_reelle,evaluations,temps_s
+exp,0,1,gauss-kronrod,1e-12,1.7182818284590451,0.000e+00,0.000e+00,15,0.000006
+exp,0,1,simpson,1e-12,1.718281828459185,1.388e-13,1.399e-13,513,0.000028
+exp,0,1,tanh-sinh,1e-12,1.7182818284590451,2.220e-16,0.000e+00,115,0.000007
+tan,0,1.5,gauss-kronrod,1e-12,2.6487836539784348,8.254e-13,0.000e+00,225,0.000020
+tan,0,1.5,tanh-sinh,1e-12,2.6487836539784331,1.421e-14,1.776e-15,115,0.000003
+asin,0,1,gauss-kronrod,1e-12,0.57079632679487913,4.506e-13,1.743e-14,615,0.000021
+asin,0,1,simpson,1e-10,0.57079632709733263,3.687e-11,3.024e-10,524289,0.011437
+asin,0,1,tanh-sinh,1e-12,0.57079632679489667,2.739e-13,1.110e-16,58,0.000009
+acos,-1,1,tanh-sinh,1e-12,3.1415926535897931,1.150e-13,0.000e+00,51,0.000005
+atan,0,1,gauss-kronrod,1e-08,0.43882457311747564,1.525e-11,0.000e+00,15,0.000003
+sinh,0,3,simpson,1e-08,9.0676619967278054,9.500e-10,9.500e-10,257,0.000018
+cosh,0,3,tanh-sinh,1e-12,10.017874927409899,3.553e-15,3.553e-15,115,0.000003
+tanh,0,2,gauss-kronrod,1e-12,1.3250027473578645,9.646e-14,0.000e+00,75,0.000004
+sin,0,3,tanh-sinh,1e-14,1.9899924966004456,0.000e+00,2.220e-16,115,0.000003
+
+--expression "exp(-x*x)*cos(3*x)" 0 2
+Ruban de exp(-x*x)*cos(3*x): 8 instructions, 3 registres
+    r0  = 3
+    r1  = x
+    r2  = -r1
+    r2  = r1 * r2
+    r2  = exp(r2)
+    r1  = r1 * r0
+    r1  = cos(r1)
+    r1  = r2 * r1
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur est.
+
+Simpson             2     15000       30001    0.09000923515627     0.000e+00
+Gauss-Legendre     20         8         160    0.09000923515627     1.388e-17
+Tanh-sinh           -         -         115    0.09000923515627     2.649e-14
+
+Cout par noeud: 9.78 ns par blocs, 59.94 ns noeud par noeud (6.1x)
+Ecart maximal avec math.h sur les noeuds de Simpson: 2.220e-16
+
+--expression "1/sqrt(1-x)" 0 1
+Ruban de 1/sqrt(1-x): 5 instructions, 2 registres
+    r0  = 1
+    r1  = x
+    r1  = r0 - r1
+    r1  = sqrt(r1)
+    r1  = r0 / r1
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur est.
+
+Simpson             2     15000       30001                 inf           nan
+Gauss-Legendre     20         8         160    1.98498301217395     6.220e-03
+Tanh-sinh           -         -        7345    1.99999998445656     6.775e-11
+
+Cout par noeud: 4.42 ns par blocs, 44.29 ns noeud par noeud (10.0x)
+Ecart maximal avec math.h sur les noeuds de Simpson: 0.000e+00
+
+--expression "1/sqrt(x)" 0 1
+Ruban de 1/sqrt(x): 4 instructions, 2 registres
+    r0  = 1
+    r1  = x
+    r1  = sqrt(r1)
+    r1  = r0 / r1
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur est.
+
+Simpson             2     15000       30001                 inf           nan
+Gauss-Legendre     20         8         160    1.98498301217395     6.220e-03
+Tanh-sinh           -         -          58    2.00000000000000     3.109e-15
+
+Cout par noeud: 3.88 ns par blocs, 32.46 ns noeud par noeud (8.4x)
+Ecart maximal avec math.h sur les noeuds de Simpson: 0.000e+00
+
+--expression "sin(1e9*x)" 0 1
+Ruban de sin(1e9*x): 4 instructions, 2 registres
+    r0  = 1000000000
+    r1  = x
+    r1  = r0 * r1
+    r1  = sin(r1)
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur est.
+
+Simpson             2     15000       30001    0.00000525771905     6.562e-08
+Gauss-Legendre     20         8         160   -0.00731325053336     1.191e-02
+Tanh-sinh           -         -        7345   -0.00440471649266     2.076e-05
+
+Cout par noeud: 65.43 ns par blocs, 118.60 ns noeud par noeud (1.8x)
+Ecart maximal avec math.h sur les noeuds de Simpson: 1.110e-16
+
+--expression "tanh(x)" 0 800
+Ruban de tanh(x): 2 instructions, 1 registres
+    r0  = x
+    r0  = tanh(r0)
+
+Methode         Ordre  Panneaux  Evaluations   Valeur approximee   Erreur est.
+
+Simpson             2     15000       30001  799.30685282506261     5.635e-09
+Gauss-Legendre     20         8         160  799.30185207402042     1.923e-02
+Tanh-sinh           -         -         459  799.30685281944011     1.137e-13
+
+Cout par noeud: 7.87 ns par blocs, 22.38 ns noeud par noeud (2.8x)
+Ecart maximal avec math.h sur les noeuds de Simpson: 2.220e-16
+
+--vectorielle 0 0.5
+Integrales entre 0 et 0.5 en une passe: Simpson a 30000 intervalles,
+Gauss-Legendre d'ordre 20 a 8 panneaux
+
+Fonction   Simpson               Erreur abs.  Gauss-Legendre        Erreur abs.
+
+exp         0.64872127070013     2.220e-16    0.64872127070013     0.000e+00
+sin         0.12241743810963     9.714e-17    0.12241743810963     5.551e-17
+cos         0.47942553860420     5.551e-17    0.47942553860420     0.000e+00
+tan         0.13058424044372     5.551e-17    0.13058424044372     5.551e-17
+asin        0.12782479158359     1.388e-16    0.12782479158359     1.110e-16
+acos        0.65757337181386     1.110e-16    0.65757337181386     2.220e-16
+atan        0.12025202884330     2.776e-17    0.12025202884330     1.388e-17
+sinh        0.12762596520638     1.110e-16    0.12762596520638     5.551e-17
+cosh        0.52109530549375     1.110e-16    0.52109530549375     1.110e-16
+tanh        0.12011450695828     8.327e-17    0.12011450695828     5.551e-17
+
+Simpson: 1.886 ms en 10 appels, 2.515 ms en une passe (0.75x)
+Moments: 0.285 ms en 10 appels, 0.256 ms en une passe (1.11x)
+
+--oscillante
+Integrale de e^x sin(kx) entre 0 et 1, tolerance de Simpson 1e-08
+
+k = 1        Evaluations   Valeur approximee   Erreur abs.  Temps (ms)
+Simpson           132    0.90933067242713     1.204e-09      0.0022
+Filon              67    0.90933067575790     2.126e-09      0.0003
+Levin              12    0.90933067363148     4.441e-16      0.0026
+
+k = 10       Evaluations   Valeur approximee   Erreur abs.  Temps (ms)
+Simpson           501    0.31019333342817     4.689e-09      0.0028
+Filon              67    0.31019332647962     2.259e-09      0.0003
+Levin              12    0.31019332873891     1.110e-16      0.0026
+
+k = 100      Evaluations   Valeur approximee   Erreur abs.  Temps (ms)
+Simpson          1924   -0.01357655059411     6.588e-09      0.0062
+Filon              67   -0.01357654639408     2.388e-09      0.0003
+Levin              12   -0.01357654400645     5.204e-18      0.0033
+
+k = 1000     Evaluations   Valeur approximee   Erreur abs.  Temps (ms)
+Simpson         15364   -0.00052645726740     6.617e-10      0.0456
+Filon              67   -0.00052645638602     2.197e-10      0.0004
+Levin              12   -0.00052645660570     5.421e-19      0.0035
+
+k = 10000    Evaluations   Valeur approximee   Erreur abs.  Temps (ms)
+Simpson        114691    0.00035881543623     1.084e-09      0.3323
+Filon              67    0.00035881435313     6.337e-13      0.0004
+Levin              12    0.00035881435249     1.084e-19      0.0035
+
+k = 100000   Evaluations   Valeur approximee   Erreur abs.  Temps (ms)
+Simpson        393218    0.00003716990213     4.449e-09      1.1295
+Filon              67    0.00003716545294     6.230e-16      0.0005
+Levin              12    0.00003716545294     6.776e-21      0.0038
+
+k = 1000000  Evaluations   Valeur approximee   Erreur abs.  Temps (ms)
+Simpson       3145730   -0.00000154681369     4.565e-10      9.0454
+Filon              67   -0.00000154635724     7.785e-17      0.0004
+Levin              12   -0.00000154635724     4.235e-22      0.0036
+
+--couts 1 0 1
+Couts pour exp entre 0 et 1
+
+Double-double  Intervalles  Ecart double/dd   Cout dd
+
+Simpson          3000           6.661e-16         1.9x
+Secrete           900           0.000e+00         1.4x
+
+Newton-Cotes  Intervalles  Ecart if/general  Acceleration
+
+Simpson         30006           1.592e-14         1.1x
+Secrete         30006           2.111e-15         1.7x
+
+Par lots      Intervalles  Ecart math.h/lots  Acceleration
+
+Simpson         30000           0.000e+00         5.4x
+Secrete         29997           0.000e+00         4.0x
 */
\ No newline at end of file
@@ -5,10 +5,20 @@
  * le mme tuplet et sans rpter les tuplets en changeant seulement l'ordre
  * d'apparition des entiers  l'intrieur.
  *
+ * Compil avec -DCOMPTER_OPERATIONS ou -DCOMPTEURS_MATERIELS, le programme
+ * affiche aussi les oprations et les compteurs du processeur de chaque
+ * recherche de tuplets (voir compteurs.h). Avec l'argument --banc, il mesure
+ * plutt la recherche des 5-tuplets de somme 40 forms des entiers de 1  15
+ * avec le banc d'essai de banc.h (voir ce fichier pour les options).
+ *
  * @author: Nicolas Levasseur
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "../banc.h"
+#include "../compteurs.h"
 
 /* Nom du fichier contenant les paramtres pour trouver les tuplets */
 #define NOM_FICHIER_LU "dontuplets.txt"
@@ -74,6 +84,13 @@ void former_tuplet(const int n, const int somme, const int tupletPrec[],
     int sommePartielle = 0;
 
     for (int i = 0; i < n - 1; i++) {
+        /* 3 affectations pour l'lment, sommePartielle += et i++, 3
+         * additions pour +=, i++ et n - 1, 3 comparaisons pour < et les deux
+         * tests sur posTransition (on compte le pire cas) */
+        COMPTER(AFFECTATIONS, 3);
+        COMPTER(ADDITIONS, 3);
+        COMPTER(COMPARAISONS, 3);
+
         /* On dtermine la valeur du ime lment dans le tuplet courant */
         if (i < posTransition)
             tupletCour[i] = tupletPrec[i];
@@ -167,9 +184,18 @@ void trouver_tuplets(FILE* fichier, const int max, const int nElement,
     do {
         former_tuplet(nElement, somme, tupletPrec, tupletCour, posTransition);
 
-        /* On met  jour le tuplet prcdent */
+        /* On met  jour le tuplet prcdent (2 affectations, 1 addition et 1
+         * comparaison par lment) */
+        COMPTER(AFFECTATIONS, 2 * nElement);
+        COMPTER(ADDITIONS, nElement);
+        COMPTER(COMPARAISONS, nElement);
         for (int i = 0; i < nElement; i++) tupletPrec[i] = tupletCour[i];
 
+        /* 3 comparaisons pour les deux tests sur le dernier lment et le
+         * while, 1 affectation pour la position de transition */
+        COMPTER(COMPARAISONS, 3);
+        COMPTER(AFFECTATIONS, 1);
+
         /* On teste la position de transition et on change sa valeur */
         if (tupletCour[nElement - 1] <= tupletCour[nElement - 2])
             posTransition--;
@@ -188,7 +214,44 @@ void trouver_tuplets(FILE* fichier, const int max, const int nElement,
     free(tupletCour);
 }
 
-int main() {
+/**
+ * Paramtres d'une recherche de tuplets mesure par le banc d'essai.
+ */
+struct banc_tuplets {
+    /* Fichier temporaire o on crit les tuplets */
+    FILE* fichier;
+    int max, nElement, somme;
+};
+
+/**
+ * Noyau du banc d'essai: trouve les tuplets et les crit au dbut du fichier
+ * temporaire (l'criture fait partie du cot mesur).
+ *
+ * @param donnees: Pointeur vers une struct banc_tuplets.
+ */
+void banc_tuplets(void* donnees) {
+    struct banc_tuplets* banc = donnees;
+    rewind(banc->fichier);
+    trouver_tuplets(banc->fichier, banc->max, banc->nElement, banc->somme);
+}
+
+int main(int argc, char* argv[]) {
+    /* On mesure les noyaux du banc d'essai si demand */
+    static struct banc_tuplets banc = {NULL, 15, 5, 40};
+    banc_enregistrer("tuplets (15, 5, 40)", banc_tuplets, &banc);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--banc")) continue;
+        banc.fichier = tmpfile();
+        if (banc.fichier == NULL) {
+            printf("Incapable d'ouvrir un fichier temporaire!!!\n");
+            return 1;
+        }
+    }
+    if (banc_lancer(argc, argv)) {
+        fclose(banc.fichier);
+        return 0;
+    }
+
     /* Fichier o on va lire les paramtres */
     FILE* fichierLu = fopen(NOM_FICHIER_LU, "r");
     /* chec de l'ouverture */
@@ -220,7 +283,9 @@ int main() {
             "Suite des tuplets formes de %d entiers dont la somme est %d \n"
             "et dont chaque entier est <= %d\n\n",
             nElement, somme, max);
+        MESURE_DEBUTER(mesure);
         trouver_tuplets(fichierEcrit, max, nElement, somme);
+        MESURE_TERMINER(mesure, "recherche des tuplets");
         fprintf(fichierEcrit, "\n");
     }
 
@@ -2,11 +2,20 @@
  * Programme qui tente de trouver des parcours de cavalier  partir d'une
  * position de dpart quelconque sur un chiquier.
  *
+ * Compil avec -DCOMPTER_OPERATIONS ou -DCOMPTEURS_MATERIELS, le programme
+ * affiche aussi les oprations et les compteurs du processeur de chaque
+ * recherche de parcours (voir compteurs.h). Avec l'argument --banc, il mesure
+ * plutt la recherche d'un parcours depuis chaque case de la premire range
+ * avec le banc d'essai de banc.h (voir ce fichier pour les options).
+ *
  * @author Nicolas Levasseur
  */
 #include <stdbool.h>
 #include <stdio.h>
 
+#include "../banc.h"
+#include "../compteurs.h"
+
 /* Nom du fichier contenant les positions de dpart du cavalier */
 #define NOM_FICHIER_LU "positions.txt"
 /* Nom du fichier o on va crire le parcours du cavalier */
@@ -93,13 +102,27 @@ bool essai(int echiquier[][X_MAX], const int x, const int y, const int dx[],
     int yCandidat;
 
     do {
+        /* 3 affectations pour les deux positions candidates et
+         * iProchainCoup++, 3 additions pour les deux positions et
+         * iProchainCoup++, 2 comparaisons pour le while (le test de la case
+         * candidate est compt plus bas) */
+        COMPTER(AFFECTATIONS, 3);
+        COMPTER(ADDITIONS, 3);
+        COMPTER(COMPARAISONS, 2);
+
         /* Calcul de la position de la case candidate */
         xCandidat = x + dx[iProchainCoup];
         yCandidat = y + dy[iProchainCoup];
 
-        /* On teste la position candidate */
+        /* On teste la position candidate (5 comparaisons, on compte le pire
+         * cas) */
+        COMPTER(COMPARAISONS, 5);
         if (xCandidat >= 0 && xCandidat < X_MAX && yCandidat >= 0 &&
             yCandidat < Y_MAX && !echiquier[yCandidat][xCandidat]) {
+            /* 2 affectations pour la case et succes, 1 comparaison pour le
+             * numro du coup */
+            COMPTER(AFFECTATIONS, 2);
+            COMPTER(COMPARAISONS, 1);
             echiquier[yCandidat][xCandidat] = numCoup;
             if (numCoup < X_MAX * Y_MAX) {
                 succes = essai(echiquier, xCandidat, yCandidat, dx, dy,
@@ -168,7 +191,38 @@ void ecrit_parcours(FILE* fichier, const int echiquier[][X_MAX],
     fprintf(fichier, "\n\n");
 }
 
-int main() {
+/**
+ * Recherche d'un parcours mesure par le banc d'essai.
+ */
+struct banc_parcours {
+    /* Position initiale du cavalier */
+    int xInit, yInit;
+    /* chiquier rempli par le parcours, rsultat du noyau */
+    int echiquier[Y_MAX][X_MAX];
+};
+
+/**
+ * Noyau du banc d'essai: vide l'chiquier et cherche un parcours.
+ *
+ * @param donnees: Pointeur vers une struct banc_parcours.
+ */
+void banc_parcours(void* donnees) {
+    struct banc_parcours* banc = donnees;
+    init_echiquier(banc->echiquier, banc->xInit, banc->yInit);
+    trouve_parcours(banc->echiquier, banc->xInit, banc->yInit);
+}
+
+int main(int argc, char* argv[]) {
+    /* Noyaux du banc d'essai, un par case de la premire range */
+    static struct banc_parcours bancs[X_MAX];
+    static char noms[X_MAX][sizeof "parcours depuis a1"];
+    for (int x = 0; x < X_MAX; x++) {
+        bancs[x].xInit = x;
+        sprintf(noms[x], "parcours depuis %c1", 'a' + x);
+        banc_enregistrer(noms[x], banc_parcours, &bancs[x]);
+    }
+    if (banc_lancer(argc, argv)) return 0;
+
     /* Fichier dans lequel on a stock les positions initiales du cavalier 
      * tudier */
     FILE* fichierLu = fopen(NOM_FICHIER_LU, "r");
@@ -196,7 +250,9 @@ int main() {
 
     while (!trouve_pos_init(fichierLu, &xInit, &yInit)) {
         init_echiquier(echiquier, xInit, yInit);
+        MESURE_DEBUTER(mesure);
         trouve_parcours(echiquier, xInit, yInit);
+        MESURE_TERMINER(mesure, "parcours du cavalier");
         ecrit_parcours(fichierEcrit, echiquier, xInit, yInit);
     }
 
@@ -2,12 +2,21 @@
  * Ce programme produit des configurations de bataille navale de manire
  * pseudo-alatoire en respectant certaines rgles.
  *
+ * Compil avec -DCOMPTER_OPERATIONS ou -DCOMPTEURS_MATERIELS, le programme
+ * affiche aussi les oprations et les compteurs du processeur de chaque
+ * placement des navires (voir compteurs.h). Avec l'argument --banc, il mesure
+ * plutt le placement des navires pour chaque zone sche avec le banc d'essai
+ * de banc.h (voir ce fichier pour les options).
+ *
  * @author Nicolas Levasseur
  */
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "../banc.h"
+#include "../compteurs.h"
+
 /* Nom du fichier o on va crire les positions de dpart */
 #define NOM_FICHIER "navale.txt"
 /* Nombre de colonnes de la grille de jeu */
@@ -245,6 +254,10 @@ void place_navires(char grille[][X_MAX], int zoneSec) {
         while (!posValide) {
             /* On cherche une position du dbut du navire valide */
             do {
+                /* 2 affectations, 2 modulos et 1 comparaison par essai */
+                COMPTER(AFFECTATIONS, 2);
+                COMPTER(MULTIPLICATIONS, 2);
+                COMPTER(COMPARAISONS, 1);
                 posDebutX = rand() % 10;
                 posDebutY = rand() % 10;
             } while (grille[posDebutY][posDebutX] != '-');
@@ -255,6 +268,13 @@ void place_navires(char grille[][X_MAX], int zoneSec) {
             /* On cherche l'orientation du navire */
             orientation = rand() % NBR_ORIENTATIONS;
             for (int i = 0; i < NBR_ORIENTATIONS; i++) {
+                /* 2 comparaisons pour < et le test de l'orientation, 2
+                 * affectations pour i++ et l'orientation suivante, 2
+                 * additions pour i++ et + 1, 1 modulo */
+                COMPTER(COMPARAISONS, 2);
+                COMPTER(AFFECTATIONS, 2);
+                COMPTER(ADDITIONS, 2);
+                COMPTER(MULTIPLICATIONS, 1);
                 if (valide_orientation(grille, posDebutX, posDebutY,
                                        orientation, longueur, nom, zoneSec)) {
                     posValide = true;
@@ -297,7 +317,38 @@ void montre_grille(FILE* fichier, char grille[][X_MAX]) {
     fprintf(fichier, "\n");
 }
 
-int main() {
+/**
+ * Placement des navires mesur par le banc d'essai.
+ */
+struct banc_navires {
+    /* Largeur de la zone sche autour des navires */
+    int zoneSec;
+    /* Grille remplie par le placement, rsultat du noyau */
+    char grille[Y_MAX][X_MAX];
+};
+
+/**
+ * Noyau du banc d'essai: vide la grille et place les navires. Le germe est
+ * remis  la mme valeur  chaque appel pour que tous les appels fassent le
+ * mme travail.
+ *
+ * @param donnees: Pointeur vers une struct banc_navires.
+ */
+void banc_navires(void* donnees) {
+    struct banc_navires* banc = donnees;
+    srand(1969);
+    init_grille(banc->grille);
+    place_navires(banc->grille, banc->zoneSec);
+}
+
+int main(int argc, char* argv[]) {
+    /* Noyaux du banc d'essai, un par zone sche du programme */
+    static struct banc_navires bancs[] = {{1, {{0}}}, {2, {{0}}}, {3, {{0}}}};
+    banc_enregistrer("navires (zone seche 1)", banc_navires, &bancs[0]);
+    banc_enregistrer("navires (zone seche 2)", banc_navires, &bancs[1]);
+    banc_enregistrer("navires (zone seche 3)", banc_navires, &bancs[2]);
+    if (banc_lancer(argc, argv)) return 0;
+
     /* Fichier dans lequel on va montrer le parcours du cavalier tudi */
     FILE* fichier = fopen(NOM_FICHIER, "w");
     /* chec de l'ouverture */
@@ -315,7 +366,9 @@ int main() {
     /* On trouve les configurations demandes */
     for (int i = 0; i < 6; i++) {
         init_grille(grille);
+        MESURE_DEBUTER(mesure);
         place_navires(grille, i / 2 + 1);
+        MESURE_TERMINER(mesure, "placement des navires");
         montre_grille(fichier, grille);
     }
 
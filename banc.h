@@ -0,0 +1,273 @@
+/**
+ * Auteur : Nicolas Levasseur
+ *
+ * Banc d'essai commun aux programmes des TP. Chaque programme enregistre ses
+ * noyaux de calcul avec banc_enregistrer, puis appelle banc_lancer au debut de
+ * main: si l'argument --banc est donne, les noyaux enregistres sont mesures et
+ * le programme s'arrete la. Pour chaque noyau:
+ *  - on l'appelle d'abord quelques fois sans mesurer (echauffement), ce qui
+ *   remplit les caches et donne le nombre d'appels a regrouper dans un
+ *   echantillon pour qu'il dure au moins BANC_DUREE_ECHANTILLON secondes (la
+ *   resolution de l'horloge devient alors negligeable);
+ *  - on prend ensuite le nombre d'echantillons demande avec une horloge
+ *   monotone et on rapporte le temps d'un appel minimal, median, aux 90e et
+ *   99e centiles et maximal. Le minimum est le plus stable d'une execution a
+ *   l'autre, les centiles montrent le bruit (interruptions, frequence).
+ * Une barriere de compilation entoure chaque appel: le compilateur doit
+ * supposer que les donnees du noyau sont lues et modifiees a chaque fois, donc
+ * il ne peut ni retirer le calcul ni le sortir de la boucle de mesure. Un noyau
+ * doit donc ecrire son resultat dans ses donnees.
+ *
+ * Options (apres --banc):
+ *  --repetitions n : nombre d'echantillons (BANC_REPETITIONS par defaut)
+ *  --echauffement n : appels d'echauffement, au moins 1 (BANC_ECHAUFFEMENT)
+ *  --filtre texte : ne mesure que les noyaux dont le nom contient texte
+ *  --csv fichier : ajoute une ligne par noyau au fichier CSV, ce qui permet de
+ *   rassembler les resultats de plusieurs programmes dans un meme fichier
+ *  --json fichier : ecrit les resultats du programme dans un fichier JSON
+ *
+ * Exemple : ./TP4A --banc --repetitions 21 --csv bancs.csv
+ */
+#ifndef BANC_H
+#define BANC_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Nombre maximal de noyaux enregistres par un programme */
+#define BANC_MAX 64
+/* Nombre d'echantillons et d'appels d'echauffement par defaut */
+#define BANC_REPETITIONS 11
+#define BANC_ECHAUFFEMENT 3
+/* Duree minimale (en secondes) d'un echantillon */
+#define BANC_DUREE_ECHANTILLON 1e-3
+
+/* Barriere de compilation: la memoire pointee par adresse est consideree
+ * comme lue et modifiee a cet endroit (GCC et Clang) */
+#define BANC_BARRIERE(adresse) __asm__ volatile("" : : "r"(adresse) : "memory")
+
+/**
+ * Noyau de calcul enregistre.
+ */
+struct banc_noyau {
+    /* Nom affiche dans les resultats */
+    const char* nom;
+    /* Fonction mesuree et donnees qui lui sont passees (entrees et resultat)
+     */
+    void (*fonction)(void*);
+    void* donnees;
+};
+
+/**
+ * Resultat de la mesure d'un noyau, temps d'un appel en nanosecondes.
+ */
+struct banc_resultat {
+    /* Nombre d'appels regroupes dans un echantillon */
+    long appels;
+    double min, mediane, centile90, centile99, max;
+};
+
+/* Noyaux enregistres par le programme */
+static struct banc_noyau bancNoyaux[BANC_MAX];
+static int bancNombre;
+
+/**
+ * Cette fonction lit l'horloge monotone (qui ne recule jamais et qui ne depend
+ * pas du temps processeur, contrairement a clock()).
+ *
+ * return : Temps ecoule depuis une origine arbitraire, en nanosecondes
+ */
+static inline double banc_temps_ns(void) {
+    struct timespec temps;
+    clock_gettime(CLOCK_MONOTONIC, &temps);
+    return temps.tv_sec * 1e9 + temps.tv_nsec;
+}
+
+/**
+ * Cette fonction enregistre un noyau de calcul a mesurer.
+ *
+ * nom : Nom du noyau
+ * fonction : Fonction a mesurer, elle doit ecrire son resultat dans donnees
+ * donnees : Donnees passees a la fonction a chaque appel
+ */
+static inline void banc_enregistrer(const char nom[], void (*fonction)(void*),
+                                    void* donnees) {
+    if (bancNombre == BANC_MAX) {
+        fprintf(stderr, "Trop de noyaux, %s n'est pas enregistre\n", nom);
+        return;
+    }
+    bancNoyaux[bancNombre++] = (struct banc_noyau){nom, fonction, donnees};
+}
+
+/**
+ * Cette fonction appelle un noyau plusieurs fois de suite et mesure le tout.
+ *
+ * noyau : Noyau a appeler
+ * appels : Nombre d'appels
+ *
+ * return : Temps total en nanosecondes
+ */
+static inline double banc_chronometrer(const struct banc_noyau* noyau,
+                                       long appels) {
+    const double debut = banc_temps_ns();
+    for (long i = 0; i < appels; i++) {
+        BANC_BARRIERE(noyau->donnees);
+        noyau->fonction(noyau->donnees);
+        BANC_BARRIERE(noyau->donnees);
+    }
+    return banc_temps_ns() - debut;
+}
+
+/**
+ * Cette fonction compare deux doubles pour qsort.
+ */
+static inline int banc_comparer(const void* a, const void* b) {
+    const double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Cette fonction mesure un noyau.
+ *
+ * noyau : Noyau a mesurer
+ * repetitions : Nombre d'echantillons
+ * echauffement : Nombre d'appels d'echauffement, au moins 1
+ * echantillons : Tableau de repetitions cases ou on ecrit les echantillons
+ *
+ * return : Resultat de la mesure
+ */
+static inline struct banc_resultat banc_mesurer(
+    const struct banc_noyau* noyau, int repetitions, int echauffement,
+    double echantillons[]) {
+    struct banc_resultat resultat;
+    /* Temps d'un appel pendant l'echauffement, le dernier est le plus
+     * representatif */
+    double tempsAppel = 0;
+
+    for (int i = 0; i < echauffement; i++)
+        tempsAppel = banc_chronometrer(noyau, 1);
+
+    /* On regroupe assez d'appels pour atteindre la duree minimale */
+    resultat.appels = 1;
+    if (tempsAppel < BANC_DUREE_ECHANTILLON * 1e9)
+        resultat.appels =
+            (long)(BANC_DUREE_ECHANTILLON * 1e9 / (tempsAppel + 1)) + 1;
+
+    for (int i = 0; i < repetitions; i++)
+        echantillons[i] =
+            banc_chronometrer(noyau, resultat.appels) / resultat.appels;
+
+    /* Les centiles sont pris au rang le plus proche dans les echantillons
+     * tries */
+    qsort(echantillons, repetitions, sizeof echantillons[0], banc_comparer);
+    resultat.min = echantillons[0];
+    resultat.mediane = echantillons[(repetitions - 1) / 2];
+    resultat.centile90 = echantillons[(90 * repetitions + 99) / 100 - 1];
+    resultat.centile99 = echantillons[(99 * repetitions + 99) / 100 - 1];
+    resultat.max = echantillons[repetitions - 1];
+    return resultat;
+}
+
+/**
+ * Cette fonction mesure les noyaux enregistres si l'argument --banc est donne.
+ * Les resultats sont affiches, et ecrits en CSV et en JSON si demande.
+ *
+ * argc, argv : Arguments du programme
+ *
+ * return : 1 si le mode --banc est demande (le programme doit alors
+ * s'arreter), 0 sinon
+ */
+static inline int banc_lancer(int argc, char* argv[]) {
+    int repetitions = BANC_REPETITIONS, echauffement = BANC_ECHAUFFEMENT;
+    const char *filtre = "", *nomCsv = NULL, *nomJson = NULL;
+    int actif = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--banc"))
+            actif = 1;
+        else if (i + 1 < argc && !strcmp(argv[i], "--repetitions"))
+            repetitions = atoi(argv[++i]);
+        else if (i + 1 < argc && !strcmp(argv[i], "--echauffement"))
+            echauffement = atoi(argv[++i]);
+        else if (i + 1 < argc && !strcmp(argv[i], "--filtre"))
+            filtre = argv[++i];
+        else if (i + 1 < argc && !strcmp(argv[i], "--csv"))
+            nomCsv = argv[++i];
+        else if (i + 1 < argc && !strcmp(argv[i], "--json"))
+            nomJson = argv[++i];
+    }
+    if (!actif) return 0;
+
+    if (repetitions < 1 || echauffement < 1) {
+        fprintf(stderr, "Il faut au moins 1 repetition et 1 echauffement\n");
+        return 1;
+    }
+
+    /* Nom du programme sans son chemin */
+    const char* programme = strrchr(argv[0], '/');
+    programme = programme ? programme + 1 : argv[0];
+
+    double* echantillons = malloc(repetitions * sizeof(double));
+    FILE* csv = nomCsv ? fopen(nomCsv, "a") : NULL;
+    FILE* json = nomJson ? fopen(nomJson, "w") : NULL;
+    if (!echantillons || (nomCsv && !csv) || (nomJson && !json)) {
+        fprintf(stderr, "Impossible de preparer le banc d'essai\n");
+        free(echantillons);
+        if (csv) fclose(csv);
+        if (json) fclose(json);
+        return 1;
+    }
+
+    /* L'entete du CSV n'est ecrit que si le fichier est vide */
+    if (csv && !ftell(csv))
+        fprintf(csv, "programme,noyau,echantillons,appels,min_ns,mediane_ns,"
+                     "centile90_ns,centile99_ns,max_ns\n");
+    if (json)
+        fprintf(json, "{\n  \"programme\": \"%s\",\n  \"echantillons\": %d,\n"
+                      "  \"noyaux\": [",
+                programme, repetitions);
+
+    printf("Banc d'essai de %s: %d echantillons, %d appels d'echauffement\n",
+           programme, repetitions, echauffement);
+    printf("%-36s %9s %12s %12s %12s %12s %12s\n", "Noyau", "Appels",
+           "Min (ns)", "Mediane (ns)", "90e (ns)", "99e (ns)", "Max (ns)");
+
+    int premier = 1;
+    for (int i = 0; i < bancNombre; i++) {
+        const struct banc_noyau* noyau = &bancNoyaux[i];
+        if (!strstr(noyau->nom, filtre)) continue;
+
+        const struct banc_resultat r =
+            banc_mesurer(noyau, repetitions, echauffement, echantillons);
+        printf("%-36s %9ld %12.1f %12.1f %12.1f %12.1f %12.1f\n", noyau->nom,
+               r.appels, r.min, r.mediane, r.centile90, r.centile99, r.max);
+        /* On vide la sortie pour suivre les noyaux longs */
+        fflush(stdout);
+
+        if (csv)
+            fprintf(csv, "%s,\"%s\",%d,%ld,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+                    programme, noyau->nom, repetitions, r.appels, r.min,
+                    r.mediane, r.centile90, r.centile99, r.max);
+        if (json)
+            fprintf(json,
+                    "%s\n    {\"noyau\": \"%s\", \"appels\": %ld, "
+                    "\"min_ns\": %.1f, \"mediane_ns\": %.1f, "
+                    "\"centile90_ns\": %.1f, \"centile99_ns\": %.1f, "
+                    "\"max_ns\": %.1f}",
+                    premier ? "" : ",", noyau->nom, r.appels, r.min,
+                    r.mediane, r.centile90, r.centile99, r.max);
+        premier = 0;
+    }
+
+    if (json) {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+    }
+    if (csv) fclose(csv);
+    free(echantillons);
+    return 1;
+}
+
+#endif
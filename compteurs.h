@@ -0,0 +1,173 @@
+/**
+ * Auteur : Nicolas Levasseur
+ *
+ * Instrumentation commune aux programmes des TP. Les noyaux de calcul
+ * indiquent les operations qu'ils effectuent avec COMPTER, et l'appelant
+ * entoure la partie a mesurer de MESURE_DEBUTER et MESURE_TERMINER, qui
+ * affiche les compteurs a la fin. Toutes ces macros disparaissent a la
+ * compilation si elles ne sont pas activees, donc le meme source sert a la
+ * version chronometree et a la version instrumentee:
+ *  -DCOMPTER_OPERATIONS active les compteurs d'affectations, d'additions, de
+ *   multiplications et de comparaisons. Ils sont propres a chaque fil
+ *   d'execution (une mesure ne compte que les operations du fil qui la fait).
+ *  -DCOMPTEURS_MATERIELS active les compteurs du processeur (cycles,
+ *   instructions, branchements mal predits et defauts de cache) avec
+ *   perf_event_open, sous Linux. Ils comptent aussi seulement le fil courant,
+ *   en mode utilisateur. Si le noyau les refuse (voir
+ *   /proc/sys/kernel/perf_event_paranoid), ils sont affiches indisponibles.
+ *
+ * Exemple : gcc -DCOMPTER_OPERATIONS -DCOMPTEURS_MATERIELS TP4A.c -o TP4A
+ */
+#ifndef COMPTEURS_H
+#define COMPTEURS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef COMPTEURS_MATERIELS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* Types d'operations comptees */
+enum operation {
+    AFFECTATIONS,
+    ADDITIONS,
+    MULTIPLICATIONS,
+    COMPARAISONS,
+    N_OPERATIONS
+};
+
+/* Nombre de compteurs du processeur */
+#define N_EVENEMENTS 4
+
+#ifdef COMPTER_OPERATIONS
+/* Compteurs d'operations du fil d'execution courant */
+static _Thread_local int64_t compteursOperations[N_OPERATIONS];
+
+/* Ajoute n operations du type donne (n peut etre negatif pour corriger un
+ * compte fait d'avance) */
+#define COMPTER(type, n) (compteursOperations[type] += (n))
+#else
+#define COMPTER(type, n) ((void)0)
+#endif
+
+#if defined(COMPTER_OPERATIONS) || defined(COMPTEURS_MATERIELS)
+/**
+ * Mesure en cours: valeurs des compteurs d'operations au debut (les mesures
+ * peuvent donc s'imbriquer) et descripteurs des compteurs du processeur.
+ */
+struct mesure {
+    int64_t depart[N_OPERATIONS];
+    int descripteurs[N_EVENEMENTS];
+};
+
+/**
+ * Cette fonction commence une mesure.
+ *
+ * mesure : Mesure a commencer
+ */
+static inline void mesure_debuter(struct mesure* mesure) {
+    for (int i = 0; i < N_OPERATIONS; i++) {
+#ifdef COMPTER_OPERATIONS
+        mesure->depart[i] = compteursOperations[i];
+#else
+        mesure->depart[i] = 0;
+#endif
+    }
+
+    for (int i = 0; i < N_EVENEMENTS; i++) {
+        mesure->descripteurs[i] = -1;
+#ifdef COMPTEURS_MATERIELS
+        const uint64_t evenements[N_EVENEMENTS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES};
+        struct perf_event_attr attributs = {0};
+        attributs.type = PERF_TYPE_HARDWARE;
+        attributs.size = sizeof attributs;
+        attributs.config = evenements[i];
+        attributs.disabled = 1;
+        attributs.exclude_kernel = 1;
+        attributs.exclude_hv = 1;
+        /* Fil courant (0), sur n'importe quel processeur (-1) */
+        mesure->descripteurs[i] =
+            (int)syscall(SYS_perf_event_open, &attributs, 0, -1, -1, 0);
+#endif
+    }
+
+    /* Les compteurs sont demarres en dernier pour ne pas compter leur
+     * ouverture */
+    for (int i = 0; i < N_EVENEMENTS; i++) {
+#ifdef COMPTEURS_MATERIELS
+        if (mesure->descripteurs[i] < 0) continue;
+        ioctl(mesure->descripteurs[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(mesure->descripteurs[i], PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+}
+
+/**
+ * Cette fonction termine une mesure et affiche les compteurs actives.
+ *
+ * mesure : Mesure a terminer
+ * nom : Nom de la partie mesuree
+ */
+static inline void mesure_terminer(struct mesure* mesure, const char nom[]) {
+    const char* const nomsOperations[N_OPERATIONS] = {
+        "Nombre d'affectations    ", "Nombre d'additions       ",
+        "Nombre de multiplications", "Nombre de comparaisons   "};
+    const char* const nomsEvenements[N_EVENEMENTS] = {
+        "Nombre de cycles         ", "Nombre d'instructions    ",
+        "Branchements mal predits ", "Defauts de cache         "};
+    /* Valeurs des compteurs du processeur, -1 s'ils sont indisponibles */
+    int64_t valeurs[N_EVENEMENTS];
+
+    for (int i = 0; i < N_EVENEMENTS; i++) {
+        valeurs[i] = -1;
+#ifdef COMPTEURS_MATERIELS
+        if (mesure->descripteurs[i] < 0) continue;
+        ioctl(mesure->descripteurs[i], PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t valeur;
+        if (read(mesure->descripteurs[i], &valeur, sizeof valeur) ==
+            sizeof valeur)
+            valeurs[i] = (int64_t)valeur;
+        close(mesure->descripteurs[i]);
+#endif
+    }
+
+    printf("Mesures (%s)\n", nom);
+#ifdef COMPTER_OPERATIONS
+    for (int i = 0; i < N_OPERATIONS; i++)
+        printf("%s: %lld\n", nomsOperations[i],
+               (long long)(compteursOperations[i] - mesure->depart[i]));
+#else
+    (void)nomsOperations;
+#endif
+#ifdef COMPTEURS_MATERIELS
+    for (int i = 0; i < N_EVENEMENTS; i++) {
+        if (valeurs[i] < 0)
+            printf("%s: indisponible\n", nomsEvenements[i]);
+        else
+            printf("%s: %lld\n", nomsEvenements[i], (long long)valeurs[i]);
+    }
+#else
+    (void)nomsEvenements;
+    (void)valeurs;
+#endif
+}
+
+/* Commence une mesure dans la variable donnee (la declare, donc a utiliser
+ * dans un bloc) */
+#define MESURE_DEBUTER(variable) \
+    struct mesure variable;      \
+    mesure_debuter(&variable)
+/* Termine la mesure et affiche ses compteurs */
+#define MESURE_TERMINER(variable, nom) mesure_terminer(&variable, nom)
+#else
+#define MESURE_DEBUTER(variable) ((void)0)
+#define MESURE_TERMINER(variable, nom) ((void)0)
+#endif
+
+#endif